@@ -0,0 +1,170 @@
+#ifndef Predicates_hpp
+#define Predicates_hpp
+
+#include "CountIf.hpp"
+#include <x86intrin.h>
+#include <cstdint>
+#include <type_traits>
+
+namespace paralgos {
+
+  /**
+   * @class MaskEquals Predicates.hpp
+   *
+   * Prédicat unaire vectorisé satisfait par les entiers 32 bits @c e tels que
+   * @c (e & mask) == value. Le prédicat estPair s'écrit ainsi
+   * @c MaskEquals< uint >(1, 0).
+   */
+  template< typename T >
+  class MaskEquals {
+  public:
+
+    static_assert(std::is_integral< T >::value && sizeof(T) == 4,
+		  "entiers 32 bits attendus");
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] mask - le masque appliqué aux éléments.
+     * @param[in] value - la valeur attendue après masquage.
+     */
+    MaskEquals(const T& mask, const T& value)
+      : mask_(mask), value_(value) {
+    }
+
+    /**
+     * Évaluation scalaire.
+     *
+     * @param[in] e - un élément.
+     * @return @c true si @c (e & mask) == value sinon @c false.
+     */
+    bool operator()(const T& e) const {
+      return (e & mask_) == value_;
+    }
+
+    /**
+     * Évaluation sur quatre éléments.
+     *
+     * @param[in] v - quatre éléments compactés.
+     * @return le masque des éléments satisfaisant le prédicat.
+     */
+    __m128i sse(const __m128i& v) const {
+      const __m128i mask = _mm_set1_epi32((int32_t) mask_);
+      const __m128i value = _mm_set1_epi32((int32_t) value_);
+      return _mm_cmpeq_epi32(_mm_and_si128(v, mask), value);
+    }
+
+#ifdef __AVX2__
+    /**
+     * Évaluation sur huit éléments.
+     *
+     * @param[in] v - huit éléments compactés.
+     * @return le masque des éléments satisfaisant le prédicat.
+     */
+    __m256i avx2(const __m256i& v) const {
+      const __m256i mask = _mm256_set1_epi32((int32_t) mask_);
+      const __m256i value = _mm256_set1_epi32((int32_t) value_);
+      return _mm256_cmpeq_epi32(_mm256_and_si256(v, mask), value);
+    }
+#endif
+
+  private:
+
+    T mask_;  // Le masque appliqué aux éléments.
+    T value_; // La valeur attendue après masquage.
+
+  }; // MaskEquals
+
+  /**
+   * @class InRange Predicates.hpp
+   *
+   * Prédicat unaire vectorisé satisfait par les entiers 32 bits @c e tels que
+   * @c lo <= e < hi. Les instructions SSE ne comparant que des entiers
+   * signés, le bit de poids fort des entiers non signés est inversé avant
+   * comparaison, ce qui préserve leur ordre.
+   */
+  template< typename T >
+  class InRange {
+  public:
+
+    static_assert(std::is_integral< T >::value && sizeof(T) == 4,
+		  "entiers 32 bits attendus");
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] lo - la borne inférieure (incluse).
+     * @param[in] hi - la borne supérieure (exclue).
+     */
+    InRange(const T& lo, const T& hi)
+      : lo_(lo), hi_(hi) {
+    }
+
+    /**
+     * Évaluation scalaire.
+     *
+     * @param[in] e - un élément.
+     * @return @c true si @c lo <= e < hi sinon @c false.
+     */
+    bool operator()(const T& e) const {
+      return lo_ <= e && e < hi_;
+    }
+
+    /**
+     * Évaluation sur quatre éléments.
+     *
+     * @param[in] v - quatre éléments compactés.
+     * @return le masque des éléments satisfaisant le prédicat.
+     */
+    __m128i sse(const __m128i& v) const {
+      const __m128i bias = _mm_set1_epi32(std::is_signed< T >::value
+					  ? 0 : INT32_MIN);
+      const __m128i lo = _mm_xor_si128(_mm_set1_epi32((int32_t) lo_), bias);
+      const __m128i hi = _mm_xor_si128(_mm_set1_epi32((int32_t) hi_), bias);
+      const __m128i e = _mm_xor_si128(v, bias);
+      // !(lo > e) && hi > e.
+      return _mm_andnot_si128(_mm_cmpgt_epi32(lo, e), _mm_cmpgt_epi32(hi, e));
+    }
+
+#ifdef __AVX2__
+    /**
+     * Évaluation sur huit éléments.
+     *
+     * @param[in] v - huit éléments compactés.
+     * @return le masque des éléments satisfaisant le prédicat.
+     */
+    __m256i avx2(const __m256i& v) const {
+      const __m256i bias = _mm256_set1_epi32(std::is_signed< T >::value
+					     ? 0 : INT32_MIN);
+      const __m256i lo = _mm256_xor_si256(_mm256_set1_epi32((int32_t) lo_),
+					  bias);
+      const __m256i hi = _mm256_xor_si256(_mm256_set1_epi32((int32_t) hi_),
+					  bias);
+      const __m256i e = _mm256_xor_si256(v, bias);
+      return _mm256_andnot_si256(_mm256_cmpgt_epi32(lo, e),
+				 _mm256_cmpgt_epi32(hi, e));
+    }
+#endif
+
+  private:
+
+    T lo_; // La borne inférieure (incluse).
+    T hi_; // La borne supérieure (exclue).
+
+  }; // InRange
+
+  /**
+   * Les prédicats ci-dessus disposent d'une version vectorisée pour leur
+   * propre type d'éléments.
+   */
+  template< typename T >
+  struct SimdPredicate< MaskEquals< T >, T > : std::true_type {
+  };
+
+  template< typename T >
+  struct SimdPredicate< InRange< T >, T > : std::true_type {
+  };
+
+} // paralgos
+
+#endif
@@ -0,0 +1,483 @@
+#ifndef SegmentedList_hpp
+#define SegmentedList_hpp
+
+#include <x86intrin.h>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace paralgos {
+
+  /**
+   * @class SegmentedList SegmentedList.hpp
+   *
+   * Liste déroulée : une liste doublement chaînée de segments, chacun
+   * stockant de façon contiguë jusqu'à @c capacity éléments dans un tableau
+   * aligné de @c Bytes octets (un multiple de la taille d'une ligne de
+   * cache). Le parcours d'un segment ne provoque ainsi qu'un défaut de cache
+   * par ligne, au lieu d'un par élément pour std::list.
+   *
+   * Un segment plein est scindé en deux, un segment vidé est libéré. Un
+   * répertoire ordonné des segments permet d'accéder directement au k-ième
+   * d'entre eux : les algorithmes parallèles répartissent les segments entre
+   * les threads sans aucun cheminement (voir @c segments, @c segmentBegin et
+   * @c segmentEnd).
+   *
+   * Une insertion ou une suppression coûte le décalage d'au plus
+   * @c capacity éléments d'un segment. Celles qui scindent ou libèrent un
+   * segment mettent en outre à jour le répertoire, en O(segments) : recherche
+   * du rang du segment puis décalage d'un tableau de pointeurs. Ce surcoût
+   * n'intervient qu'une fois toutes les @c capacity / 2 opérations au moins
+   * pour des insertions ; push_back l'évite (ajout en fin de répertoire).
+   *
+   * @note Contrairement à std::list, une insertion ou une suppression
+   *   invalide les itérateurs repérant des éléments du segment modifié (ou
+   *   scindé) ; ceux des autres segments restent valides.
+   */
+  template< typename T, size_t Bytes = 512 >
+  class SegmentedList {
+  public:
+
+    // Nombre maximal d'éléments par segment.
+    static const unsigned capacity = Bytes / sizeof(T) ? Bytes / sizeof(T) : 1;
+
+  private:
+
+    // Maillon du chaînage, également utilisé comme sentinelle.
+    struct Link {
+      Link* prev;
+      Link* next;
+    };
+
+    // Segment : maillon, nombre d'éléments et tableau aligné.
+    struct Segment : Link {
+      unsigned count;
+      alignas(64) typename std::aligned_storage< sizeof(T), alignof(T) >::type
+	data[capacity];
+
+      T* at(const unsigned& i) {
+	return reinterpret_cast< T* >(data + i);
+      }
+    };
+
+    static_assert(Bytes % 64 == 0,
+		  "la taille d'un segment doit être un multiple de 64 octets");
+
+  public:
+
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+    /**
+     * Itérateur bidirectionnel : un segment et une position dans celui-ci.
+     * L'itérateur de fin repère la position 0 de la sentinelle.
+     */
+    template< bool Const >
+    class Iterator {
+    public:
+
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef typename std::conditional< Const, const T*, T* >::type pointer;
+      typedef typename std::conditional< Const, const T&, T& >::type reference;
+
+      Iterator() : node_(nullptr), index_(0) {
+      }
+
+      Iterator(Link* node, const unsigned& index)
+	: node_(node), index_(index) {
+      }
+
+      // Conversion d'un itérateur en itérateur constant.
+      template< bool Other,
+		typename = typename std::enable_if< Const && !Other >::type >
+      Iterator(const Iterator< Other >& other)
+	: node_(other.node_), index_(other.index_) {
+      }
+
+      reference operator*() const {
+	return *static_cast< Segment* >(node_)->at(index_);
+      }
+
+      pointer operator->() const {
+	return static_cast< Segment* >(node_)->at(index_);
+      }
+
+      Iterator& operator++() {
+	if (++ index_ == static_cast< Segment* >(node_)->count) {
+	  node_ = node_->next;
+	  index_ = 0;
+	}
+	return *this;
+      }
+
+      Iterator operator++(int) {
+	Iterator old = *this;
+	++ *this;
+	return old;
+      }
+
+      Iterator& operator--() {
+	if (index_ == 0) {
+	  node_ = node_->prev;
+	  index_ = static_cast< Segment* >(node_)->count;
+	}
+	-- index_;
+	return *this;
+      }
+
+      Iterator operator--(int) {
+	Iterator old = *this;
+	-- *this;
+	return old;
+      }
+
+      bool operator==(const Iterator& other) const {
+	return node_ == other.node_ && index_ == other.index_;
+      }
+
+      bool operator!=(const Iterator& other) const {
+	return !(*this == other);
+      }
+
+    private:
+
+      friend class SegmentedList;
+      friend class Iterator< !Const >;
+
+      Link* node_;     // Le segment (ou la sentinelle).
+      unsigned index_; // La position dans le segment.
+
+    }; // Iterator
+
+    typedef Iterator< false > iterator;
+    typedef Iterator< true > const_iterator;
+
+    /**
+     * Construction d'une liste vide.
+     */
+    SegmentedList() : size_(0) {
+      end_.prev = end_.next = &end_;
+    }
+
+    /**
+     * Construction par recopie.
+     *
+     * @param[in] other - la liste à recopier.
+     */
+    SegmentedList(const SegmentedList& other) : size_(0) {
+      end_.prev = end_.next = &end_;
+      for (const T& e : other) {
+	push_back(e);
+      }
+    }
+
+    /**
+     * Affectation.
+     *
+     * @param[in] other - la liste à recopier.
+     * @return cette liste.
+     */
+    SegmentedList& operator=(const SegmentedList& other) {
+      if (this != &other) {
+	clear();
+	for (const T& e : other) {
+	  push_back(e);
+	}
+      }
+      return *this;
+    }
+
+    /**
+     * Destruction de la liste et de ses éléments.
+     */
+    ~SegmentedList() {
+      clear();
+    }
+
+    iterator begin() {
+      return iterator(end_.next, 0);
+    }
+
+    const_iterator begin() const {
+      return const_iterator(end_.next, 0);
+    }
+
+    const_iterator cbegin() const {
+      return begin();
+    }
+
+    iterator end() {
+      return iterator(&end_, 0);
+    }
+
+    const_iterator end() const {
+      return const_iterator(const_cast< Link* >(&end_), 0);
+    }
+
+    const_iterator cend() const {
+      return end();
+    }
+
+    /**
+     * @return le nombre d'éléments de la liste.
+     */
+    size_type size() const {
+      return size_;
+    }
+
+    /**
+     * @return @c true si la liste est vide sinon @c false.
+     */
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    reference front() {
+      return *begin();
+    }
+
+    const_reference front() const {
+      return *begin();
+    }
+
+    reference back() {
+      return *(-- end());
+    }
+
+    const_reference back() const {
+      return *(-- end());
+    }
+
+    /**
+     * @return le nombre de segments de la liste.
+     */
+    size_type segments() const {
+      return directory_.size();
+    }
+
+    /**
+     * @param[in] s - un numéro de segment.
+     * @return un pointeur sur le premier élément du segment @c s.
+     */
+    const T* segmentBegin(const size_type& s) const {
+      return directory_[s]->at(0);
+    }
+
+    /**
+     * @param[in] s - un numéro de segment.
+     * @return un pointeur sur l'élément situé juste derrière le dernier
+     *   élément du segment @c s.
+     */
+    const T* segmentEnd(const size_type& s) const {
+      return directory_[s]->at(directory_[s]->count);
+    }
+
+    /**
+     * Ajout d'un élément en fin de liste.
+     *
+     * @param[in] value - l'élément.
+     */
+    void push_back(const T& value) {
+      Segment* last = end_.prev == &end_
+	? nullptr : static_cast< Segment* >(end_.prev);
+      if (last == nullptr || last->count == capacity) {
+	last = create(end_.prev, directory_.size());
+      }
+      new (last->at(last->count)) T(value);
+      last->count ++;
+      size_ ++;
+    }
+
+    /**
+     * Ajout d'un élément en début de liste.
+     *
+     * @param[in] value - l'élément.
+     */
+    void push_front(const T& value) {
+      insert(begin(), value);
+    }
+
+    /**
+     * Suppression du dernier élément de la liste.
+     */
+    void pop_back() {
+      erase(-- end());
+    }
+
+    /**
+     * Suppression du premier élément de la liste.
+     */
+    void pop_front() {
+      erase(begin());
+    }
+
+    /**
+     * Insertion d'un élément.
+     *
+     * @param[in] pos - l'itérateur repérant l'élément devant lequel insérer.
+     * @param[in] value - l'élément.
+     * @return l'itérateur repérant l'élément inséré.
+     */
+    iterator insert(const_iterator pos, const T& value) {
+
+      if (pos.node_ == &end_) {
+	push_back(value);
+	return -- end();
+      }
+
+      Segment* seg = static_cast< Segment* >(pos.node_);
+      unsigned i = pos.index_;
+
+      // En tête d'un segment, l'élément est de préférence ajouté en fin du
+      // segment précédent s'il reste de la place.
+      if (i == 0 && seg->prev != &end_
+	  && static_cast< Segment* >(seg->prev)->count < capacity) {
+	seg = static_cast< Segment* >(seg->prev);
+	i = seg->count;
+      } else if (seg->count == capacity) {
+	// Segment plein : sa seconde moitié est déplacée dans un nouveau
+	// segment.
+	const unsigned half = capacity / 2;
+	Segment* next = create(seg, rank(seg) + 1);
+	for (unsigned k = half; k != capacity; k ++) {
+	  new (next->at(k - half)) T(std::move(*seg->at(k)));
+	  seg->at(k)->~T();
+	}
+	next->count = capacity - half;
+	seg->count = half;
+	if (i > half) {
+	  seg = next;
+	  i -= half;
+	}
+      }
+
+      // Décalage de la fin du segment.
+      if (i == seg->count) {
+	new (seg->at(i)) T(value);
+      } else {
+	new (seg->at(seg->count)) T(std::move(*seg->at(seg->count - 1)));
+	std::move_backward(seg->at(i), seg->at(seg->count - 1),
+			   seg->at(seg->count));
+	*seg->at(i) = value;
+      }
+      seg->count ++;
+      size_ ++;
+
+      return iterator(seg, i);
+
+    } // insert
+
+    /**
+     * Suppression d'un élément.
+     *
+     * @param[in] pos - l'itérateur repérant l'élément à supprimer.
+     * @return l'itérateur repérant l'élément qui le suivait.
+     */
+    iterator erase(const_iterator pos) {
+
+      Segment* seg = static_cast< Segment* >(pos.node_);
+      const unsigned i = pos.index_;
+
+      std::move(seg->at(i + 1), seg->at(seg->count), seg->at(i));
+      seg->at(seg->count - 1)->~T();
+      seg->count --;
+      size_ --;
+
+      if (seg->count == 0) {
+	Link* next = seg->next;
+	destroy(seg);
+	return iterator(next, 0);
+      }
+      if (i == seg->count) {
+	return iterator(seg->next, 0);
+      }
+      return iterator(seg, i);
+
+    } // erase
+
+    /**
+     * Suppression de tous les éléments.
+     */
+    void clear() {
+      for (Segment* seg : directory_) {
+	for (unsigned k = 0; k != seg->count; k ++) {
+	  seg->at(k)->~T();
+	}
+	seg->~Segment();
+	_mm_free(seg);
+      }
+      directory_.clear();
+      end_.prev = end_.next = &end_;
+      size_ = 0;
+    }
+
+  private:
+
+    /**
+     * Création d'un segment vide.
+     *
+     * @param[in] after - le maillon derrière lequel chaîner le segment.
+     * @param[in] s - le rang du segment dans le répertoire.
+     * @return le segment.
+     */
+    Segment* create(Link* after, const size_type& s) {
+      void* memory = _mm_malloc(sizeof(Segment), alignof(Segment));
+      if (memory == nullptr) {
+	throw std::bad_alloc();
+      }
+      Segment* seg = new (memory) Segment;
+      seg->count = 0;
+      seg->prev = after;
+      seg->next = after->next;
+      after->next->prev = seg;
+      after->next = seg;
+      directory_.insert(directory_.begin() + s, seg);
+      return seg;
+    }
+
+    /**
+     * Destruction d'un segment vide.
+     *
+     * @param[in] seg - le segment.
+     */
+    void destroy(Segment* seg) {
+      seg->prev->next = seg->next;
+      seg->next->prev = seg->prev;
+      directory_.erase(directory_.begin() + rank(seg));
+      seg->~Segment();
+      _mm_free(seg);
+    }
+
+    /**
+     * Rang d'un segment dans le répertoire (recherche linéaire dans un
+     * tableau contigu de pointeurs, sans accès aux segments eux-mêmes).
+     *
+     * @param[in] seg - le segment.
+     * @return son rang.
+     */
+    size_type rank(const Segment* seg) const {
+      return std::find(directory_.begin(), directory_.end(), seg)
+	- directory_.begin();
+    }
+
+    Link end_;                          // La sentinelle.
+    std::vector< Segment* > directory_; // Les segments, dans l'ordre.
+    size_type size_;                    // Le nombre d'éléments.
+
+  }; // SegmentedList
+
+  template< typename T, size_t Bytes >
+  const unsigned SegmentedList< T, Bytes >::capacity;
+
+} // paralgos
+
+#endif
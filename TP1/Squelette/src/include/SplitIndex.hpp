@@ -0,0 +1,163 @@
+#ifndef SplitIndex_hpp
+#define SplitIndex_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace paralgos {
+
+  /**
+   * @class SplitIndex SplitIndex.hpp
+   *
+   * Index de points de découpage d'un conteneur dont les itérateurs ne sont
+   * pas à accès direct (std::list, std::set, ...) : un parcours unique du
+   * conteneur mémorise un itérateur tous les @c step éléments, ce qui le
+   * découpe en segments contigus. Un algorithme parallèle peut alors confier
+   * à chaque thread un ou plusieurs segments sans aucun parcours séquentiel
+   * préalable.
+   *
+   * Les itérateurs mémorisés ne sont plus fiables dès que le conteneur est
+   * modifié, et l'index ne peut le détecter : toute modification du
+   * conteneur doit être suivie d'un appel à @c rebuild (ou à @c invalidate,
+   * si la reconstruction est différée) avant toute utilisation de l'index.
+   * La comparaison des tailles effectuée par @c valid n'est qu'un garde-fou :
+   * une suppression suivie d'une insertion, par exemple, lui échappe.
+   *
+   * @note Le conteneur doit fournir une méthode size() en temps constant, ce
+   *   qui est le cas de tous les conteneurs standards sauf std::forward_list.
+   */
+  template< typename Container >
+  class SplitIndex {
+  public:
+
+    // Type des itérateurs mémorisés.
+    typedef typename Container::const_iterator Iterator;
+
+    // Type des distances entre itérateurs.
+    typedef typename std::iterator_traits< Iterator >::difference_type
+      difference_type;
+
+    /**
+     * Construction de l'index (un parcours complet du conteneur).
+     *
+     * @param[in] container - le conteneur, qui doit survivre à l'index.
+     * @param[in] step - le nombre d'éléments par segment.
+     */
+    explicit SplitIndex(const Container& container, const size_t& step = 1024)
+      : container_(container), step_(step ? step : 1), size_(0),
+	valid_(false) {
+      rebuild();
+    }
+
+    /**
+     * Reconstruction de l'index après modification du conteneur.
+     */
+    void rebuild() {
+
+      points_.clear();
+      Iterator it = container_.begin();
+      const Iterator last = container_.end();
+      size_t n = 0;
+      while (it != last) {
+	if (n % step_ == 0) {
+	  points_.push_back(it);
+	}
+	++ it;
+	++ n;
+      }
+      points_.push_back(last);
+      size_ = n;
+      valid_ = true;
+
+    } // rebuild
+
+    /**
+     * Signale une modification du conteneur, l'index n'étant reconstruit
+     * qu'au prochain appel à @c rebuild.
+     */
+    void invalidate() {
+      valid_ = false;
+    }
+
+    /**
+     * Indique si l'index peut être utilisé, sous réserve que toute
+     * modification du conteneur ait été signalée (voir ci-dessus).
+     *
+     * @return @c false si @c invalidate a été appelée ou si la taille du
+     *   conteneur a changé depuis la dernière construction, sinon @c true.
+     */
+    bool valid() const {
+      return valid_ && container_.size() == size_;
+    }
+
+    /**
+     * @return le conteneur indexé.
+     */
+    const Container& container() const {
+      return container_;
+    }
+
+    /**
+     * @return le nombre d'éléments du conteneur lors de la construction.
+     */
+    size_t size() const {
+      return size_;
+    }
+
+    /**
+     * @return le nombre de segments (le dernier pouvant être incomplet).
+     */
+    size_t segments() const {
+      return points_.size() - 1;
+    }
+
+    /**
+     * @param[in] s - un numéro de segment.
+     * @return l'itérateur repérant le premier élément du segment @c s.
+     */
+    Iterator begin(const size_t& s) const {
+      return points_[s];
+    }
+
+    /**
+     * @param[in] s - un numéro de segment.
+     * @return l'itérateur repérant l'élément situé juste derrière le dernier
+     *   élément du segment @c s.
+     */
+    Iterator end(const size_t& s) const {
+      return points_[s + 1];
+    }
+
+    /**
+     * Frontière entre parts lors d'un découpage du conteneur en @c parts
+     * parts contiguës d'au plus un segment d'écart : la part @c t
+     * correspond à l'intervalle @c [at(t, parts), at(t + 1, parts)[.
+     *
+     * @param[in] t - un numéro de frontière, compris entre 0 et @c parts.
+     * @param[in] parts - le nombre de parts.
+     * @return l'itérateur repérant le premier élément de la part @c t, ou
+     *   la fin du conteneur si @c parts est nul.
+     */
+    Iterator at(const size_t& t, const size_t& parts) const {
+      if (parts == 0) {
+	return points_.back();
+      }
+      return points_[std::min(t, parts) * segments() / parts];
+    }
+
+  private:
+
+    const Container& container_;     // Le conteneur indexé.
+    const size_t step_;              // Le nombre d'éléments par segment.
+    std::vector< Iterator > points_; // Les débuts de segments, suivis de la
+                                     // fin du conteneur.
+    size_t size_;                    // La taille du conteneur indexé.
+    bool valid_;                     // Faux après invalidate.
+
+  }; // SplitIndex
+
+} // paralgos
+
+#endif
@@ -1,5 +1,8 @@
 #include "CountIf.hpp"
 #include "Metrics.hpp"
+#include "Predicates.hpp"
+#include "SegmentedList.hpp"
+#include "SplitIndex.hpp"
 #include <omp.h>
 #include <algorithm>
 #include <array>
@@ -49,6 +52,40 @@ pgcd21Vaut3(const uint& num) {
   return a == esperee;
 }
 
+/**
+ * Affichage des résultats d'un benchmark.
+ *
+ * @param[in] seq - la durée d'exécution de la version séquentielle.
+ * @param[in] par - la durée d'exécution de la version parallèle.
+ * @param[in] verdict - @c true si les deux versions donnent le même résultat.
+ * @param[in] threads - le nombre de threads utilisés.
+ * @param[in] titre - le titre du benckmark.
+ */
+void
+afficher(const double& seq,
+	 const double& par,
+	 const bool& verdict,
+	 const int& threads,
+	 const std::string& titre) {
+
+  // Affichage des résultats.
+  std::cout << "--[ " << titre << ": begin ] --" << std::endl;
+  std::cout << "\tDurée seq. :\t\t" << seq << " sec." << std::endl;
+  std::cout << "\tDurée par. :\t\t" << par << " sec." << std::endl;
+  std::cout << "\tVerdict:\t"
+	    << std::boolalpha
+	    << verdict
+	    << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "\tEfficiency:\t"
+	    << Metrics::efficiency(seq, par, threads)
+	    << std::endl;
+  std::cout << "--[ " << titre << ": end ] --" << std::endl;
+  std::cout << std::endl;
+
+}
+
 /**
  * Routine d'évaluation des performances.
  *
@@ -101,21 +138,65 @@ tester(const InputIterator& first,
     par = stop - start;
   }
 
-  // Affichage des résultats.
-  std::cout << "--[ " << titre << ": begin ] --" << std::endl;
-  std::cout << "\tDurée seq. :\t\t" << seq << " sec." << std::endl;
-  std::cout << "\tDurée par. :\t\t" << par << " sec." << std::endl;
-  std::cout << "\tVerdict:\t"
-	    << std::boolalpha
-	    << (seqCountIf == parCountIf)
-	    << std::endl;
-  std::cout << "\tThread(s):\t" << threads << std::endl;
-  std::cout << "\tSpeedup:\t" << Metrics::speedup(seq, par) << std::endl;
-  std::cout << "\tEfficiency:\t"
-	    << Metrics::efficiency(seq, par, threads)
-	    << std::endl;
-  std::cout << "--[ " << titre << ": end ] --" << std::endl;
-  std::cout << std::endl;
+  afficher(seq, par, seqCountIf == parCountIf, threads, titre);
+
+}
+
+/**
+ * Routine d'évaluation des performances des formes de l'algorithme
+ * s'appuyant sur une structure dédiée (index de découpage, liste
+ * segmentée). La durée de construction de cette structure n'est pas
+ * comptabilisée, celle-ci étant destinée à être réutilisée.
+ *
+ * @param[in] conteneur - le conteneur parcouru par la version séquentielle.
+ * @param[in] source - le premier paramètre de l'algorithme.
+ * @param[in] pred - le paramètre @c pred de l'algorithme.
+ * @param[in] threads - le nombre de threads utilisés.
+ * @param[in] titre - le titre du benckmark.
+ */
+template< typename Container, typename Source, typename UnaryPredicate >
+void
+testerSource(const Container& conteneur,
+	     const Source& source,
+	     const UnaryPredicate& pred,
+	     const int& threads,
+	     const std::string& titre) {
+
+  using namespace paralgos;
+
+  // Type synonyme pour le résultat de l'algorithme count_if.
+  typedef typename Container::difference_type Result;
+
+  // Nombre d'itérations à effectuer sur le même algorithme pour obtenir des
+  // mesures de temps conséquentes.
+  const int combien = 64;
+
+  // Durée d'exécution de la version séquentielle (bibliothèque standard) et
+  // son résultat.
+  double seq;
+  Result seqCountIf;
+  {
+    const double start = omp_get_wtime();
+    for (int i = 0; i < combien; i ++) {
+      seqCountIf = std::count_if(conteneur.begin(), conteneur.end(), pred);
+    }
+    const double stop = omp_get_wtime();
+    seq = stop - start;
+  }
+
+  // Durée d'exécution de la version parallèle et son résultat.
+  double par;
+  Result parCountIf;
+  {
+    const double start = omp_get_wtime();
+    for (int i = 0; i < combien; i ++) {
+      parCountIf = CountIf::apply(source, pred);
+    }
+    const double stop = omp_get_wtime();
+    par = stop - start;
+  }
+
+  afficher(seq, par, seqCountIf == parCountIf, threads, titre);
 
 }
 
@@ -141,9 +222,11 @@ main() {
   // d'exécution.
   std::list< uint > liste;
   std::array< uint, n > tableau;
+  paralgos::SegmentedList< uint > segments;
   for (uint i = 0; i < n; i ++) {
       liste.push_back(i);
       tableau[i] = i;
+      segments.push_back(i);
   }
 
   // Premier test : une liste d'entiers + le prédicat pgcd21Vaut3.
@@ -186,6 +269,63 @@ main() {
     	   titre);
   }
 
+  // Cinquième test : un tableau d'entiers + le prédicat estPair vectorisé.
+  {
+    const std::string titre = "array + estPair (SIMD)";   
+    tester(tableau.begin(),
+    	   tableau.end(), 
+    	   paralgos::MaskEquals< uint >(1, 0),
+    	   threads,
+    	   titre);
+  }
+
+  // Sixième test : un tableau d'entiers + un intervalle vectorisé.
+  {
+    const std::string titre = "array + InRange (SIMD)";   
+    tester(tableau.begin(),
+    	   tableau.end(), 
+    	   paralgos::InRange< uint >(n / 3, 2 * n / 3),
+    	   threads,
+    	   titre);
+  }
+
+  // Index de découpage de la liste, construit une fois pour toutes.
+  const paralgos::SplitIndex< std::list< uint > > index(liste);
+
+  // Septième test : une liste indexée + le prédicat pgcd21Vaut3.
+  {
+    const std::string titre = "list (index) + pgcd21Vaut3";   
+    testerSource(liste, index, pgcd21Vaut3, threads, titre);
+  }
+
+  // Huitième test : une liste indexée + le prédicat estPair.
+  {
+    const std::string titre = "list (index) + estPair";   
+    testerSource(liste, index, estPair, threads, titre);
+  }
+
+  // Neuvième test : une liste segmentée + le prédicat pgcd21Vaut3.
+  {
+    const std::string titre = "segmented list + pgcd21Vaut3";   
+    testerSource(segments, segments, pgcd21Vaut3, threads, titre);
+  }
+
+  // Dixième test : une liste segmentée + le prédicat estPair.
+  {
+    const std::string titre = "segmented list + estPair";   
+    testerSource(segments, segments, estPair, threads, titre);
+  }
+
+  // Onzième test : une liste segmentée + le prédicat estPair vectorisé.
+  {
+    const std::string titre = "segmented list + estPair (SIMD)";   
+    testerSource(segments,
+		 segments,
+		 paralgos::MaskEquals< uint >(1, 0),
+		 threads,
+		 titre);
+  }
+
   // Tout s'est bien passé.
   return EXIT_SUCCESS;
 
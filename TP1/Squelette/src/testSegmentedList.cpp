@@ -0,0 +1,253 @@
+#include "CountIf.hpp"
+#include "SegmentedList.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <cstdlib>
+
+/**
+ * Élément non trivial : une chaîne de caractères allouée sur le tas, dont
+ * les instances vivantes sont dénombrées afin de détecter toute construction
+ * ou destruction manquante (ou en double) au sein des segments.
+ */
+class Element {
+public:
+
+  static long vivants; // Le nombre d'instances vivantes.
+
+  explicit Element(const unsigned& v = 0)
+    : texte_(std::to_string(v) + std::string(v % 40, '*')) {
+    vivants ++;
+  }
+
+  Element(const Element& other) : texte_(other.texte_) {
+    vivants ++;
+  }
+
+  Element(Element&& other) : texte_(std::move(other.texte_)) {
+    vivants ++;
+  }
+
+  Element& operator=(const Element& other) {
+    texte_ = other.texte_;
+    return *this;
+  }
+
+  Element& operator=(Element&& other) {
+    texte_ = std::move(other.texte_);
+    return *this;
+  }
+
+  ~Element() {
+    vivants --;
+  }
+
+  bool operator==(const Element& other) const {
+    return texte_ == other.texte_;
+  }
+
+  bool operator!=(const Element& other) const {
+    return !(*this == other);
+  }
+
+  /**
+   * @return @c true si la chaîne est de longueur impaire sinon @c false.
+   */
+  bool impair() const {
+    return texte_.size() % 2 == 1;
+  }
+
+private:
+
+  std::string texte_; // La valeur, sous forme de chaîne.
+
+}; // Element
+
+long Element::vivants = 0;
+
+/**
+ * Prédicat dénombré par CountIf sur les listes comparées.
+ *
+ * @param[in] e - un élément.
+ * @return @c true si @c e est de longueur impaire sinon @c false.
+ */
+bool
+estImpair(const Element& e) {
+  return e.impair();
+}
+
+/**
+ * Comparaison d'une liste segmentée et de la liste de référence, dans les
+ * deux sens de parcours (operator++ puis operator--), et vérification de la
+ * cohérence du répertoire des segments avec leur chaînage.
+ *
+ * @param[in] a - la liste segmentée.
+ * @param[in] b - la liste de référence.
+ * @return @c true si les deux listes sont identiques sinon @c false.
+ */
+template< typename List >
+bool
+identiques(const List& a, const std::list< Element >& b) {
+
+  if (a.size() != b.size() || a.empty() != b.empty()) {
+    return false;
+  }
+  if (!std::equal(b.begin(), b.end(), a.begin())) {
+    return false;
+  }
+
+  // Parcours à rebours.
+  typename List::const_iterator i = a.end();
+  for (auto j = b.rbegin(); j != b.rend(); ++ j) {
+    if (*(-- i) != *j) {
+      return false;
+    }
+  }
+  if (i != a.begin()) {
+    return false;
+  }
+
+  // Les segments du répertoire, pris dans l'ordre, couvrent la liste sans
+  // trou ni segment vide.
+  typename List::const_iterator it = a.begin();
+  size_t total = 0;
+  for (size_t s = 0; s != a.segments(); s ++) {
+    const size_t taille = a.segmentEnd(s) - a.segmentBegin(s);
+    if (taille == 0 || taille > List::capacity || &*it != a.segmentBegin(s)) {
+      return false;
+    }
+    std::advance(it, taille);
+    total += taille;
+  }
+  return it == a.end() && total == a.size();
+
+}
+
+/**
+ * Test différentiel d'une liste segmentée contre std::list : une suite
+ * aléatoire d'insertions (provoquant scissions de segments pleins et
+ * emprunts au segment précédent), de suppressions (provoquant la libération
+ * de segments vidés), d'ajouts et de retraits en tête comme en queue est
+ * appliquée aux deux listes, qui sont régulièrement comparées.
+ *
+ * @param[in] graine - la graine du générateur pseudo-aléatoire.
+ * @param[in] operations - le nombre d'opérations.
+ * @param[in] titre - le titre du test.
+ * @return @c true si le test a réussi sinon @c false.
+ */
+template< size_t Bytes >
+bool
+tester(const unsigned& graine,
+       const int& operations,
+       const std::string& titre) {
+
+  typedef paralgos::SegmentedList< Element, Bytes > List;
+
+  std::mt19937 alea(graine);
+  bool verdict = true;
+  {
+    List a;
+    std::list< Element > b;
+
+    for (int op = 0; op < operations && verdict; op ++) {
+
+      const Element e(alea() % 1000);
+      const unsigned choix = alea() % 16;
+
+      if (choix < 3) {
+	a.push_back(e);
+	b.push_back(e);
+      } else if (choix < 5) {
+	a.push_front(e);
+	b.push_front(e);
+      } else if (choix < 10) {
+	// Insertion au hasard, en tête de segment en particulier.
+	const size_t p = alea() % (b.size() + 1);
+	typename List::iterator i = a.begin();
+	std::list< Element >::iterator j = b.begin();
+	std::advance(i, p);
+	std::advance(j, p);
+	verdict = *a.insert(i, e) == *b.insert(j, e);
+      } else if (!b.empty()) {
+	if (choix == 10) {
+	  verdict = a.back() == b.back();
+	  a.pop_back();
+	  b.pop_back();
+	} else if (choix == 11) {
+	  verdict = a.front() == b.front();
+	  a.pop_front();
+	  b.pop_front();
+	} else {
+	  const size_t p = alea() % b.size();
+	  typename List::iterator i = a.begin();
+	  std::list< Element >::iterator j = b.begin();
+	  std::advance(i, p);
+	  std::advance(j, p);
+	  i = a.erase(i);
+	  j = b.erase(j);
+	  verdict = (i == a.end()) == (j == b.end())
+	    && (j == b.end() || *i == *j);
+	}
+      }
+
+      if (op % 257 == 0) {
+	verdict = verdict && identiques(a, b);
+      }
+
+    }
+    verdict = verdict && identiques(a, b);
+
+    // Dénombrement parallèle sur la liste obtenue.
+    verdict = verdict
+      && paralgos::CountIf::apply(a, estImpair)
+         == std::count_if(b.begin(), b.end(), estImpair);
+
+    // Recopie, affectation (y compris à soi-même) et vidage.
+    List c(a);
+    verdict = verdict && identiques(c, b);
+    List& d = c;
+    c = d;
+    verdict = verdict && identiques(c, b);
+    a.clear();
+    verdict = verdict && a.empty() && a.begin() == a.end()
+      && a.segments() == 0;
+    a = c;
+    verdict = verdict && identiques(a, b);
+  }
+
+  // Aucune instance ne doit survivre aux listes.
+  verdict = verdict && Element::vivants == 0;
+
+  std::cout << "--[ " << titre << ": begin ] --" << std::endl;
+  std::cout << "\tCapacité :\t" << List::capacity << std::endl;
+  std::cout << "\tVerdict:\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "--[ " << titre << ": end ] --" << std::endl;
+  std::cout << std::endl;
+
+  return verdict;
+
+}
+
+/**
+ * Programme de test de la liste segmentée.
+ *
+ * @return @c EXIT_SUCCESS si tous les tests ont réussi sinon
+ *   @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  bool verdict = true;
+
+  // Segments de deux éléments : scissions et libérations très fréquentes.
+  verdict = tester< 64 >(1, 20000, "segmented list (64 octets)") && verdict;
+
+  // Segments de taille par défaut.
+  verdict = tester< 512 >(2, 50000, "segmented list (512 octets)") && verdict;
+
+  return verdict ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,281 @@
+#include "bcmat.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#define HEADER 32 // Taille de l'entête d'un bloc en octets.
+
+// Modes de stockage d'un plan d'octets.
+enum { PLANE_ZERO = 0, PLANE_CONST = 1, PLANE_RAW = 2 };
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Longueur d'un plan d'octets, arrondie au multiple de 16 supérieur afin que
+ * le décodage procède par registres entiers.
+ */
+static inline unsigned
+padded(const unsigned len) {
+  return (len + 15) & ~15u;
+}
+
+/*
+ * Codage d'un bloc de len floats. Si out est NULL, seule la taille du bloc
+ * codé est calculée.
+ *
+ * Entête : les quatre premiers floats (16 octets), les modes des quatre plans
+ * (4 octets), leurs valeurs constantes (4 octets) et 8 octets de bourrage.
+ */
+static size_t
+encode(const float src[], const unsigned len, unsigned char* out) {
+
+  uint32_t first[4] = { 0, 0, 0, 0 };
+  memcpy(first, src, sizeof(float) * (len < 4 ? len : 4));
+
+  // Résidus : r[k] = bits(k) ^ bits(k - 4), les quatre premiers étant
+  // rapportés à l'entête (donc nuls).
+  uint32_t residual[BCMAT_BLOCK];
+  for (unsigned k = 0; k != len; k ++) {
+    uint32_t cur, prev;
+    memcpy(&cur, src + k, sizeof(float));
+    if (k < 4) {
+      prev = first[k];
+    } else {
+      memcpy(&prev, src + k - 4, sizeof(float));
+    }
+    residual[k] = cur ^ prev;
+  }
+
+  // Analyse de chaque plan.
+  unsigned char mode[4], value[4];
+  size_t bytes = HEADER;
+  for (unsigned p = 0; p != 4; p ++) {
+    const unsigned char c = (unsigned char) (residual[0] >> (8 * p));
+    int constant = 1;
+    for (unsigned k = 1; k != len && constant; k ++) {
+      constant = (unsigned char) (residual[k] >> (8 * p)) == c;
+    }
+    mode[p] = !constant ? PLANE_RAW : c == 0 ? PLANE_ZERO : PLANE_CONST;
+    value[p] = c;
+    if (mode[p] == PLANE_RAW) {
+      bytes += padded(len);
+    }
+  }
+
+  if (out == NULL) {
+    return bytes;
+  }
+
+  // Écriture de l'entête puis des plans stockés tels quels.
+  memset(out, 0, HEADER);
+  memcpy(out, first, sizeof(first));
+  memcpy(out + 16, mode, 4);
+  memcpy(out + 20, value, 4);
+  unsigned char* plane = out + HEADER;
+  for (unsigned p = 0; p != 4; p ++) {
+    if (mode[p] != PLANE_RAW) {
+      continue;
+    }
+    for (unsigned k = 0; k != len; k ++) {
+      plane[k] = (unsigned char) (residual[k] >> (8 * p));
+    }
+    memset(plane + len, 0, padded(len) - len);
+    plane += padded(len);
+  }
+
+  return bytes;
+
+}
+
+/*
+ * Décodage d'un bloc de len floats dans tile (aligné sur 16 octets, d'au
+ * moins padded(len) floats). Les plans sont désentrelacés seize floats à la
+ * fois par deux niveaux d'unpack, puis le codage XOR est défait registre par
+ * registre. Un plan constant (ou nul) est lu dans un registre fixe, d'où un
+ * décodage sans branchement.
+ *
+ * Retourne l'adresse du bloc suivant.
+ */
+static const unsigned char*
+decode(const unsigned char* block, const unsigned len, float tile[]) {
+
+  const unsigned char* mode = block + 16;
+  const unsigned char* value = block + 20;
+
+  // Source et pas de chaque plan.
+  _Alignas(16) unsigned char constant[4][16];
+  const unsigned char* src[4];
+  unsigned step[4];
+  const unsigned char* plane = block + HEADER;
+  for (unsigned p = 0; p != 4; p ++) {
+    if (mode[p] == PLANE_RAW) {
+      src[p] = plane;
+      step[p] = 16;
+      plane += padded(len);
+    } else {
+      memset(constant[p], mode[p] == PLANE_ZERO ? 0 : value[p], 16);
+      src[p] = constant[p];
+      step[p] = 0;
+    }
+  }
+
+  __m128i prev = _mm_load_si128((const __m128i*) block);
+  const unsigned end = padded(len);
+  for (unsigned k = 0; k != end; k += 16) {
+
+    const __m128i b0 = _mm_load_si128((const __m128i*) src[0]);
+    const __m128i b1 = _mm_load_si128((const __m128i*) src[1]);
+    const __m128i b2 = _mm_load_si128((const __m128i*) src[2]);
+    const __m128i b3 = _mm_load_si128((const __m128i*) src[3]);
+    src[0] += step[0];
+    src[1] += step[1];
+    src[2] += step[2];
+    src[3] += step[3];
+
+    // Octets 0-1 et 2-3 de chaque float, puis floats complets.
+    const __m128i lo01 = _mm_unpacklo_epi8(b0, b1);
+    const __m128i hi01 = _mm_unpackhi_epi8(b0, b1);
+    const __m128i lo23 = _mm_unpacklo_epi8(b2, b3);
+    const __m128i hi23 = _mm_unpackhi_epi8(b2, b3);
+    __m128i* out = (__m128i*) (tile + k);
+    prev = _mm_xor_si128(prev, _mm_unpacklo_epi16(lo01, lo23));
+    _mm_store_si128(out,     prev);
+    prev = _mm_xor_si128(prev, _mm_unpackhi_epi16(lo01, lo23));
+    _mm_store_si128(out + 1, prev);
+    prev = _mm_xor_si128(prev, _mm_unpacklo_epi16(hi01, hi23));
+    _mm_store_si128(out + 2, prev);
+    prev = _mm_xor_si128(prev, _mm_unpackhi_epi16(hi01, hi23));
+    _mm_store_si128(out + 3, prev);
+
+  }
+
+  return plane;
+
+}
+
+/****************
+ * bcmat_create *
+ ****************/
+
+bcmat_t*
+bcmat_create(const float A[], const unsigned size) {
+
+  bcmat_t* M = (bcmat_t*) malloc(sizeof(bcmat_t));
+  M->size = size;
+  M->rows = (size_t*) malloc(sizeof(size_t) * (size + 1));
+
+  // Première passe : taille de chaque ligne codée.
+  size_t bytes = 0;
+  for (unsigned i = 0; i != size; i ++) {
+    M->rows[i] = bytes;
+    for (unsigned k0 = 0; k0 < size; k0 += BCMAT_BLOCK) {
+      const unsigned len = size - k0 < BCMAT_BLOCK ? size - k0 : BCMAT_BLOCK;
+      bytes += encode(A + (size_t) i * size + k0, len, NULL);
+    }
+  }
+  M->rows[size] = bytes;
+  M->bytes = bytes;
+
+  // Seconde passe : codage. Les tailles de blocs étant des multiples de 16,
+  // chaque bloc reste aligné.
+  M->data = (unsigned char*) aligned_alloc(16, bytes ? bytes : 16);
+  for (unsigned i = 0; i != size; i ++) {
+    unsigned char* out = M->data + M->rows[i];
+    for (unsigned k0 = 0; k0 < size; k0 += BCMAT_BLOCK) {
+      const unsigned len = size - k0 < BCMAT_BLOCK ? size - k0 : BCMAT_BLOCK;
+      out += encode(A + (size_t) i * size + k0, len, out);
+    }
+  }
+
+  return M;
+
+}
+
+/**************
+ * bcmat_free *
+ **************/
+
+void
+bcmat_free(bcmat_t* M) {
+
+  if (M == NULL) {
+    return;
+  }
+  free(M->rows);
+  free(M->data);
+  free(M);
+
+}
+
+/****************
+ * bcmat_decode *
+ ****************/
+
+void
+bcmat_decode(const bcmat_t* M, float A[]) {
+
+  const unsigned size = M->size;
+  _Alignas(16) float tile[BCMAT_BLOCK];
+
+  for (unsigned i = 0; i != size; i ++) {
+    const unsigned char* block = M->data + M->rows[i];
+    for (unsigned k0 = 0; k0 < size; k0 += BCMAT_BLOCK) {
+      const unsigned len = size - k0 < BCMAT_BLOCK ? size - k0 : BCMAT_BLOCK;
+      block = decode(block, len, tile);
+      memcpy(A + (size_t) i * size + k0, tile, sizeof(float) * len);
+    }
+  }
+
+}
+
+/****************
+ * bcmat_matvec *
+ ****************/
+
+void
+bcmat_matvec(const bcmat_t* M,
+             const float x[restrict],
+                   float b[restrict]) {
+
+  const unsigned size = M->size;
+
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < (int) size; i ++) {
+
+    // Tampon de décodage propre à chaque thread.
+    _Alignas(16) float tile[BCMAT_BLOCK];
+
+    const unsigned char* block = M->data + M->rows[i];
+    xmm_t acc;
+    acc.m128_vec = _mm_setzero_ps();
+    float tail = 0.0f;
+
+    for (unsigned k0 = 0; k0 < size; k0 += BCMAT_BLOCK) {
+      const unsigned len = size - k0 < BCMAT_BLOCK ? size - k0 : BCMAT_BLOCK;
+      block = decode(block, len, tile);
+      unsigned k = 0;
+      for (; k + 4 <= len; k += 4) {
+        acc.m128_vec = _mm_add_ps(acc.m128_vec,
+                                  _mm_mul_ps(_mm_load_ps(tile + k),
+                                             _mm_loadu_ps(x + k0 + k)));
+      }
+      for (; k != len; k ++) {
+        tail += tile[k] * x[k0 + k];
+      }
+    }
+
+    b[i] = acc.m128_f32[0] + acc.m128_f32[1]
+      + acc.m128_f32[2] + acc.m128_f32[3] + tail;
+
+  }
+
+}
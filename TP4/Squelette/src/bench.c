@@ -4,12 +4,20 @@
  * Programme de benchmarking de différents algorithmes optimisés de 
  * multiplication matrice-vecteur sur le type float. 
  *
- * Les quatres algorithmes comparés sont sélectionnés via les symboles 
- * pré-processeur suivants : @c RAW (forme canonique et choix par défaut), 
- * @c R4 (déroulage de boucle sur une profondeur de 4 et @c SSE_R4 (jeu 
- * d'instructions SSE sur 128 bits). Le symbole spécial @c DRY_RUN désigne 
- * l'enveloppe de l'algorithme c'est à dire l'ensemble du programme sans les 
- * instructions relatives au produit.
+ * Les algorithmes comparés sont sélectionnés via les symboles pré-processeur
+ * suivants :
+ *  - @c RAW : forme canonique (choix par défaut) ;
+ *  - @c R4 : déroulage de boucle sur une profondeur de 4 ;
+ *  - @c SSE_R4 : jeu d'instructions SSE sur 128 bits ;
+ *  - @c SGEMV : interface BLAS @c sgemv, alpha et beta étant appliqués par les
+ *    noyaux SSE ;
+ *  - @c TUNED : noyau et paramètres choisis par la table de tuning produite
+ *    par le programme @c tune (cible @c autotune) ;
+ *  - @c FIXED : noyaux C++ spécialisés à la compilation pour les tailles 64,
+ *    128, 256 et 512.
+ *
+ * Le symbole spécial @c DRY_RUN désigne l'enveloppe de l'algorithme c'est à
+ * dire l'ensemble du programme sans les instructions relatives au produit.
  *
  * Les algorithmes sont exécutés plusieurs fois afin d'obtenir des durées
  * d'exécutions significatives.
@@ -18,14 +26,25 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+// Dimensions par défaut, redéfinissables à la compilation.
+#ifndef SIZE
 #define SIZE  2048 // Longueur de nos vecteurs.
+#endif
+#ifndef ITERS
 #define ITERS   10 // Nombre de répétitions de l'algorithme.
+#endif
 
 // Inclusion du header correspondant à l'algorithme sélectionné.
 #if defined(R4)
 #include "matvec_r4.h"
 #elif defined(SSE_R4)
 #include "matvec_sse_r4.h"
+#elif defined(SGEMV)
+#include "sgemv.h"
+#elif defined(TUNED)
+#include "matvec_tune.h"
+#elif defined(FIXED)
+#include "matvec_fixed.h"
 #else
 #include "matvec.h"
 #endif
@@ -45,7 +64,7 @@ main() {
 
   // Allocation dynamique avec l'alignement correspondant au jeu d'instructions
   // utilisé.
-#if defined(SSE_R4)
+#if defined(SSE_R4) || defined(TUNED) || defined(FIXED)
   A = (float*) aligned_alloc(16, sizeof(float) * SIZE * SIZE);
   x = (float*) aligned_alloc(16, sizeof(float) * SIZE);
   b = (float*) aligned_alloc(16, sizeof(float) * SIZE);
@@ -67,6 +86,13 @@ main() {
     matvec_r4    (A, x, b, SIZE);
 #elif defined(SSE_R4)
     matvec_sse_r4(A, x, b, SIZE);
+#elif defined(SGEMV)
+    sgemv(SGEMV_ROW_MAJOR, SGEMV_NO_TRANS, SIZE, SIZE,
+          1.0f, A, SIZE, x, 1, 0.0f, b, 1);
+#elif defined(TUNED)
+    matvec_tuned (A, x, b, SIZE);
+#elif defined(FIXED)
+    matvec_fixed (A, x, b, SIZE);
 #else
     matvec       (A, x, b, SIZE);
 #endif    
@@ -0,0 +1,126 @@
+/**
+ * Programme de benchmarking du produit matrice-vecteur sur matrice compressée.
+ *
+ * Pour plusieurs matrices plus ou moins structurées (constante, à valeurs
+ * entières, lisse et aléatoire), le programme affiche le taux de compression
+ * obtenu, vérifie que la décompression restitue la matrice à l'identique,
+ * puis compare la durée d'un produit @c bcmat_matvec à celle de
+ * @c matvec_sse_r4 sur la matrice non compressée.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+
+#include "matvec_sse_r4.h"
+#include "bcmat.h"
+
+#define SIZE  4096 // Longueur de nos vecteurs.
+#define ITERS   20 // Nombre de répétitions de chaque produit.
+
+/**
+ * Remplissage de la matrice selon le type demandé.
+ *
+ * @param[out] A la matrice (dépliée en tableau).
+ * @param[in]  kind le type de matrice (0 : constante, 1 : entière, 2 : lisse,
+ *   3 : aléatoire).
+ */
+static void
+fill(float A[], const unsigned kind) {
+
+  for (unsigned i = 0; i != SIZE; i ++) {
+    for (unsigned j = 0; j != SIZE; j ++) {
+      float a;
+      switch (kind) {
+      case 0:
+        a = 1.0f;
+        break;
+      case 1:
+        a = (float) ((i + 3 * j) % 16);
+        break;
+      case 2:
+        a = (float) exp(-fabs((double) i - j) / SIZE);
+        break;
+      default:
+        a = 2.0f * rand() / RAND_MAX - 1.0f;
+      }
+      A[(size_t) i * SIZE + j] = a;
+    }
+  }
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS si toutes les matrices sont restituées sans perte,
+ *   sinon @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  static const char* names[] = { "constante", "entiere", "lisse", "aleatoire" };
+
+  float* A = (float*) aligned_alloc(16, sizeof(float) * SIZE * SIZE);
+  float* D = (float*) aligned_alloc(16, sizeof(float) * SIZE * SIZE);
+  float* x = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* b = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* c = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+
+  for (unsigned i = 0; i != SIZE; i ++) {
+    x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  printf("%-10s %9s %10s %12s %12s %9s %10s\n",
+         "matrice", "taux", "sans perte", "dense (ms)", "compr. (ms)",
+         "speedup", "ecart max");
+
+  int lossless = 1;
+  for (unsigned kind = 0; kind != sizeof(names) / sizeof(char*); kind ++) {
+
+    fill(A, kind);
+    bcmat_t* M = bcmat_create(A, SIZE);
+
+    bcmat_decode(M, D);
+    const int same = memcmp(A, D, sizeof(float) * SIZE * SIZE) == 0;
+    lossless = lossless && same;
+
+    double start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      matvec_sse_r4(A, x, b, SIZE);
+    }
+    const double dense = (omp_get_wtime() - start) / ITERS;
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      bcmat_matvec(M, x, c);
+    }
+    const double compressed = (omp_get_wtime() - start) / ITERS;
+
+    // Les deux produits ne sommant pas dans le même ordre, seul un écart
+    // d'arrondi est attendu.
+    float gap = 0.0f;
+    for (unsigned i = 0; i != SIZE; i ++) {
+      gap = fmaxf(gap, fabsf(b[i] - c[i]));
+    }
+
+    printf("%-10s %8.2f%% %10s %12.3f %12.3f %9.2f %10.2e\n",
+           names[kind], 100.0 * M->bytes / (sizeof(float) * SIZE * SIZE),
+           same ? "oui" : "non", dense * 1e3, compressed * 1e3,
+           dense / compressed, gap);
+
+    bcmat_free(M);
+
+  }
+
+  free(A);
+  free(D);
+  free(x);
+  free(b);
+  free(c);
+
+  return lossless ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,119 @@
+/**
+ * Programme de benchmarking du produit matrice creuse par blocs-vecteur.
+ *
+ * Le programme construit des matrices issues d'un maillage éléments finis
+ * (grille de nœuds à 9 voisins, chaque nœud portant dof inconnues couplées
+ * entre elles), dont les éléments non nuls forment des blocs denses
+ * dof x dof. Pour chacune, il affiche la taille de blocs retenue par
+ * @c bsr_detect et le taux de remplissage, puis compare les durées de
+ * @c csr_matvec et @c bsr_matvec ainsi que l'écart maximal entre leurs
+ * résultats.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "csr.h"
+#include "bsr.h"
+
+#define GRID   300 // Nombre de nœuds par côté de la grille.
+#define ITERS   20 // Nombre de répétitions de chaque produit.
+
+/*
+ * Matrice d'une grille GRID x GRID de nœuds à dof inconnues : la ligne
+ * (n, d) couple l'inconnue d du nœud n à toutes les inconnues du nœud n et
+ * de ses 8 voisins.
+ */
+static csr_t*
+fem(const unsigned dof) {
+
+  const unsigned nodes = GRID * GRID;
+  csr_t* C = csr_create(nodes * dof, nodes * dof, (size_t) nodes * 9 * dof * dof);
+
+  size_t k = 0;
+  for (unsigned n = 0; n != nodes; n ++) {
+    const int y = n / GRID, x = n % GRID;
+    for (unsigned d = 0; d != dof; d ++) {
+      for (int dy = -1; dy <= 1; dy ++) {
+        for (int dx = -1; dx <= 1; dx ++) {
+          if (y + dy < 0 || y + dy >= GRID || x + dx < 0 || x + dx >= GRID) {
+            continue;
+          }
+          const unsigned m = (y + dy) * GRID + x + dx;
+          for (unsigned e = 0; e != dof; e ++) {
+            C->col[k] = m * dof + e;
+            C->val[k] = 2.0f * rand() / RAND_MAX - 1.0f;
+            k ++;
+          }
+        }
+      }
+      C->ptr[n * dof + d + 1] = k;
+    }
+  }
+  C->nnz = k;
+
+  return C;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  static const unsigned dofs[] = { 1, 2, 3, 4, 6, 8 };
+
+  printf("%4s %4s %8s %12s %12s %9s %10s\n", "dof", "bs", "remplis.",
+         "csr (ms)", "bsr (ms)", "speedup", "ecart max");
+
+  for (unsigned s = 0; s != sizeof(dofs) / sizeof(unsigned); s ++) {
+
+    csr_t* C = fem(dofs[s]);
+    double fill;
+    const unsigned bs = bsr_detect(C, &fill);
+
+    float* x = (float*) malloc(sizeof(float) * C->cols);
+    float* y = (float*) malloc(sizeof(float) * C->rows);
+    float* z = (float*) malloc(sizeof(float) * C->rows);
+    for (unsigned i = 0; i != C->cols; i ++) {
+      x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+    }
+
+    double start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      csr_matvec(C, x, y);
+    }
+    const double csr = (omp_get_wtime() - start) / ITERS;
+
+    // Même lorsque le format CSR est préféré, la taille dof est mesurée.
+    bsr_t* B = bsr_from_csr(C, bs > 1 ? bs : dofs[s]);
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      bsr_matvec(B, x, z);
+    }
+    const double bsr = (omp_get_wtime() - start) / ITERS;
+
+    float gap = 0.0f;
+    for (unsigned i = 0; i != C->rows; i ++) {
+      gap = fmaxf(gap, fabsf(y[i] - z[i]));
+    }
+
+    printf("%4u %4u %8.2f %12.3f %12.3f %9.2f %10.2e\n", dofs[s], bs, fill,
+           csr * 1e3, bsr * 1e3, csr / bsr, gap);
+
+    bsr_free(B);
+    csr_free(C);
+    free(x);
+    free(y);
+    free(z);
+
+  }
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,148 @@
+/**
+ * Programme de benchmarking du produit matrice-vecteur compensé.
+ *
+ * Pour une matrice à coefficients positifs et une matrice à coefficients de
+ * signes et d'ordres de grandeur variés (sommes sujettes aux cancellations),
+ * le programme compare @c matvec, @c matvec_sse_r4, @c matvec_kahan et un
+ * produit dont la matrice et les vecteurs sont stockés en double précision.
+ * Il affiche la durée de chaque produit, son surcoût par rapport à
+ * @c matvec_sse_r4 et l'erreur relative maximale par rapport à un résultat
+ * calculé en précision étendue.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "matvec.h"
+#include "matvec_sse_r4.h"
+#include "matvec_kahan.h"
+
+#define SIZE  4096 // Longueur de nos vecteurs.
+#define ITERS   10 // Nombre de répétitions de chaque produit.
+
+/**
+ * Produit matrice-vecteur en double précision.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ */
+static void
+dmatvec(const double A[], const double x[], double b[]) {
+  for (unsigned i = 0; i != SIZE; i ++) {
+    double sum = 0.0;
+    for (unsigned k = 0; k != SIZE; k ++) {
+      sum += A[(size_t) i * SIZE + k] * x[k];
+    }
+    b[i] = sum;
+  }
+}
+
+/**
+ * Erreur relative maximale.
+ *
+ * @param[in] b le résultat.
+ * @param[in] ref la référence.
+ * @return max |b[i] - ref[i]| / |ref[i]|.
+ */
+static double
+error(const float b[], const long double ref[]) {
+  double err = 0.0;
+  for (unsigned i = 0; i != SIZE; i ++) {
+    err = fmax(err, (double) fabsl((b[i] - ref[i]) / ref[i]));
+  }
+  return err;
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  static const char* names[] = { "positive", "cancellation" };
+
+  float* A = (float*) aligned_alloc(16, sizeof(float) * SIZE * SIZE);
+  float* x = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* b = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  double* dA = (double*) malloc(sizeof(double) * SIZE * SIZE);
+  double* dx = (double*) malloc(sizeof(double) * SIZE);
+  double* db = (double*) malloc(sizeof(double) * SIZE);
+  long double* ref = (long double*) malloc(sizeof(long double) * SIZE);
+
+  printf("%-13s %-14s %12s %9s %14s\n", "matrice", "noyau", "durée (ms)",
+         "surcoût", "erreur relat.");
+
+  for (unsigned m = 0; m != sizeof(names) / sizeof(char*); m ++) {
+
+    for (unsigned i = 0; i != SIZE * SIZE; i ++) {
+      const float r = (float) rand() / RAND_MAX;
+      A[i] = m == 0 ? r
+        : (rand() % 2 ? 1.0f : -1.0f) * ldexpf(r, rand() % 21 - 10);
+      dA[i] = A[i];
+    }
+    for (unsigned i = 0; i != SIZE; i ++) {
+      x[i] = (float) rand() / RAND_MAX;
+      dx[i] = x[i];
+    }
+    for (unsigned i = 0; i != SIZE; i ++) {
+      long double sum = 0.0L;
+      for (unsigned k = 0; k != SIZE; k ++) {
+        sum += (long double) A[i * SIZE + k] * x[k];
+      }
+      ref[i] = sum;
+    }
+
+    double start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      matvec_sse_r4(A, x, b, SIZE);
+    }
+    const double sse = (omp_get_wtime() - start) / ITERS;
+    const double sse_err = error(b, ref);
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      matvec(A, x, b, SIZE);
+    }
+    const double raw = (omp_get_wtime() - start) / ITERS;
+    printf("%-13s %-14s %12.3f %9.2f %14.2e\n", names[m], "matvec",
+           raw * 1e3, raw / sse, error(b, ref));
+    printf("%-13s %-14s %12.3f %9.2f %14.2e\n", names[m], "matvec_sse_r4",
+           sse * 1e3, 1.0, sse_err);
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      matvec_kahan(A, x, b, SIZE);
+    }
+    const double kahan = (omp_get_wtime() - start) / ITERS;
+    printf("%-13s %-14s %12.3f %9.2f %14.2e\n", names[m], "matvec_kahan",
+           kahan * 1e3, kahan / sse, error(b, ref));
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      dmatvec(dA, dx, db);
+    }
+    const double dbl = (omp_get_wtime() - start) / ITERS;
+    for (unsigned i = 0; i != SIZE; i ++) {
+      b[i] = (float) db[i];
+    }
+    printf("%-13s %-14s %12.3f %9.2f %14.2e\n", names[m], "double",
+           dbl * 1e3, dbl / sse, error(b, ref));
+
+  }
+
+  free(A);
+  free(x);
+  free(b);
+  free(dA);
+  free(dx);
+  free(db);
+  free(ref);
+
+  return EXIT_SUCCESS;
+
+}
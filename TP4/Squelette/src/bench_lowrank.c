@@ -0,0 +1,101 @@
+/**
+ * Programme de benchmarking du produit matrice-vecteur par approximation de
+ * rang faible.
+ *
+ * La matrice est une matrice de noyau gaussien A[i][j] = exp(-(s_i - s_j)^2 /
+ * h) avec s_i = i / n, dont les valeurs singulières décroissent rapidement.
+ * Pour différents rangs k, le programme affiche la durée de construction de
+ * l'approximation, la durée d'un produit comparée à celle de
+ * @c matvec_sse_r4, le volume de données lu par rapport au stockage dense, la
+ * borne d'erreur fournie par l'approximation et l'erreur effectivement
+ * mesurée sur un vecteur aléatoire.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "matvec_sse_r4.h"
+#include "lowrank.h"
+
+#define SIZE  2048 // Longueur de nos vecteurs.
+#define ITERS  100 // Nombre de répétitions de chaque produit.
+#define WIDTH 0.05 // Largeur h du noyau gaussien.
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  static const unsigned ranks[] = { 4, 8, 16, 32, 64 };
+
+  float* A = (float*) aligned_alloc(16, sizeof(float) * SIZE * SIZE);
+  float* x = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* b = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* c = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+
+  for (unsigned i = 0; i != SIZE; i ++) {
+    for (unsigned j = 0; j != SIZE; j ++) {
+      const double d = ((double) i - j) / SIZE;
+      A[i * SIZE + j] = (float) exp(-d * d / WIDTH);
+    }
+  }
+  double xnorm = 0.0;
+  for (unsigned i = 0; i != SIZE; i ++) {
+    x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+    xnorm += (double) x[i] * x[i];
+  }
+  xnorm = sqrt(xnorm);
+
+  // Référence dense.
+  double start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    matvec_sse_r4(A, x, b, SIZE);
+  }
+  const double dense = (omp_get_wtime() - start) / ITERS;
+
+  printf("dense : %.3f us par produit\n\n", dense * 1e6);
+  printf("%4s %12s %12s %9s %9s %12s %12s\n",
+         "k", "constr. (s)", "produit (us)", "speedup", "octets",
+         "borne", "mesure");
+
+  for (unsigned t = 0; t != sizeof(ranks) / sizeof(unsigned); t ++) {
+
+    const unsigned k = ranks[t];
+
+    start = omp_get_wtime();
+    lowrank_t* L = lowrank_create(A, SIZE, k, 1);
+    const double build = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      lowrank_matvec(L, x, c);
+    }
+    const double compressed = (omp_get_wtime() - start) / ITERS;
+
+    // Erreur mesurée ||b - c|| / ||x||, à comparer à la borne.
+    double err = 0.0;
+    for (unsigned i = 0; i != SIZE; i ++) {
+      err += ((double) b[i] - c[i]) * ((double) b[i] - c[i]);
+    }
+
+    printf("%4u %12.3f %12.3f %9.2f %8.2f%% %12.3e %12.3e\n",
+           k, build, compressed * 1e6, dense / compressed,
+           100.0 * 2.0 * k / SIZE, L->error, sqrt(err) / xnorm);
+
+    lowrank_free(L);
+
+  }
+
+  free(A);
+  free(x);
+  free(b);
+  free(c);
+
+  return EXIT_SUCCESS;
+
+}
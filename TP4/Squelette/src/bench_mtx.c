@@ -0,0 +1,307 @@
+/**
+ * Programme de benchmarking du chargement de matrices.
+ *
+ * Une matrice creuse (format Matrix Market « coordinate ») et une matrice
+ * dense (format « array ») sont écrites dans des fichiers temporaires, puis
+ * chargées :
+ *  - par une lecture séquentielle à base de @c fscanf, servant de référence ;
+ *  - par @c mtx_load_csr ou @c mtx_load_dense, avec un thread puis avec tous
+ *    les threads disponibles ;
+ *  - depuis le fichier cache binaire écrit par @c mtx_save_csr ou
+ *    @c mtx_save_dense.
+ * Le programme affiche les durées et débits obtenus et vérifie que les
+ * matrices chargées sont identiques. Il vérifie enfin que les deux
+ * chargeurs additionnent les éléments figurant plusieurs fois dans un petit
+ * fichier symétrique, et que cette somme ne dépend ni du nombre de threads
+ * ni de l'exécution.
+ */
+
+#define _POSIX_C_SOURCE 200809L // mkstemp, fdopen.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <omp.h>
+
+#include "csr.h"
+#include "mtx.h"
+
+#define ROWS  100000 // Nombre de lignes de la matrice creuse.
+#define PER       16 // Nombre d'éléments non nuls par ligne.
+#define SIZE    1024 // Longueur des vecteurs de la matrice dense.
+
+/**
+ * Création d'un fichier temporaire.
+ *
+ * @param[out] path le chemin du fichier (modèle de 32 caractères au moins).
+ * @return le fichier, ouvert en écriture.
+ */
+static FILE*
+temporary(char path[]) {
+  strcpy(path, "/tmp/bench_mtx_XXXXXX");
+  return fdopen(mkstemp(path), "w");
+}
+
+/**
+ * Taille d'un fichier en Mo.
+ *
+ * @param[in] path le chemin du fichier.
+ * @return la taille.
+ */
+static double
+megabytes(const char* path) {
+  struct stat st;
+  stat(path, &st);
+  return st.st_size / 1048576.0;
+}
+
+/**
+ * Lecture séquentielle de référence d'un fichier « coordinate general » dont
+ * les lignes sont triées par colonnes.
+ *
+ * @param[in] path le chemin du fichier.
+ * @return la matrice.
+ */
+static csr_t*
+reference(const char* path) {
+
+  FILE* file = fopen(path, "r");
+  char line[256];
+  do {
+    fgets(line, sizeof(line), file);
+  } while (line[0] == '%');
+  unsigned rows, cols;
+  size_t nnz;
+  sscanf(line, "%u %u %zu", &rows, &cols, &nnz);
+
+  csr_t* C = csr_create(rows, cols, nnz);
+  unsigned* I = (unsigned*) malloc(sizeof(unsigned) * nnz);
+  for (unsigned i = 0; i != rows; i ++) {
+    C->ptr[i + 1] = 0;
+  }
+  for (size_t k = 0; k != nnz; k ++) {
+    fscanf(file, "%u %u %f", I + k, C->col + k, C->val + k);
+    C->col[k] --;
+    C->ptr[I[k] --] ++;
+  }
+  fclose(file);
+  for (unsigned i = 0; i != rows; i ++) {
+    C->ptr[i + 1] += C->ptr[i];
+  }
+  free(I);
+
+  return C;
+
+}
+
+/**
+ * Comparaison de deux matrices CSR.
+ *
+ * @param[in] C la première matrice.
+ * @param[in] D la seconde matrice.
+ * @return l'écart maximal entre les valeurs, ou @c INFINITY si leurs
+ *   structures diffèrent.
+ */
+static float
+compare(const csr_t* C, const csr_t* D) {
+
+  if (C == NULL || D == NULL || C->rows != D->rows || C->nnz != D->nnz
+      || memcmp(C->ptr, D->ptr, sizeof(size_t) * (C->rows + 1)) != 0
+      || memcmp(C->col, D->col, sizeof(unsigned) * C->nnz) != 0) {
+    return INFINITY;
+  }
+  float gap = 0.0f;
+  for (size_t k = 0; k != C->nnz; k ++) {
+    gap = fmaxf(gap, fabsf(C->val[k] - D->val[k]));
+  }
+  return gap;
+
+}
+
+/**
+ * Affichage d'une mesure.
+ *
+ * @param[in] name le nom du chargement.
+ * @param[in] seconds sa durée.
+ * @param[in] size la taille du fichier lu (en Mo).
+ * @param[in] gap l'écart à la référence.
+ */
+static void
+report(const char* name, const double seconds, const double size,
+       const float gap) {
+  printf("%-24s %12.3f %12.1f %12.2e\n", name, seconds * 1e3, size / seconds,
+         gap);
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS si toutes les matrices chargées sont identiques,
+ *   sinon @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  char sparse[32], dense[32], cache[32], twice[32], order[32];
+  double start;
+  int identical = 1;
+
+  // Matrice creuse : un élément par tranche de ROWS / PER colonnes.
+  FILE* file = temporary(sparse);
+  fprintf(file, "%%%%MatrixMarket matrix coordinate real general\n");
+  fprintf(file, "%% Matrice aléatoire.\n");
+  fprintf(file, "%u %u %u\n", ROWS, ROWS, ROWS * PER);
+  for (unsigned i = 0; i != ROWS; i ++) {
+    for (unsigned k = 0; k != PER; k ++) {
+      const unsigned j = k * (ROWS / PER) + rand() % (ROWS / PER);
+      fprintf(file, "%u %u %.7e\n", i + 1, j + 1,
+              2.0 * rand() / RAND_MAX - 1.0);
+    }
+  }
+  fclose(file);
+
+  printf("%-24s %12s %12s %12s\n", "chargement", "durée (ms)", "Mo/s", "ecart");
+
+  const double size = megabytes(sparse);
+  start = omp_get_wtime();
+  csr_t* ref = reference(sparse);
+  report("creuse fscanf", omp_get_wtime() - start, size, 0.0f);
+
+  const int max = omp_get_max_threads();
+  omp_set_num_threads(1);
+  start = omp_get_wtime();
+  csr_t* C = mtx_load_csr(sparse);
+  const double single = omp_get_wtime() - start;
+  float gap = compare(ref, C);
+  report("creuse mtx 1 thread", single, size, gap);
+  identical = identical && gap == 0.0f;
+  csr_free(C);
+
+  omp_set_num_threads(max);
+  start = omp_get_wtime();
+  C = mtx_load_csr(sparse);
+  const double all = omp_get_wtime() - start;
+  gap = compare(ref, C);
+  report("creuse mtx tous threads", all, size, gap);
+  identical = identical && gap == 0.0f;
+
+  close(mkstemp(strcpy(cache, "/tmp/bench_mtx_XXXXXX")));
+  mtx_save_csr(C, cache);
+  csr_free(C);
+  start = omp_get_wtime();
+  C = mtx_load_csr(cache);
+  const double cached = omp_get_wtime() - start;
+  gap = compare(ref, C);
+  report("creuse cache", cached, megabytes(cache), gap);
+  identical = identical && gap == 0.0f;
+  csr_free(C);
+  csr_free(ref);
+
+  // Matrice dense, stockée colonne par colonne.
+  float* A = (float*) malloc(sizeof(float) * SIZE * SIZE);
+  file = temporary(dense);
+  fprintf(file, "%%%%MatrixMarket matrix array real general\n");
+  fprintf(file, "%u %u\n", SIZE, SIZE);
+  for (unsigned j = 0; j != SIZE; j ++) {
+    for (unsigned i = 0; i != SIZE; i ++) {
+      A[i * SIZE + j] = 2.0f * rand() / RAND_MAX - 1.0f;
+      fprintf(file, "%.9g\n", A[i * SIZE + j]);
+    }
+  }
+  fclose(file);
+
+  unsigned rows, cols;
+  start = omp_get_wtime();
+  float* D = mtx_load_dense(dense, &rows, &cols);
+  const double text = omp_get_wtime() - start;
+  identical = identical && D != NULL
+    && memcmp(A, D, sizeof(float) * SIZE * SIZE) == 0;
+  report("dense mtx tous threads", text, megabytes(dense),
+         identical ? 0.0f : INFINITY);
+
+  mtx_save_dense(D, rows, cols, cache);
+  free(D);
+  start = omp_get_wtime();
+  D = mtx_load_dense(cache, &rows, &cols);
+  const double binary = omp_get_wtime() - start;
+  identical = identical && D != NULL
+    && memcmp(A, D, sizeof(float) * SIZE * SIZE) == 0;
+  report("dense cache", binary, megabytes(cache),
+         identical ? 0.0f : INFINITY);
+  free(D);
+  free(A);
+
+  // Doublons : (2, 1) et son symétrique (1, 2) sont tous deux présents, et
+  // (3, 3) figure deux fois.
+  file = temporary(twice);
+  fprintf(file, "%%%%MatrixMarket matrix coordinate real symmetric\n");
+  fprintf(file, "4 4 6\n1 1 1.0\n2 1 2.0\n1 2 3.0\n3 3 0.5\n3 3 0.25\n"
+          "4 2 -1.0\n");
+  fclose(file);
+  static const float expected[4 * 4] = {
+    1.0f, 5.0f, 0.0f,  0.0f,
+    5.0f, 0.0f, 0.0f, -1.0f,
+    0.0f, 0.0f, 0.75f, 0.0f,
+    0.0f, -1.0f, 0.0f, 0.0f
+  };
+  C = mtx_load_csr(twice);
+  D = mtx_load_dense(twice, &rows, &cols);
+  float* E = (float*) malloc(sizeof(float) * 4 * 4);
+  int merged = C != NULL && D != NULL && C->nnz == 6 && rows == 4 && cols == 4;
+  if (merged) {
+    csr_to_dense(C, E);
+    merged = memcmp(E, expected, sizeof(expected)) == 0
+      && memcmp(D, expected, sizeof(expected)) == 0;
+  }
+  printf("%-24s %12s\n", "doublons", merged ? "additionnés" : "ERREUR");
+  identical = identical && merged;
+  csr_free(C);
+  free(D);
+  free(E);
+
+  // Somme des doublons indépendante de l'ordre de leur répartition : (1, 1)
+  // figure cinq fois, avec des valeurs dont la somme flottante dépend de
+  // l'ordre d'addition, parmi d'autres éléments de la même ligne.
+  file = temporary(order);
+  fprintf(file, "%%%%MatrixMarket matrix coordinate real general\n");
+  fprintf(file, "2 3 8\n1 1 1e8\n1 2 2.0\n1 1 1.0\n1 1 -1e8\n2 3 4.0\n"
+          "1 1 1.0\n1 3 3.0\n1 1 0.5\n");
+  fclose(file);
+  static const int teams[] = { 1, 2, 3, 4, 8 };
+  float first[2] = { 0.0f, 0.0f };
+  int stable = 1;
+  for (unsigned t = 0; t != sizeof(teams) / sizeof(int); t ++) {
+    omp_set_num_threads(teams[t]);
+    for (unsigned r = 0; r != 40; r ++) {
+      C = mtx_load_csr(order);
+      D = mtx_load_dense(order, &rows, &cols);
+      if (C == NULL || D == NULL || C->nnz != 4 || C->col[0] != 0) {
+        stable = 0;
+      } else if (t == 0 && r == 0) {
+        first[0] = C->val[0];
+        first[1] = D[0];
+      } else {
+        stable = stable && memcmp(&C->val[0], &first[0], sizeof(float)) == 0
+          && memcmp(&D[0], &first[1], sizeof(float)) == 0;
+      }
+      csr_free(C);
+      free(D);
+    }
+  }
+  omp_set_num_threads(max);
+  printf("%-24s %12s\n", "ordre des doublons",
+         stable ? "indifférent" : "ERREUR");
+  identical = identical && stable;
+
+  unlink(sparse);
+  unlink(dense);
+  unlink(cache);
+  unlink(twice);
+  unlink(order);
+
+  return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,170 @@
+/**
+ * Programme de benchmarking du noyau "matrix powers".
+ *
+ * Pour le laplacien 2D à 5 points sur une grille NX x NY (numérotation
+ * naturelle, d'où une largeur de bande NX) et plusieurs puissances k, le
+ * programme compare k appels successifs de @c csr_matvec à @c powers_csr,
+ * en affichant la durée de l'analyse, la redondance des tuiles, les durées
+ * des deux calculs, l'accélération et l'écart maximal entre les résultats.
+ * Il compare ensuite de même k appels de @c matvec_sse_r4 à
+ * @c powers_dense sur une matrice dense.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "csr.h"
+#include "matvec_sse_r4.h"
+#include "powers.h"
+
+#define NX     256 // Largeur de la grille du laplacien.
+#define NY   24000 // Hauteur de la grille du laplacien.
+#define SIZE  8192 // Longueur des vecteurs du cas dense.
+#define TILE  8192 // Nombre de lignes par tuile.
+#define ITERS    5 // Nombre de répétitions de chaque calcul.
+
+/*
+ * Laplacien 2D à 5 points, numérotation naturelle.
+ */
+static csr_t*
+laplacian() {
+
+  const unsigned n = NX * NY;
+  csr_t* C = csr_create(n, n, 5 * (size_t) n - 2 * (NX + NY));
+  size_t nnz = 0;
+  for (unsigned y = 0; y != NY; y ++) {
+    for (unsigned x = 0; x != NX; x ++) {
+      const unsigned k = y * NX + x;
+      if (y != 0) {
+        C->col[nnz] = k - NX;
+        C->val[nnz ++] = -0.25f;
+      }
+      if (x != 0) {
+        C->col[nnz] = k - 1;
+        C->val[nnz ++] = -0.25f;
+      }
+      C->col[nnz] = k;
+      C->val[nnz ++] = 1.0f;
+      if (x != NX - 1) {
+        C->col[nnz] = k + 1;
+        C->val[nnz ++] = -0.25f;
+      }
+      if (y != NY - 1) {
+        C->col[nnz] = k + NX;
+        C->val[nnz ++] = -0.25f;
+      }
+      C->ptr[k + 1] = nnz;
+    }
+  }
+  return C;
+
+}
+
+/*
+ * Écart maximal entre deux ensembles de vecteurs.
+ */
+static float
+gap(const float U[], const float V[], const size_t len) {
+  float g = 0.0f;
+  for (size_t i = 0; i != len; i ++) {
+    g = fmaxf(g, fabsf(U[i] - V[i]));
+  }
+  return g;
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  static const unsigned ks[] = { 2, 4 };
+
+  csr_t* C = laplacian();
+  const size_t n = C->rows;
+  float* x = (float*) aligned_alloc(16, sizeof(float) * (n > SIZE ? n : SIZE));
+  float* U = (float*) aligned_alloc(16, sizeof(float) * n * 4);
+  float* V = (float*) aligned_alloc(16, sizeof(float) * n * 4);
+  for (size_t i = 0; i != n; i ++) {
+    x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  printf("%-6s %3s %12s %10s %14s %14s %9s %10s\n", "format", "k",
+         "analyse (ms)", "redondance", "k x prod (ms)", "powers (ms)",
+         "speedup", "ecart max");
+
+  for (unsigned s = 0; s != sizeof(ks) / sizeof(unsigned); s ++) {
+
+    const unsigned k = ks[s];
+
+    double start = omp_get_wtime();
+    powers_t* P = powers_create(C, k, TILE);
+    const double analysis = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      csr_matvec(C, x, U);
+      for (unsigned j = 1; j != k; j ++) {
+        csr_matvec(C, U + (j - 1) * n, U + j * n);
+      }
+    }
+    const double repeated = (omp_get_wtime() - start) / ITERS;
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      powers_csr(P, C, x, V);
+    }
+    const double powers = (omp_get_wtime() - start) / ITERS;
+
+    printf("%-6s %3u %12.3f %10.3f %14.3f %14.3f %9.2f %10.2e\n", "csr", k,
+           analysis * 1e3, P->redundancy, repeated * 1e3, powers * 1e3,
+           repeated / powers, gap(U, V, n * k));
+
+    powers_free(P);
+
+  }
+
+  // Cas dense.
+  float* A = (float*) aligned_alloc(16, sizeof(float) * SIZE * SIZE);
+  for (size_t i = 0; i != (size_t) SIZE * SIZE; i ++) {
+    A[i] = (2.0f * rand() / RAND_MAX - 1.0f) / SIZE;
+  }
+
+  for (unsigned s = 0; s != sizeof(ks) / sizeof(unsigned); s ++) {
+
+    const unsigned k = ks[s];
+
+    double start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      matvec_sse_r4(A, x, U, SIZE);
+      for (unsigned j = 1; j != k; j ++) {
+        matvec_sse_r4(A, U + (j - 1) * SIZE, U + j * SIZE, SIZE);
+      }
+    }
+    const double repeated = (omp_get_wtime() - start) / ITERS;
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      powers_dense(A, x, V, SIZE, k);
+    }
+    const double powers = (omp_get_wtime() - start) / ITERS;
+
+    printf("%-6s %3u %12s %10s %14.3f %14.3f %9.2f %10.2e\n", "dense", k,
+           "-", "-", repeated * 1e3, powers * 1e3, repeated / powers,
+           gap(U, V, (size_t) SIZE * k));
+
+  }
+
+  csr_free(C);
+  free(A);
+  free(x);
+  free(U);
+  free(V);
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,105 @@
+/**
+ * Programme de benchmarking du raffinement itératif en précision mixte.
+ *
+ * Pour une matrice aléatoire et une matrice plus mal conditionnée (dont les
+ * lignes sont mises à des échelles très différentes), le système Ax = b est
+ * résolu, d'une part entièrement en double précision, d'autre part par
+ * raffinement itératif. Le programme affiche les durées de résolution, le
+ * nombre de corrections, l'erreur inverse atteinte et l'erreur relative par
+ * rapport à la solution exacte.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "refine.h"
+
+#define SIZE  1024 // Longueur de nos vecteurs.
+#define ITERS   30 // Nombre maximal de corrections.
+
+/**
+ * Erreur relative en norme infinie.
+ *
+ * @param[in] x la solution calculée.
+ * @param[in] y la solution exacte.
+ * @return ||x - y|| / ||y||.
+ */
+static double
+forward(const double x[], const double y[]) {
+
+  double num = 0.0, den = 0.0;
+  for (unsigned i = 0; i != SIZE; i ++) {
+    num = fmax(num, fabs(x[i] - y[i]));
+    den = fmax(den, fabs(y[i]));
+  }
+  return num / den;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS si toutes les résolutions ont abouti, sinon
+ *   @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  static const char* names[] = { "aleatoire", "echelles" };
+
+  double* A = (double*) malloc(sizeof(double) * SIZE * SIZE);
+  double* b = (double*) malloc(sizeof(double) * SIZE);
+  double* x = (double*) malloc(sizeof(double) * SIZE);
+  double* y = (double*) malloc(sizeof(double) * SIZE);
+
+  printf("%-10s %-8s %10s %9s %11s %12s %12s\n", "matrice", "solveur",
+         "durée (s)", "speedup", "corrections", "err. inverse",
+         "err. relat.");
+
+  int ok = 1;
+  for (unsigned m = 0; m != sizeof(names) / sizeof(char*); m ++) {
+
+    // Lignes d'échelles comprises entre 1 et 1e4 pour la seconde matrice.
+    for (unsigned i = 0; i != SIZE; i ++) {
+      const double scale = m == 0 ? 1.0 : pow(10.0, 4.0 * rand() / RAND_MAX);
+      for (unsigned k = 0; k != SIZE; k ++) {
+        A[i * SIZE + k] = scale * (2.0 * rand() / RAND_MAX - 1.0);
+      }
+    }
+    for (unsigned i = 0; i != SIZE; i ++) {
+      y[i] = 2.0 * rand() / RAND_MAX - 1.0;
+    }
+    for (unsigned i = 0; i != SIZE; i ++) {
+      long double sum = 0.0L;
+      for (unsigned k = 0; k != SIZE; k ++) {
+        sum += (long double) A[i * SIZE + k] * y[k];
+      }
+      b[i] = (double) sum;
+    }
+
+    refine_stats_t stats;
+    double start = omp_get_wtime();
+    ok = ok && refine_direct(A, b, x, SIZE, &stats) == 0;
+    const double direct = omp_get_wtime() - start;
+    printf("%-10s %-8s %10.3f %9.2f %11s %12.2e %12.2e\n", names[m],
+           "double", direct, 1.0, "-", stats.error, forward(x, y));
+
+    start = omp_get_wtime();
+    ok = ok && refine_solve(A, b, x, SIZE, ITERS, &stats) == 0;
+    const double mixed = omp_get_wtime() - start;
+    printf("%-10s %-8s %10.3f %9.2f %11u %12.2e %12.2e%s\n", names[m],
+           "mixte", mixed, direct / mixed, stats.iterations, stats.error,
+           forward(x, y), stats.fallback ? " (repli double)" : "");
+
+  }
+
+  free(A);
+  free(b);
+  free(x);
+  free(y);
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
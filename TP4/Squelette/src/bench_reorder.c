@@ -0,0 +1,183 @@
+/**
+ * Programme de benchmarking de la renumérotation des matrices creuses.
+ *
+ * La matrice est lue dans le fichier Matrix Market passé en argument ou, à
+ * défaut, est celle du laplacien 2D à 5 points sur une grille GRID x GRID,
+ * dont les sommets sont numérotés aléatoirement. Pour la numérotation
+ * d'origine puis pour chaque méthode de renumérotation, le programme affiche
+ * la durée de calcul de la permutation, la largeur de bande et le profil de
+ * la matrice, la durée d'un produit @c csr_matvec et l'accélération obtenue,
+ * ainsi que l'écart maximal au produit d'origine (une fois le résultat remis
+ * dans la numérotation d'origine).
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "csr.h"
+#include "mtx.h"
+#include "reorder.h"
+
+#define GRID   700 // Côté de la grille du laplacien.
+#define ITERS   50 // Nombre de répétitions de chaque produit.
+
+/**
+ * Construction du laplacien 2D à numérotation aléatoire.
+ *
+ * @return la matrice.
+ */
+static csr_t*
+laplacian() {
+
+  const unsigned n = GRID * GRID;
+
+  // Numéro aléatoire de chaque sommet de la grille (mélange de Fisher-Yates).
+  unsigned* id = (unsigned*) malloc(sizeof(unsigned) * n);
+  for (unsigned k = 0; k != n; k ++) {
+    id[k] = k;
+  }
+  for (unsigned k = n - 1; k != 0; k --) {
+    const unsigned r = (unsigned) (((double) rand() / RAND_MAX) * k);
+    const unsigned t = id[k];
+    id[k] = id[r];
+    id[r] = t;
+  }
+
+  // Construction dans la numérotation de la grille, puis renumérotation.
+  csr_t* G = csr_create(n, n, 5 * (size_t) n - 4 * GRID);
+  size_t nnz = 0;
+  for (unsigned y = 0; y != GRID; y ++) {
+    for (unsigned x = 0; x != GRID; x ++) {
+      const unsigned k = y * GRID + x;
+      if (y != 0) {
+        G->col[nnz] = k - GRID;
+        G->val[nnz ++] = -1.0f;
+      }
+      if (x != 0) {
+        G->col[nnz] = k - 1;
+        G->val[nnz ++] = -1.0f;
+      }
+      G->col[nnz] = k;
+      G->val[nnz ++] = 4.0f;
+      if (x != GRID - 1) {
+        G->col[nnz] = k + 1;
+        G->val[nnz ++] = -1.0f;
+      }
+      if (y != GRID - 1) {
+        G->col[nnz] = k + GRID;
+        G->val[nnz ++] = -1.0f;
+      }
+      G->ptr[k + 1] = nnz;
+    }
+  }
+
+  // La nouvelle ligne id[k] est l'ancienne ligne k.
+  unsigned* perm = (unsigned*) malloc(sizeof(unsigned) * n);
+  for (unsigned k = 0; k != n; k ++) {
+    perm[id[k]] = k;
+  }
+  csr_t* C = reorder_apply(G, perm);
+
+  free(id);
+  free(perm);
+  csr_free(G);
+  return C;
+
+}
+
+/**
+ * Durée moyenne d'un produit.
+ *
+ * @param[in]  C la matrice.
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @return la durée (en secondes).
+ */
+static double
+timing(const csr_t* C, const float x[], float b[]) {
+
+  const double start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    csr_matvec(C, x, b);
+  }
+  return (omp_get_wtime() - start) / ITERS;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments.
+ * @param[in] argv les arguments : éventuellement un fichier Matrix Market.
+ * @return @c EXIT_SUCCESS, ou @c EXIT_FAILURE si la matrice n'a pu être lue
+ *   ou n'est pas carrée.
+ */
+int
+main(int argc, char* argv[]) {
+
+  static const char* names[] = { "rcm", "degres", "longueurs" };
+  static const reorder_method_t methods[] = {
+    REORDER_RCM, REORDER_DEGREE, REORDER_ROWS
+  };
+
+  csr_t* C = argc > 1 ? mtx_load_csr(argv[1]) : laplacian();
+  if (C == NULL || C->rows != C->cols) {
+    fprintf(stderr, "matrice illisible ou non carrée\n");
+    return EXIT_FAILURE;
+  }
+  const unsigned n = C->rows;
+  printf("%u lignes, %zu éléments non nuls\n\n", n, C->nnz);
+
+  float* x = (float*) malloc(sizeof(float) * n);
+  float* y = (float*) malloc(sizeof(float) * n);
+  float* b = (float*) malloc(sizeof(float) * n);
+  float* c = (float*) malloc(sizeof(float) * n);
+  float* d = (float*) malloc(sizeof(float) * n);
+  for (unsigned i = 0; i != n; i ++) {
+    x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  printf("%-10s %10s %12s %16s %12s %9s %10s\n", "ordre", "calcul (s)",
+         "bande", "profil", "produit (ms)", "speedup", "ecart max");
+  const double base = timing(C, x, b);
+  printf("%-10s %10s %12zu %16zu %12.3f %9.2f %10.2e\n", "origine", "-",
+         reorder_bandwidth(C), reorder_profile(C), base * 1e3, 1.0, 0.0);
+
+  for (unsigned m = 0; m != sizeof(methods) / sizeof(reorder_method_t); m ++) {
+
+    double start = omp_get_wtime();
+    unsigned* perm = reorder_compute(C, methods[m]);
+    const double compute = omp_get_wtime() - start;
+
+    // Permutation unique de la matrice et du vecteur source.
+    csr_t* P = reorder_apply(C, perm);
+    reorder_gather(perm, x, y, n);
+    const double time = timing(P, y, c);
+    reorder_scatter(perm, c, d, n);
+
+    float gap = 0.0f;
+    for (unsigned i = 0; i != n; i ++) {
+      gap = fmaxf(gap, fabsf(b[i] - d[i]));
+    }
+
+    printf("%-10s %10.3f %12zu %16zu %12.3f %9.2f %10.2e\n", names[m],
+           compute, reorder_bandwidth(P), reorder_profile(P), time * 1e3,
+           base / time, gap);
+
+    csr_free(P);
+    free(perm);
+
+  }
+
+  csr_free(C);
+  free(x);
+  free(y);
+  free(b);
+  free(c);
+  free(d);
+
+  return EXIT_SUCCESS;
+
+}
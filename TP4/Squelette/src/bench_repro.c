@@ -0,0 +1,96 @@
+/**
+ * Programme de benchmarking du produit matrice-vecteur reproductible.
+ *
+ * Le programme mesure la durée de @c matvec_repro pour différents nombres de
+ * threads et la compare à celle de @c matvec_sse_r4. Il vérifie en outre que
+ * les résultats obtenus sont identiques bit à bit quel que soit le nombre de
+ * threads, et identiques à ceux de la version scalaire @c matvec_repro_ref.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+#include "matvec_sse_r4.h"
+#include "matvec_repro.h"
+
+#define SIZE  2048 // Longueur de nos vecteurs.
+#define ITERS   20 // Nombre de répétitions de chaque produit.
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS si tous les résultats reproductibles sont
+ *   identiques, sinon @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  float* A = (float*) aligned_alloc(16, sizeof(float) * SIZE * SIZE);
+  float* x = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* b = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* ref = (float*) malloc(sizeof(float) * SIZE);
+
+  // Valeurs d'ordres de grandeur variés, afin que l'ordre de sommation
+  // influe sur les arrondis.
+  for (unsigned i = 0; i != SIZE * SIZE; i ++) {
+    A[i] = (2.0f * rand() / RAND_MAX - 1.0f) * (float) (1 + rand() % 1000);
+  }
+  for (unsigned i = 0; i != SIZE; i ++) {
+    x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  matvec_repro_ref(A, x, ref, SIZE);
+
+  // Référence de performance.
+  double start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    matvec_sse_r4(A, x, b, SIZE);
+  }
+  const double sse = (omp_get_wtime() - start) / ITERS;
+  const int differs = memcmp(b, ref, sizeof(float) * SIZE) != 0;
+
+  printf("%-16s %8s %12s %10s %10s\n",
+         "noyau", "threads", "durée (ms)", "surcoût", "identique");
+  printf("%-16s %8d %12.3f %10.2f %10s\n",
+         "matvec_sse_r4", 1, sse * 1e3, 1.0, differs ? "non" : "oui");
+
+  int identical = 1;
+  const int max = omp_get_max_threads();
+  for (int threads = 1; ; threads *= 2) {
+
+    // Puissances de 2 successives, puis le maximum disponible.
+    if (threads > max) {
+      threads = max;
+    }
+    omp_set_num_threads(threads);
+    memset(b, 0, sizeof(float) * SIZE);
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      matvec_repro(A, x, b, SIZE);
+    }
+    const double repro = (omp_get_wtime() - start) / ITERS;
+
+    const int same = memcmp(b, ref, sizeof(float) * SIZE) == 0;
+    identical = identical && same;
+
+    printf("%-16s %8d %12.3f %10.2f %10s\n",
+           "matvec_repro", threads, repro * 1e3, repro / sse,
+           same ? "oui" : "non");
+
+    if (threads == max) {
+      break;
+    }
+
+  }
+
+  free(A);
+  free(x);
+  free(b);
+  free(ref);
+
+  return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,171 @@
+/**
+ * Programme de benchmarking du serveur de produits matrice-vecteur.
+ *
+ * CLIENTS threads effectuent chacun REQUESTS produits sur une même matrice,
+ * d'une part en appelant directement @c matvec_sse_r4, d'autre part au
+ * travers d'un serveur @c matvec_server pour différentes tailles de lots. Le
+ * programme affiche le débit global obtenu (en produits par seconde), la
+ * latence moyenne et maximale d'un produit, la taille moyenne des lots et
+ * l'écart maximal aux résultats directs.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <pthread.h>
+#include <omp.h>
+
+#include "matvec_sse_r4.h"
+#include "matvec_server.h"
+
+#define SIZE     2048 // Longueur de nos vecteurs.
+#define CLIENTS    16 // Nombre de threads clients.
+#define REQUESTS   20 // Nombre de produits par client.
+#define TIMEOUT  1e-4 // Délai d'attente maximal d'une requête (en secondes).
+
+/**
+ * Paramètres et mesures d'un client.
+ */
+typedef struct {
+  const float* A;          // La matrice.
+  matvec_server_t* S;      // Le serveur (NULL : appels directs).
+  const float* x;          // Le vecteur source du client.
+  float* b;                // Le vecteur cible du client.
+  double latency;          // Latence cumulée.
+  double worst;            // Latence maximale.
+} client_t;
+
+/**
+ * Corps d'un thread client.
+ *
+ * @param[in] arg le client.
+ * @return @c NULL.
+ */
+static void*
+client(void* arg) {
+
+  client_t* c = (client_t*) arg;
+  c->latency = c->worst = 0.0;
+
+  for (unsigned r = 0; r != REQUESTS; r ++) {
+    const double start = omp_get_wtime();
+    if (c->S == NULL) {
+      matvec_sse_r4(c->A, c->x, c->b, SIZE);
+    } else {
+      matvec_server_matvec(c->S, c->x, c->b);
+    }
+    const double elapsed = omp_get_wtime() - start;
+    c->latency += elapsed;
+    c->worst = elapsed > c->worst ? elapsed : c->worst;
+  }
+
+  return NULL;
+
+}
+
+/**
+ * Exécution de tous les clients, puis affichage des mesures.
+ *
+ * @param[in] name le nom de la configuration.
+ * @param[in] clients les clients.
+ * @param[in] S le serveur (NULL : appels directs).
+ * @param[in] ref les résultats de référence (NULL : aucune comparaison).
+ */
+static void
+run(const char* name, client_t clients[], matvec_server_t* S,
+    float* const ref[]) {
+
+  pthread_t threads[CLIENTS];
+
+  const double start = omp_get_wtime();
+  for (unsigned t = 0; t != CLIENTS; t ++) {
+    clients[t].S = S;
+    pthread_create(threads + t, NULL, client, clients + t);
+  }
+  for (unsigned t = 0; t != CLIENTS; t ++) {
+    pthread_join(threads[t], NULL);
+  }
+  const double total = omp_get_wtime() - start;
+
+  double latency = 0.0, worst = 0.0;
+  float gap = 0.0f;
+  for (unsigned t = 0; t != CLIENTS; t ++) {
+    latency += clients[t].latency;
+    worst = clients[t].worst > worst ? clients[t].worst : worst;
+    for (unsigned i = 0; ref != NULL && i != SIZE; i ++) {
+      gap = fmaxf(gap, fabsf(clients[t].b[i] - ref[t][i]));
+    }
+  }
+
+  double batch = 1.0;
+  if (S != NULL) {
+    unsigned long batches, requests;
+    matvec_server_stats(S, &batches, &requests);
+    batch = (double) requests / batches;
+  }
+
+  printf("%-10s %14.0f %14.1f %14.1f %8.2f %10.2e\n",
+         name, CLIENTS * REQUESTS / total,
+         latency / (CLIENTS * REQUESTS) * 1e6, worst * 1e6, batch, gap);
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS si tous les serveurs ont pu être créés, sinon
+ *   @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  static const unsigned batches[] = { 1, 4, 8, 16 };
+  int status = EXIT_SUCCESS;
+
+  float* A = (float*) aligned_alloc(16, sizeof(float) * SIZE * SIZE);
+  for (unsigned i = 0; i != SIZE * SIZE; i ++) {
+    A[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  client_t clients[CLIENTS];
+  float* ref[CLIENTS];
+  for (unsigned t = 0; t != CLIENTS; t ++) {
+    float* x = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+    for (unsigned i = 0; i != SIZE; i ++) {
+      x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+    }
+    clients[t].A = A;
+    clients[t].x = x;
+    clients[t].b = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+    ref[t] = (float*) malloc(sizeof(float) * SIZE);
+    matvec_sse_r4(A, x, ref[t], SIZE);
+  }
+
+  printf("%-10s %14s %14s %14s %8s %10s\n", "mode", "produits/s",
+         "latence (us)", "max (us)", "lot", "ecart max");
+
+  run("direct", clients, NULL, NULL);
+
+  for (unsigned t = 0; t != sizeof(batches) / sizeof(unsigned); t ++) {
+    char name[16];
+    snprintf(name, sizeof(name), "lot %u", batches[t]);
+    matvec_server_t* S = matvec_server_create(A, SIZE, batches[t], TIMEOUT);
+    if (S == NULL) {
+      printf("%-10s %14s\n", name, "ERREUR");
+      status = EXIT_FAILURE;
+      continue;
+    }
+    run(name, clients, S, ref);
+    matvec_server_free(S);
+  }
+
+  for (unsigned t = 0; t != CLIENTS; t ++) {
+    free((float*) clients[t].x);
+    free(clients[t].b);
+    free(ref[t]);
+  }
+  free(A);
+
+  return status;
+
+}
@@ -0,0 +1,144 @@
+/**
+ * Programme de benchmarking des mises à jour de rang 1 et de rang k.
+ *
+ * Le programme compare :
+ *  - la double boucle scalaire A[i][j] += alpha * u[i] * v[j] à @c sger ;
+ *  - K appels successifs de @c sger à un appel de @c sger_k ;
+ *  - @c sger suivi de @c matvec_sse_r4 à @c sger_matvec.
+ * Pour chaque cas, il affiche les durées, l'accélération et l'écart maximal
+ * entre les matrices (ou vecteurs) obtenues.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+
+#include "matvec_sse_r4.h"
+#include "sger.h"
+
+#define SIZE  4096 // Longueur de nos vecteurs.
+#define K        8 // Rang de la mise à jour de rang k.
+#define ITERS   10 // Nombre de répétitions de chaque calcul.
+
+/*
+ * Écart maximal entre deux tableaux.
+ */
+static float
+gap(const float a[], const float b[], const size_t len) {
+  float g = 0.0f;
+  for (size_t i = 0; i != len; i ++) {
+    g = fmaxf(g, fabsf(a[i] - b[i]));
+  }
+  return g;
+}
+
+/*
+ * Affichage d'une ligne de résultats.
+ */
+static void
+report(const char* name, const double before, const double after,
+       const float g) {
+  printf("%-24s %14.3f %14.3f %9.2f %10.2e\n", name, before * 1e3,
+         after * 1e3, before / after, g);
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  const size_t elems = (size_t) SIZE * SIZE;
+  float* A = (float*) aligned_alloc(16, sizeof(float) * elems);
+  float* B = (float*) aligned_alloc(16, sizeof(float) * elems);
+  float* U = (float*) aligned_alloc(16, sizeof(float) * SIZE * K);
+  float* Vt = (float*) aligned_alloc(16, sizeof(float) * SIZE * K);
+  float* x = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* b = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  float* c = (float*) aligned_alloc(16, sizeof(float) * SIZE);
+  for (size_t i = 0; i != elems; i ++) {
+    A[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+  memcpy(B, A, sizeof(float) * elems);
+  for (unsigned i = 0; i != SIZE * K; i ++) {
+    U[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+    Vt[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+  for (unsigned i = 0; i != SIZE; i ++) {
+    x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  // Colonne t de U, utilisée comme vecteur u des mises à jour de rang 1.
+  float* u = (float*) malloc(sizeof(float) * SIZE * K);
+  for (unsigned i = 0; i != SIZE; i ++) {
+    for (unsigned t = 0; t != K; t ++) {
+      u[(size_t) t * SIZE + i] = U[(size_t) i * K + t];
+    }
+  }
+  const float alpha = 1e-3f;
+
+  printf("%-24s %14s %14s %9s %10s\n", "cas", "avant (ms)", "après (ms)",
+         "speedup", "ecart max");
+
+  // Double boucle scalaire contre sger.
+  double start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    for (unsigned i = 0; i != SIZE; i ++) {
+      for (unsigned j = 0; j != SIZE; j ++) {
+        A[(size_t) i * SIZE + j] += alpha * u[i] * Vt[j];
+      }
+    }
+  }
+  const double naive = (omp_get_wtime() - start) / ITERS;
+  start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    sger(B, SIZE, alpha, u, Vt);
+  }
+  const double simd = (omp_get_wtime() - start) / ITERS;
+  report("boucle / sger", naive, simd, gap(A, B, elems));
+
+  // K mises à jour de rang 1 contre une mise à jour de rang K.
+  start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    for (unsigned t = 0; t != K; t ++) {
+      sger(A, SIZE, alpha, u + (size_t) t * SIZE, Vt + (size_t) t * SIZE);
+    }
+  }
+  const double repeated = (omp_get_wtime() - start) / ITERS;
+  start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    sger_k(B, SIZE, alpha, U, Vt, K);
+  }
+  const double blocked = (omp_get_wtime() - start) / ITERS;
+  report("K x sger / sger_k", repeated, blocked, gap(A, B, elems));
+
+  // Mise à jour puis produit, séparés contre fusionnés.
+  start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    sger(A, SIZE, alpha, u, Vt);
+    matvec_sse_r4(A, x, b, SIZE);
+  }
+  const double separate = (omp_get_wtime() - start) / ITERS;
+  start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    sger_matvec(B, SIZE, alpha, u, Vt, x, c);
+  }
+  const double fused = (omp_get_wtime() - start) / ITERS;
+  report("sger + matvec / fusion", separate, fused, gap(b, c, SIZE));
+
+  free(A);
+  free(B);
+  free(U);
+  free(Vt);
+  free(u);
+  free(x);
+  free(b);
+  free(c);
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,222 @@
+/**
+ * Programme de benchmarking de la sélection automatique du format creux.
+ *
+ * Le programme construit des matrices de structures variées (aléatoire
+ * uniforme, bande, éléments finis à blocs 4 x 4, lignes de longueurs très
+ * irrégulières, petite matrice presque pleine). Pour chacune, il affiche ses
+ * caractéristiques, la durée prédite d'un produit dans chaque format, le
+ * format retenu par @c spformat_create, puis la durée mesurée dans chaque
+ * format, afin de valider le choix. L'écart maximal au résultat de
+ * @c csr_matvec est également affiché.
+ *
+ * Avec l'option @c -c, le modèle de coût est calibré sur la machine
+ * courante au lieu d'utiliser le modèle par défaut.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+
+#include "csr.h"
+#include "spformat.h"
+
+#define ROWS  (1u << 17) // Nombre de lignes des grandes matrices.
+#define GRID        180  // Nombre de nœuds par côté de la grille.
+#define ITERS        10  // Nombre de répétitions de chaque produit.
+
+/*
+ * Matrice dont chaque ligne comporte len(i) éléments non nuls, à colonnes
+ * croissantes réparties dans une fenêtre de reach colonnes centrée sur la
+ * diagonale (tronquée aux bords).
+ */
+static csr_t*
+generate(const unsigned rows, const unsigned cols, const unsigned reach,
+         unsigned (*len)(unsigned)) {
+
+  size_t nnz = 0;
+  for (unsigned i = 0; i != rows; i ++) {
+    nnz += len(i);
+  }
+  csr_t* C = csr_create(rows, cols, nnz);
+
+  size_t k = 0;
+  for (unsigned i = 0; i != rows; i ++) {
+    const unsigned long centre = (unsigned long) i * cols / rows;
+    const unsigned lo = centre > reach / 2 ? centre - reach / 2 : 0;
+    const unsigned hi = lo + reach < cols ? lo + reach : cols;
+    const unsigned n = len(i) < hi - lo ? len(i) : hi - lo;
+    // Une colonne tirée dans chacun des n segments de [lo, hi).
+    const unsigned width = (hi - lo) / n;
+    for (unsigned t = 0; t != n; t ++) {
+      C->col[k] = lo + t * width + rand() % width;
+      C->val[k ++] = 2.0f * rand() / RAND_MAX - 1.0f;
+    }
+    C->ptr[i + 1] = k;
+  }
+  C->nnz = k;
+
+  return C;
+
+}
+
+/*
+ * Longueurs de lignes des différentes matrices.
+ */
+static unsigned
+regular(unsigned i) {
+  (void) i;
+  return 16;
+}
+
+static unsigned
+skewed(unsigned i) {
+  // Une ligne sur 64 est 40 fois plus longue que les autres.
+  return i % 64 == 0 ? 400 : 4 + i % 7;
+}
+
+static unsigned
+full(unsigned i) {
+  (void) i;
+  return 1600;
+}
+
+/*
+ * Matrice d'une grille GRID x GRID de nœuds à dof inconnues, couplées à
+ * celles du nœud et de ses 8 voisins.
+ */
+static csr_t*
+fem(const unsigned dof) {
+
+  const unsigned nodes = GRID * GRID;
+  csr_t* C = csr_create(nodes * dof, nodes * dof, (size_t) nodes * 9 * dof * dof);
+
+  size_t k = 0;
+  for (unsigned n = 0; n != nodes; n ++) {
+    const int y = n / GRID, x = n % GRID;
+    for (unsigned d = 0; d != dof; d ++) {
+      for (int dy = -1; dy <= 1; dy ++) {
+        for (int dx = -1; dx <= 1; dx ++) {
+          if (y + dy < 0 || y + dy >= GRID || x + dx < 0 || x + dx >= GRID) {
+            continue;
+          }
+          const unsigned m = (y + dy) * GRID + x + dx;
+          for (unsigned e = 0; e != dof; e ++) {
+            C->col[k] = m * dof + e;
+            C->val[k] = 2.0f * rand() / RAND_MAX - 1.0f;
+            k ++;
+          }
+        }
+      }
+      C->ptr[n * dof + d + 1] = k;
+    }
+  }
+  C->nnz = k;
+
+  return C;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments.
+ * @param[in] argv les arguments (@c -c : calibrage du modèle).
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main(int argc, char* argv[]) {
+
+  spformat_model_t model;
+  if (argc > 1 && strcmp(argv[1], "-c") == 0) {
+    const double start = omp_get_wtime();
+    spformat_calibrate(&model);
+    printf("calibrage : %.2f s\n", omp_get_wtime() - start);
+  } else {
+    spformat_default(&model);
+  }
+  printf("modèle (ns/élément) : dense %.2f, csr %.2f/%.2f, sell %.2f/%.2f,"
+         " bsr4 %.2f/%.2f\n\n", model.dense * 1e9,
+         model.csr[0] * 1e9, model.csr[1] * 1e9,
+         model.sell[0] * 1e9, model.sell[1] * 1e9,
+         model.bsr[0][4] * 1e9, model.bsr[1][4] * 1e9);
+
+  static const char* names[] = {
+    "aléatoire", "bande", "éléments finis", "irrégulière", "presque pleine"
+  };
+  const unsigned count = sizeof(names) / sizeof(names[0]);
+
+  for (unsigned m = 0; m != count; m ++) {
+
+    csr_t* C;
+    switch (m) {
+    case 0:  C = generate(ROWS, ROWS, ROWS, regular); break;
+    case 1:  C = generate(ROWS, ROWS, 64, regular); break;
+    case 2:  C = fem(4); break;
+    case 3:  C = generate(ROWS, ROWS, 4096, skewed); break;
+    default: C = generate(2048, 2048, 2048, full); break;
+    }
+
+    float* x = (float*) malloc(sizeof(float) * C->cols);
+    float* ref = (float*) malloc(sizeof(float) * C->rows);
+    float* b = (float*) malloc(sizeof(float) * C->rows);
+    for (unsigned i = 0; i != C->cols; i ++) {
+      x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+    }
+    csr_matvec(C, x, ref);
+
+    const double start = omp_get_wtime();
+    spformat_t* F = spformat_create(C, &model);
+    const double analysis = omp_get_wtime() - start;
+    const spformat_stats_t* S = &F->stats;
+
+    printf("%s : %u x %u, nnz %zu (%.2e), lignes %.1f +- %.1f (max %u),"
+           " bande %u, blocs %u (remplis. %.2f), sell %zu\n",
+           names[m], S->rows, S->cols, S->nnz, S->ratio, S->row_mean,
+           sqrt(S->row_var), S->row_max, S->bandwidth, S->bs, S->fill,
+           S->sell_stored);
+    printf("  format retenu : %s (analyse et conversion %.1f ms)\n",
+           spformat_name(F->kind), analysis * 1e3);
+    printf("  %-8s %14s %14s %10s\n", "format", "prédit (ms)", "mesuré (ms)",
+           "ecart max");
+
+    for (unsigned k = 0; k != SPFORMAT_KINDS; k ++) {
+
+      if (F->predicted[k] == HUGE_VAL) {
+        printf("  %-8s %14s\n", spformat_name((spformat_kind_t) k), "-");
+        continue;
+      }
+
+      spformat_t* G = spformat_convert(C, (spformat_kind_t) k);
+      spformat_matvec(G, x, b);
+      double t = omp_get_wtime();
+      for (unsigned r = 0; r != ITERS; r ++) {
+        spformat_matvec(G, x, b);
+      }
+      t = (omp_get_wtime() - t) / ITERS;
+
+      float gap = 0.0f;
+      for (unsigned i = 0; i != C->rows; i ++) {
+        gap = fmaxf(gap, fabsf(b[i] - ref[i]));
+      }
+
+      printf("  %-8s %14.3f %14.3f %10.2e%s\n",
+             spformat_name((spformat_kind_t) k), F->predicted[k] * 1e3,
+             t * 1e3, gap, (spformat_kind_t) k == F->kind ? "  *" : "");
+      spformat_free(G);
+
+    }
+    printf("\n");
+
+    spformat_free(F);
+    csr_free(C);
+    free(x);
+    free(ref);
+    free(b);
+
+  }
+
+  return EXIT_SUCCESS;
+
+}
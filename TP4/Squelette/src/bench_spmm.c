@@ -0,0 +1,99 @@
+/**
+ * Programme de benchmarking du produit matrice creuse-multivecteur.
+ *
+ * Pour différents nombres k de vecteurs, le programme compare @c spmm à k
+ * appels successifs de @c csr_matvec, chacun relisant la structure de la
+ * matrice. Il affiche les durées, l'accélération, le débit de calcul et
+ * l'écart maximal entre les deux résultats.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "csr.h"
+#include "spmm.h"
+
+#define ROWS  200000 // Nombre de lignes (et de colonnes) de la matrice.
+#define PER       16 // Nombre d'éléments non nuls par ligne.
+#define ITERS      5 // Nombre de répétitions de chaque produit.
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  static const unsigned ks[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+  // Matrice aléatoire, un élément non nul par tranche de ROWS / PER
+  // colonnes.
+  csr_t* C = csr_create(ROWS, ROWS, (size_t) ROWS * PER);
+  for (unsigned i = 0; i != ROWS; i ++) {
+    for (unsigned t = 0; t != PER; t ++) {
+      C->col[i * PER + t] = t * (ROWS / PER) + rand() % (ROWS / PER);
+      C->val[i * PER + t] = 2.0f * rand() / RAND_MAX - 1.0f;
+    }
+    C->ptr[i + 1] = (size_t) (i + 1) * PER;
+  }
+
+  printf("%4s %14s %14s %9s %10s %10s\n", "k", "k x spmv (ms)", "spmm (ms)",
+         "speedup", "Gflop/s", "ecart max");
+
+  for (unsigned s = 0; s != sizeof(ks) / sizeof(unsigned); s ++) {
+
+    const unsigned k = ks[s];
+    float* X = (float*) malloc(sizeof(float) * ROWS * k);
+    float* Y = (float*) malloc(sizeof(float) * ROWS * k);
+    float* Xt = (float*) malloc(sizeof(float) * ROWS * k);
+    float* Yt = (float*) malloc(sizeof(float) * ROWS * k);
+    for (size_t t = 0; t != (size_t) ROWS * k; t ++) {
+      X[t] = 2.0f * rand() / RAND_MAX - 1.0f;
+    }
+    // Vecteurs séparés pour les appels à csr_matvec.
+    for (unsigned i = 0; i != ROWS; i ++) {
+      for (unsigned j = 0; j != k; j ++) {
+        Xt[(size_t) j * ROWS + i] = X[(size_t) i * k + j];
+      }
+    }
+
+    double start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      for (unsigned j = 0; j != k; j ++) {
+        csr_matvec(C, Xt + (size_t) j * ROWS, Yt + (size_t) j * ROWS);
+      }
+    }
+    const double spmv = (omp_get_wtime() - start) / ITERS;
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      spmm(C, X, Y, k);
+    }
+    const double multi = (omp_get_wtime() - start) / ITERS;
+
+    float gap = 0.0f;
+    for (unsigned i = 0; i != ROWS; i ++) {
+      for (unsigned j = 0; j != k; j ++) {
+        gap = fmaxf(gap, fabsf(Y[(size_t) i * k + j]
+                               - Yt[(size_t) j * ROWS + i]));
+      }
+    }
+
+    printf("%4u %14.3f %14.3f %9.2f %10.2f %10.2e\n", k, spmv * 1e3,
+           multi * 1e3, spmv / multi, 2.0 * C->nnz * k / multi / 1e9, gap);
+
+    free(X);
+    free(Y);
+    free(Xt);
+    free(Yt);
+
+  }
+
+  csr_free(C);
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,135 @@
+/**
+ * Programme de benchmarking de l'opérateur stencil.
+ *
+ * Sur de petites grilles 2D et 3D, l'application du laplacien sans assemblage
+ * (@c stencil_matvec) est comparée au produit dense (@c matvec_sse_r4) par la
+ * matrice assemblée. Les performances sont exprimées en GFLOP/s au sens de
+ * chaque noyau (2n^2 opérations pour le produit dense, 2 nnz pour le
+ * stencil) ainsi qu'en durée par produit. Des grilles de grande taille,
+ * inaccessibles sous forme dense, sont ensuite évaluées pour le stencil seul.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "matvec_sse_r4.h"
+#include "stencil.h"
+
+#define WORK (1u << 28) // Nombre d'opérations flottantes visé par mesure.
+
+/**
+ * Durée moyenne d'une application du stencil.
+ *
+ * @param[in]  S l'opérateur.
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @return la durée en secondes.
+ */
+static double
+time_stencil(const stencil_t* S, const float* x, float* b) {
+
+  const unsigned reps = 1 + WORK / (2 * stencil_nnz(S));
+  stencil_matvec(S, x, b);
+  const double start = omp_get_wtime();
+  for (unsigned r = 0; r != reps; r ++) {
+    stencil_matvec(S, x, b);
+  }
+  return (omp_get_wtime() - start) / reps;
+
+}
+
+/**
+ * Évaluation d'une grille.
+ *
+ * @param[in] nx la dimension de la grille selon l'axe i.
+ * @param[in] ny la dimension de la grille selon l'axe j.
+ * @param[in] nz la dimension de la grille selon l'axe k.
+ * @param[in] dense si non nul, la matrice est aussi assemblée et le produit
+ *   dense évalué.
+ */
+static void
+evaluate(const unsigned nx,
+         const unsigned ny,
+         const unsigned nz,
+         const int dense) {
+
+  stencil_t* S = nz > 1
+    ? stencil_create(nx, ny, nz, 6.0f, -1.0f, -1.0f, -1.0f)
+    : stencil_create(nx, ny, 1, 4.0f, -1.0f, -1.0f, 0.0f);
+  const unsigned n = stencil_size(S);
+  const double flops = 2.0 * stencil_nnz(S);
+
+  float* x = (float*) aligned_alloc(16, sizeof(float) * n);
+  float* b = (float*) aligned_alloc(16, sizeof(float) * n);
+  for (unsigned i = 0; i != n; i ++) {
+    x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  const double tstencil = time_stencil(S, x, b);
+
+  printf("%4ux%4ux%4u %9u", nx, ny, nz, n);
+
+  if (dense) {
+
+    float* A = (float*) aligned_alloc(16, sizeof(float) * n * n);
+    float* c = (float*) aligned_alloc(16, sizeof(float) * n);
+    stencil_assemble(S, A);
+
+    const unsigned reps = 1 + WORK / (2u * n * n);
+    const double start = omp_get_wtime();
+    for (unsigned r = 0; r != reps; r ++) {
+      matvec_sse_r4(A, x, c, n);
+    }
+    const double tdense = (omp_get_wtime() - start) / reps;
+
+    float err = 0.0f;
+    for (unsigned i = 0; i != n; i ++) {
+      err = fmaxf(err, fabsf(b[i] - c[i]));
+    }
+
+    printf(" %12.3f %9.2f", tdense * 1e6, 2.0 * n * n / tdense * 1e-9);
+    printf(" %12.3f %9.2f %10.2e\n",
+           tstencil * 1e6, flops / tstencil * 1e-9, err);
+
+    free(A);
+    free(c);
+
+  } else {
+
+    printf(" %12s %9s", "-", "-");
+    printf(" %12.3f %9.2f %10s\n",
+           tstencil * 1e6, flops / tstencil * 1e-9, "-");
+
+  }
+
+  stencil_free(S);
+  free(x);
+  free(b);
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  printf("%14s %9s %12s %9s %12s %9s %10s\n",
+         "grille", "n", "dense (us)", "GFLOP/s",
+         "stencil (us)", "GFLOP/s", "ecart");
+
+  // Grilles comparables au produit dense.
+  evaluate(  64,   64,   1, 1);
+  evaluate(  16,   16,  16, 1);
+
+  // Grilles de grande taille.
+  evaluate(2048, 2048,   1, 0);
+  evaluate( 128,  128, 128, 0);
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,122 @@
+/**
+ * Programme de benchmarking du produit matrice-vecteur en flux.
+ *
+ * La matrice est écrite dans un fichier temporaire puis multipliée, d'une
+ * part selon le modèle « charger puis calculer » (lecture complète suivie de
+ * @c sgemv), d'autre part par @c matvec_stream pour différentes tailles de
+ * panneaux. Le cache de pages est vidé (dans la mesure du possible) avant
+ * chaque produit. Le programme affiche les durées totales, de lecture et de
+ * calcul, ainsi que le pourcentage de recouvrement obtenu.
+ */
+
+#define _POSIX_C_SOURCE 200809L // fileno, fsync, posix_fadvise, pread.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <omp.h>
+
+#include "matvec_stream.h"
+#include "sgemv.h"
+
+#define SIZE 4096 // Longueur de nos vecteurs.
+
+/**
+ * Éviction du fichier du cache de pages, afin que les lectures aient
+ * réellement lieu sur le support.
+ *
+ * @param[in] fd le descripteur du fichier.
+ */
+static void
+evict(const int fd) {
+  fsync(fd);
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS si les produits ont pu être effectués, sinon
+ *   @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  static const unsigned panels[] = { 16, 64, 256, 1024 };
+
+  float* A = (float*) malloc(sizeof(float) * SIZE * SIZE);
+  float* x = (float*) malloc(sizeof(float) * SIZE);
+  float* b = (float*) malloc(sizeof(float) * SIZE);
+  float* c = (float*) malloc(sizeof(float) * SIZE);
+  for (unsigned i = 0; i != SIZE * SIZE; i ++) {
+    A[i] = (float) (i % 7) - 3.0f;
+  }
+  for (unsigned i = 0; i != SIZE; i ++) {
+    x[i] = (float) (i % 5) - 2.0f;
+  }
+
+  // Écriture de la matrice dans un fichier temporaire.
+  FILE* file = tmpfile();
+  if (file == NULL
+      || fwrite(A, sizeof(float), SIZE * SIZE, file) != SIZE * SIZE
+      || fflush(file) != 0) {
+    fprintf(stderr, "bench_stream: écriture du fichier impossible\n");
+    return EXIT_FAILURE;
+  }
+  const int fd = fileno(file);
+
+  printf("%12s %10s %10s %10s %12s\n",
+         "panneau", "total (s)", "lect. (s)", "calc. (s)", "recouvr. (%)");
+
+  // Modèle charger puis calculer.
+  evict(fd);
+  double start = omp_get_wtime();
+  size_t done = 0;
+  const size_t bytes = sizeof(float) * SIZE * SIZE;
+  while (done != bytes) {
+    const ssize_t got = pread(fd, (char*) A + done, bytes - done, done);
+    if (got <= 0) {
+      fprintf(stderr, "bench_stream: lecture du fichier impossible\n");
+      return EXIT_FAILURE;
+    }
+    done += got;
+  }
+  const double load = omp_get_wtime() - start;
+  start = omp_get_wtime();
+  sgemv(SGEMV_ROW_MAJOR, SGEMV_NO_TRANS, SIZE, SIZE,
+        1.0f, A, SIZE, x, 1, 0.0f, b, 1);
+  const double compute = omp_get_wtime() - start;
+  printf("%12s %10.4f %10.4f %10.4f %12.1f\n",
+         "aucun", load + compute, load, compute, 0.0);
+
+  // Produits en flux.
+  for (unsigned t = 0; t != sizeof(panels) / sizeof(unsigned); t ++) {
+
+    evict(fd);
+    matvec_stream_stats_t stats;
+    if (matvec_stream(fd, 0, x, c, SIZE, panels[t], &stats) != 0) {
+      fprintf(stderr, "bench_stream: lecture du fichier impossible\n");
+      return EXIT_FAILURE;
+    }
+
+    int same = 1;
+    for (unsigned i = 0; i != SIZE; i ++) {
+      same = same && b[i] == c[i];
+    }
+
+    printf("%12u %10.4f %10.4f %10.4f %12.1f%s\n",
+           panels[t], stats.total, stats.io, stats.compute, stats.overlap,
+           same ? "" : "  (résultat différent !)");
+
+  }
+
+  fclose(file);
+  free(A);
+  free(x);
+  free(b);
+  free(c);
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,118 @@
+/**
+ * Programme de benchmarking du produit matrice-vecteur de Toeplitz.
+ *
+ * Pour des tailles croissantes, le produit par transformée de Fourier
+ * (@c toeplitz_matvec) est comparé au produit dense (@c matvec_sse_r4) sur la
+ * même matrice dépliée en n^2 floats. Le programme affiche la durée moyenne
+ * d'un produit pour chaque méthode, l'écart relatif maximal entre les deux
+ * résultats et la taille à partir de laquelle la transformée de Fourier
+ * devient avantageuse.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "matvec_sse_r4.h"
+#include "toeplitz.h"
+
+#define MIN_SIZE    8 // Plus petite longueur de nos vecteurs.
+#define MAX_SIZE 4096 // Plus grande longueur de nos vecteurs.
+
+/**
+ * Nombre flottant pseudo-aléatoire dans [-1, 1].
+ *
+ * @return le nombre tiré.
+ */
+static float
+randf(void) {
+  return 2.0f * rand() / RAND_MAX - 1.0f;
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  unsigned crossover = 0;
+
+  printf("%6s %14s %14s %12s\n", "n", "dense (us)", "fft (us)", "ecart");
+
+  for (unsigned n = MIN_SIZE; n <= MAX_SIZE; n *= 2) {
+
+    float* col = (float*) malloc(sizeof(float) * n);
+    float* row = (float*) malloc(sizeof(float) * n);
+    float* A = (float*) aligned_alloc(16, sizeof(float) * n * n);
+    float* x = (float*) aligned_alloc(16, sizeof(float) * n);
+    float* b = (float*) aligned_alloc(16, sizeof(float) * n);
+    float* c = (float*) aligned_alloc(16, sizeof(float) * n);
+
+    for (unsigned i = 0; i != n; i ++) {
+      col[i] = randf();
+      row[i] = randf();
+      x[i] = randf();
+    }
+    row[0] = col[0];
+
+    // Dépliage dense de la matrice : A[i][j] = col[i - j] ou row[j - i].
+    for (unsigned i = 0; i != n; i ++) {
+      for (unsigned j = 0; j != n; j ++) {
+        A[i * n + j] = i >= j ? col[i - j] : row[j - i];
+      }
+    }
+
+    toeplitz_t* T = toeplitz_create(col, row, n);
+
+    // Nombre de répétitions de façon à ce que le produit dense porte sur
+    // environ 2^26 multiplications-additions.
+    const unsigned reps = 1 + (1u << 26) / (n * n);
+
+    double start = omp_get_wtime();
+    for (unsigned r = 0; r != reps; r ++) {
+      matvec_sse_r4(A, x, b, n);
+    }
+    const double dense = (omp_get_wtime() - start) / reps;
+
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != reps; r ++) {
+      toeplitz_matvec(T, x, c);
+    }
+    const double fft = (omp_get_wtime() - start) / reps;
+
+    // Écart relatif maximal entre les deux résultats.
+    float norm = 0.0f, err = 0.0f;
+    for (unsigned i = 0; i != n; i ++) {
+      norm = fmaxf(norm, fabsf(b[i]));
+      err = fmaxf(err, fabsf(b[i] - c[i]));
+    }
+
+    printf("%6u %14.3f %14.3f %12.3e\n", n, dense * 1e6, fft * 1e6, err / norm);
+
+    if (crossover == 0 && fft < dense) {
+      crossover = n;
+    }
+
+    toeplitz_free(T);
+    free(col);
+    free(row);
+    free(A);
+    free(x);
+    free(b);
+    free(c);
+
+  }
+
+  if (crossover != 0) {
+    printf("La transformée de Fourier est plus rapide à partir de n = %u\n",
+           crossover);
+  } else {
+    printf("La transformée de Fourier n'est jamais plus rapide\n");
+  }
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,140 @@
+/**
+ * Programme de benchmarking de la transposition.
+ *
+ * Pour plusieurs tailles de matrices (dont des tailles non multiples de 8 et
+ * des puissances de 2, pour lesquelles la transposition naïve provoque des
+ * conflits de cache et de TLB), le programme compare la transposition naïve,
+ * @c transpose avec un thread puis avec tous les threads et
+ * @c transpose_inplace. Il affiche les durées et les bandes passantes
+ * obtenues (octets lus et écrits par seconde) et vérifie les résultats.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+#include "transpose.h"
+
+#define ITERS 10 // Nombre de répétitions de chaque transposition.
+
+/**
+ * Transposition naïve, servant de référence.
+ *
+ * @param[in]  A la matrice source.
+ * @param[out] B la matrice cible.
+ * @param[in]  rows le nombre de lignes de A.
+ * @param[in]  cols le nombre de colonnes de A.
+ */
+static void
+naive(const float A[], float B[], const unsigned rows, const unsigned cols) {
+  for (unsigned i = 0; i != rows; i ++) {
+    for (unsigned j = 0; j != cols; j ++) {
+      B[(size_t) j * rows + i] = A[(size_t) i * cols + j];
+    }
+  }
+}
+
+/**
+ * Affichage d'une mesure.
+ *
+ * @param[in] name le nom de la transposition.
+ * @param[in] n la taille de la matrice.
+ * @param[in] seconds la durée d'une transposition.
+ * @param[in] ok le résultat de la vérification.
+ */
+static void
+report(const char* name, const unsigned n, const double seconds,
+       const int ok) {
+  printf("%-16s %6u %12.3f %10.2f %6s\n", name, n, seconds * 1e3,
+         2.0 * sizeof(float) * n * n / seconds / 1e9, ok ? "oui" : "non");
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS si toutes les transpositions sont correctes, sinon
+ *   @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  static const unsigned sizes[] = { 1000, 1024, 2047, 4096 };
+
+  printf("%-16s %6s %12s %10s %6s\n", "transposition", "n", "durée (ms)",
+         "Go/s", "exact");
+
+  int ok = 1;
+  const int max = omp_get_max_threads();
+  for (unsigned s = 0; s != sizeof(sizes) / sizeof(unsigned); s ++) {
+
+    const unsigned n = sizes[s];
+    const size_t bytes = sizeof(float) * n * n;
+    float* A = (float*) malloc(bytes);
+    float* B = (float*) malloc(bytes);
+    float* R = (float*) malloc(bytes);
+    for (size_t k = 0; k != (size_t) n * n; k ++) {
+      A[k] = (float) k;
+    }
+
+    double start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      naive(A, R, n, n);
+    }
+    report("naive", n, (omp_get_wtime() - start) / ITERS, 1);
+
+    omp_set_num_threads(1);
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      transpose(A, B, n, n);
+    }
+    int same = memcmp(B, R, bytes) == 0;
+    report("bloc 1 thread", n, (omp_get_wtime() - start) / ITERS, same);
+    ok = ok && same;
+
+    omp_set_num_threads(max);
+    memset(B, 0, bytes);
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      transpose(A, B, n, n);
+    }
+    same = memcmp(B, R, bytes) == 0;
+    report("bloc tous", n, (omp_get_wtime() - start) / ITERS, same);
+    ok = ok && same;
+
+    // Nombre impair de transpositions en place : B doit valoir A^T.
+    memcpy(B, A, bytes);
+    start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS + 1; r ++) {
+      transpose_inplace(B, n);
+    }
+    same = memcmp(B, R, bytes) == 0;
+    report("en place", n, (omp_get_wtime() - start) / (ITERS + 1), same);
+    ok = ok && same;
+
+    free(A);
+    free(B);
+    free(R);
+
+  }
+
+  // Matrice rectangulaire.
+  const unsigned rows = 1531, cols = 777;
+  float* A = (float*) malloc(sizeof(float) * rows * cols);
+  float* B = (float*) malloc(sizeof(float) * rows * cols);
+  float* R = (float*) malloc(sizeof(float) * rows * cols);
+  for (size_t k = 0; k != (size_t) rows * cols; k ++) {
+    A[k] = (float) k;
+  }
+  naive(A, R, rows, cols);
+  transpose(A, B, rows, cols);
+  const int same = memcmp(B, R, sizeof(float) * rows * cols) == 0;
+  printf("\nrectangulaire %u x %u : %s\n", rows, cols, same ? "exact" : "FAUX");
+  ok = ok && same;
+  free(A);
+  free(B);
+  free(R);
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,192 @@
+/**
+ * Programme de benchmarking de la résolution triangulaire creuse par
+ * niveaux.
+ *
+ * La matrice est la partie triangulaire inférieure du laplacien 2D à 5
+ * points sur une grille GRID x GRID, sous la numérotation naturelle (les
+ * niveaux sont alors les anti-diagonales de la grille) puis sous une
+ * numérotation aléatoire (niveaux moins nombreux et plus larges). Pour
+ * chacune, le programme affiche le nombre de niveaux, la durée de
+ * l'analyse et celle de la résolution séquentielle, puis, pour différents
+ * nombres de threads, le nombre de threads retenu par le plan (1 si les
+ * niveaux sont trop étroits), le nombre d'attentes du plan (à comparer au nombre de
+ * barrières d'une synchronisation globale), la durée de la résolution
+ * parallèle, l'accélération et l'identité des résultats.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+#include "csr.h"
+#include "trisolve.h"
+
+#define GRID   1000 // Côté de la grille du laplacien.
+#define ITERS    10 // Nombre de répétitions de chaque résolution.
+
+/*
+ * Partie triangulaire inférieure du laplacien 2D, les sommets de la grille
+ * étant numérotés selon id.
+ */
+static csr_t*
+lower(const unsigned id[]) {
+
+  const unsigned n = GRID * GRID;
+
+  // Nombre d'éléments de chaque ligne, puis remplissage.
+  csr_t* L = csr_create(n, n, 3 * (size_t) n);
+  memset(L->ptr, 0, sizeof(size_t) * (n + 1));
+  for (unsigned y = 0; y != GRID; y ++) {
+    for (unsigned x = 0; x != GRID; x ++) {
+      const unsigned k = id[y * GRID + x];
+      const unsigned nb[4] = {
+        y ? id[(y - 1) * GRID + x] : k, x ? id[y * GRID + x - 1] : k,
+        x != GRID - 1 ? id[y * GRID + x + 1] : k,
+        y != GRID - 1 ? id[(y + 1) * GRID + x] : k
+      };
+      L->ptr[k + 1] ++;
+      for (unsigned t = 0; t != 4; t ++) {
+        L->ptr[k + 1] += nb[t] < k;
+      }
+    }
+  }
+  for (unsigned i = 0; i != n; i ++) {
+    L->ptr[i + 1] += L->ptr[i];
+  }
+  L->nnz = L->ptr[n];
+
+  size_t* fill = (size_t*) malloc(sizeof(size_t) * n);
+  memcpy(fill, L->ptr, sizeof(size_t) * n);
+  for (unsigned y = 0; y != GRID; y ++) {
+    for (unsigned x = 0; x != GRID; x ++) {
+      const unsigned k = id[y * GRID + x];
+      const unsigned nb[4] = {
+        y ? id[(y - 1) * GRID + x] : k, x ? id[y * GRID + x - 1] : k,
+        x != GRID - 1 ? id[y * GRID + x + 1] : k,
+        y != GRID - 1 ? id[(y + 1) * GRID + x] : k
+      };
+      for (unsigned t = 0; t != 4; t ++) {
+        if (nb[t] < k) {
+          L->col[fill[k]] = nb[t];
+          L->val[fill[k] ++] = -1.0f;
+        }
+      }
+      L->col[fill[k]] = k;
+      L->val[fill[k] ++] = 4.0f;
+    }
+  }
+  free(fill);
+
+  // Colonnes croissantes dans chaque ligne (au plus 5 éléments).
+  for (unsigned i = 0; i != n; i ++) {
+    for (size_t a = L->ptr[i] + 1; a < L->ptr[i + 1]; a ++) {
+      for (size_t c = a; c > L->ptr[i] && L->col[c - 1] > L->col[c]; c --) {
+        const unsigned tc = L->col[c];
+        const float tv = L->val[c];
+        L->col[c] = L->col[c - 1];
+        L->val[c] = L->val[c - 1];
+        L->col[c - 1] = tc;
+        L->val[c - 1] = tv;
+      }
+    }
+  }
+
+  return L;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS si toutes les résolutions parallèles sont
+ *   identiques à la résolution séquentielle, sinon @c EXIT_FAILURE.
+ */
+int
+main() {
+
+  const unsigned n = GRID * GRID;
+  unsigned* id = (unsigned*) malloc(sizeof(unsigned) * n);
+  float* b = (float*) malloc(sizeof(float) * n);
+  float* ref = (float*) malloc(sizeof(float) * n);
+  float* x = (float*) malloc(sizeof(float) * n);
+  for (unsigned i = 0; i != n; i ++) {
+    b[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  int identical = 1;
+  const int max = omp_get_max_threads();
+
+  for (unsigned shuffled = 0; shuffled != 2; shuffled ++) {
+
+    // Numérotation naturelle, puis mélange de Fisher-Yates.
+    for (unsigned k = 0; k != n; k ++) {
+      id[k] = k;
+    }
+    if (shuffled) {
+      for (unsigned k = n - 1; k != 0; k --) {
+        const unsigned r = (unsigned) (((double) rand() / RAND_MAX) * k);
+        const unsigned t = id[k];
+        id[k] = id[r];
+        id[r] = t;
+      }
+    }
+    csr_t* L = lower(id);
+
+    double start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      trisolve_serial(L, TRISOLVE_LOWER, b, ref);
+    }
+    const double serial = (omp_get_wtime() - start) / ITERS;
+
+    printf("numérotation %s\n", shuffled ? "aléatoire" : "naturelle");
+    printf("%8s %6s %8s %12s %10s %12s %9s %10s\n", "threads", "plan",
+           "niveaux", "analyse (ms)", "attentes", "durée (ms)", "speedup",
+           "identique");
+    printf("%8s %6s %8s %12s %10s %12.3f %9.2f %10s\n", "séq.", "-", "-", "-",
+           "-", serial * 1e3, 1.0, "-");
+
+    for (int threads = 1; ; threads *= 2) {
+
+      if (threads > max) {
+        threads = max;
+      }
+      omp_set_num_threads(threads);
+
+      start = omp_get_wtime();
+      trisolve_t* T = trisolve_analyze(L, TRISOLVE_LOWER, threads);
+      const double analysis = omp_get_wtime() - start;
+
+      memset(x, 0, sizeof(float) * n);
+      start = omp_get_wtime();
+      for (unsigned r = 0; r != ITERS; r ++) {
+        trisolve_solve(T, b, x);
+      }
+      const double solve = (omp_get_wtime() - start) / ITERS;
+
+      const int same = memcmp(x, ref, sizeof(float) * n) == 0;
+      identical = identical && same;
+      printf("%8d %6u %8u %12.3f %10zu %12.3f %9.2f %10s\n", threads,
+             T->threads, T->levels, analysis * 1e3,
+             T->wptr[(size_t) T->levels * T->threads], solve * 1e3,
+             serial / solve, same ? "oui" : "non");
+
+      trisolve_free(T);
+      if (threads == max) {
+        break;
+      }
+
+    }
+
+    csr_free(L);
+
+  }
+
+  free(id);
+  free(b);
+  free(ref);
+  free(x);
+
+  return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
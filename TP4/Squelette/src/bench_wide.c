@@ -0,0 +1,96 @@
+/**
+ * Programme de benchmarking du produit matrice-vecteur des matrices
+ * rectangulaires.
+ *
+ * Pour des matrices de même taille (64 Mo) mais de formes allant de
+ * quelques lignes très longues à de nombreuses lignes courtes, le programme
+ * mesure la durée de @c matvec_wide_by avec chacune des deux répartitions,
+ * puis celle de @c matvec_wide, et affiche la répartition que celle-ci a
+ * retenue ainsi que l'écart maximal entre les résultats des deux
+ * répartitions.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <omp.h>
+
+#include "matvec_wide.h"
+
+#define ELEMS (1u << 24) // Nombre d'éléments de chaque matrice.
+#define ITERS         10 // Nombre de répétitions de chaque produit.
+
+/*
+ * Durée moyenne d'un produit selon une répartition donnée.
+ */
+static double
+measure(const float A[], const float x[], float b[],
+        const unsigned rows, const unsigned cols,
+        const matvec_split_t split) {
+
+  const double start = omp_get_wtime();
+  for (unsigned r = 0; r != ITERS; r ++) {
+    matvec_wide_by(A, x, b, rows, cols, split);
+  }
+  return (omp_get_wtime() - start) / ITERS;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @return @c EXIT_SUCCESS.
+ */
+int
+main() {
+
+  static const unsigned shapes[] = { 2, 8, 32, 256, 4096, 65536 };
+
+  float* A = (float*) malloc(sizeof(float) * ELEMS);
+  float* x = (float*) malloc(sizeof(float) * ELEMS / 2);
+  float* b = (float*) malloc(sizeof(float) * ELEMS / 16);
+  float* c = (float*) malloc(sizeof(float) * ELEMS / 16);
+  for (unsigned i = 0; i != ELEMS; i ++) {
+    A[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+  for (unsigned i = 0; i != ELEMS / 2; i ++) {
+    x[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  const int threads = omp_get_max_threads();
+  printf("threads : %d\n", threads);
+  printf("%8s %10s %12s %12s %12s %9s %10s\n", "lignes", "colonnes",
+         "lignes (ms)", "col. (ms)", "auto (ms)", "choix", "ecart max");
+
+  for (unsigned s = 0; s != sizeof(shapes) / sizeof(unsigned); s ++) {
+
+    const unsigned rows = shapes[s], cols = ELEMS / rows;
+
+    const double by_rows = measure(A, x, b, rows, cols, MATVEC_SPLIT_ROWS);
+    const double by_cols = measure(A, x, c, rows, cols, MATVEC_SPLIT_COLS);
+    float gap = 0.0f;
+    for (unsigned i = 0; i != rows; i ++) {
+      gap = fmaxf(gap, fabsf(b[i] - c[i]));
+    }
+
+    const double start = omp_get_wtime();
+    for (unsigned r = 0; r != ITERS; r ++) {
+      matvec_wide(A, x, b, rows, cols);
+    }
+    const double automatic = (omp_get_wtime() - start) / ITERS;
+    const matvec_split_t split = matvec_wide_split(rows, cols, threads);
+
+    printf("%8u %10u %12.3f %12.3f %12.3f %9s %10.2e\n", rows, cols,
+           by_rows * 1e3, by_cols * 1e3, automatic * 1e3,
+           split == MATVEC_SPLIT_COLS ? "colonnes" : "lignes", gap);
+
+  }
+
+  free(A);
+  free(x);
+  free(b);
+  free(c);
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,380 @@
+#include "bsr.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Hauteur complétée des colonnes d'un bloc.
+ */
+static inline unsigned
+height(const unsigned bs) {
+  return bs >= 3 ? (bs + 3) & ~3u : bs;
+}
+
+/*
+ * Allocation d'une matrice BSR dont les blocs sont mis à zéro et dont seul
+ * ptr[0] est initialisé.
+ */
+static bsr_t*
+create(const unsigned rows, const unsigned cols, const unsigned bs,
+       const size_t nnzb) {
+
+  bsr_t* B = (bsr_t*) malloc(sizeof(bsr_t));
+  B->rows = rows;
+  B->cols = cols;
+  B->bs = bs;
+  B->h = height(bs);
+  B->brows = (rows + bs - 1) / bs;
+  B->nnzb = nnzb;
+  B->ptr = (size_t*) malloc(sizeof(size_t) * ((size_t) B->brows + 1));
+  B->col = (unsigned*) malloc(sizeof(unsigned) * (nnzb ? nnzb : 1));
+  const size_t bytes = (sizeof(float) * B->h * bs * nnzb + 15) & ~(size_t) 15;
+  B->val = (float*) aligned_alloc(16, bytes ? bytes : 16);
+  memset(B->val, 0, bytes);
+  B->ptr[0] = 0;
+
+  return B;
+
+}
+
+/*
+ * Nombre de blocs non nuls de taille bs d'une matrice CSR. Le tableau mark
+ * (une entrée par colonne de blocs) retient la dernière ligne de blocs dans
+ * laquelle chaque colonne de blocs a été rencontrée.
+ */
+static size_t
+count(const csr_t* C, const unsigned bs, unsigned mark[], size_t ptr[]) {
+
+  const unsigned brows = (C->rows + bs - 1) / bs;
+  const unsigned bcols = (C->cols + bs - 1) / bs;
+  memset(mark, 0xff, sizeof(unsigned) * bcols);
+
+  size_t nnzb = 0;
+  for (unsigned I = 0; I != brows; I ++) {
+    const unsigned last = (I + 1) * bs < C->rows ? (I + 1) * bs : C->rows;
+    for (unsigned i = I * bs; i != last; i ++) {
+      for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+        const unsigned J = C->col[k] / bs;
+        if (mark[J] != I) {
+          mark[J] = I;
+          nnzb ++;
+        }
+      }
+    }
+    if (ptr != NULL) {
+      ptr[I + 1] = nnzb;
+    }
+  }
+
+  return nnzb;
+
+}
+
+static int
+compare(const void* a, const void* b) {
+  const unsigned x = *(const unsigned*) a, y = *(const unsigned*) b;
+  return (x > y) - (x < y);
+}
+
+/*
+ * Accumulation de la colonne v d'un bloc, multipliée par xc, dans les
+ * registres acc (h = 4 ou 8).
+ */
+static inline void
+column(const float v[], const float xc, __m128* acc0, __m128* acc1,
+       const unsigned h) {
+
+  const __m128 xx = _mm_set1_ps(xc);
+  *acc0 = _mm_add_ps(*acc0, _mm_mul_ps(_mm_load_ps(v), xx));
+  if (h == 8) {
+    *acc1 = _mm_add_ps(*acc1, _mm_mul_ps(_mm_load_ps(v + 4), xx));
+  }
+
+}
+
+/*
+ * Produit d'une ligne de blocs. Appelée avec bs et h constants, les boucles
+ * sur les colonnes des blocs sont entièrement déroulées.
+ */
+static inline void
+block_row(const bsr_t* B, const unsigned I,
+          const float x[restrict], float y[restrict],
+          const unsigned bs, const unsigned h) {
+
+  _Alignas(16) float out[BSR_MAX] = { 0.0f };
+  const size_t size = (size_t) h * bs;
+
+  if (h == 1) {
+
+    // Blocs 1 x 1 : forme scalaire.
+    for (size_t t = B->ptr[I]; t != B->ptr[I + 1]; t ++) {
+      out[0] += B->val[t] * x[B->col[t]];
+    }
+
+  } else if (h == 2) {
+
+    // Blocs 2 x 2 : un bloc occupe un registre (a00 a10 a01 a11), multiplié
+    // par (x0 x0 x1 x1) ; les deux moitiés sont sommées à la fin.
+    xmm_t acc;
+    acc.m128_vec = _mm_setzero_ps();
+    for (size_t t = B->ptr[I]; t != B->ptr[I + 1]; t ++) {
+      const float* v = B->val + t * size;
+      const unsigned first = B->col[t] * 2;
+      if (first + 2 <= B->cols) {
+        const __m128 xx = _mm_set_ps(x[first + 1], x[first + 1],
+                                     x[first], x[first]);
+        acc.m128_vec = _mm_add_ps(acc.m128_vec,
+                                  _mm_mul_ps(_mm_load_ps(v), xx));
+      } else {
+        // Dernière colonne de blocs, réduite à une colonne.
+        out[0] += v[0] * x[first];
+        out[1] += v[1] * x[first];
+      }
+    }
+    out[0] += acc.m128_f32[0] + acc.m128_f32[2];
+    out[1] += acc.m128_f32[1] + acc.m128_f32[3];
+
+  } else {
+
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    for (size_t t = B->ptr[I]; t != B->ptr[I + 1]; t ++) {
+      const float* v = B->val + t * size;
+      const unsigned first = B->col[t] * bs;
+      if (first + bs <= B->cols) {
+        for (unsigned c = 0; c != bs; c ++) {
+          column(v + c * h, x[first + c], &acc0, &acc1, h);
+        }
+      } else {
+        // Dernière colonne de blocs, incomplète.
+        for (unsigned c = 0; c != B->cols - first; c ++) {
+          column(v + c * h, x[first + c], &acc0, &acc1, h);
+        }
+      }
+    }
+    _mm_store_ps(out, acc0);
+    if (h == 8) {
+      _mm_store_ps(out + 4, acc1);
+    }
+
+  }
+
+  const unsigned first = I * bs;
+  const unsigned n = first + bs <= B->rows ? bs : B->rows - first;
+  for (unsigned r = 0; r != n; r ++) {
+    y[first + r] = out[r];
+  }
+
+}
+
+/****************
+ * bsr_from_csr *
+ ****************/
+
+bsr_t*
+bsr_from_csr(const csr_t* C, const unsigned bs) {
+
+  if (bs == 0 || bs > BSR_MAX) {
+    return NULL;
+  }
+
+  const unsigned bcols = (C->cols + bs - 1) / bs;
+  unsigned* mark = (unsigned*) malloc(sizeof(unsigned) * (bcols ? bcols : 1));
+  size_t* slot = (size_t*) malloc(sizeof(size_t) * (bcols ? bcols : 1));
+
+  // Première passe : nombre de blocs de chaque ligne de blocs.
+  size_t* ptr = (size_t*) malloc(sizeof(size_t) * ((C->rows + bs - 1) / bs + 1));
+  ptr[0] = 0;
+  bsr_t* B = create(C->rows, C->cols, bs, count(C, bs, mark, ptr));
+  memcpy(B->ptr, ptr, sizeof(size_t) * ((size_t) B->brows + 1));
+  free(ptr);
+
+  // Seconde passe : colonnes de blocs, triées, puis valeurs.
+  memset(mark, 0xff, sizeof(unsigned) * bcols);
+  const size_t size = (size_t) B->h * bs;
+  for (unsigned I = 0; I != B->brows; I ++) {
+
+    const unsigned last = (I + 1) * bs < C->rows ? (I + 1) * bs : C->rows;
+    unsigned* cols = B->col + B->ptr[I];
+    size_t n = 0;
+    for (unsigned i = I * bs; i != last; i ++) {
+      for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+        const unsigned J = C->col[k] / bs;
+        if (mark[J] != I) {
+          mark[J] = I;
+          cols[n ++] = J;
+        }
+      }
+    }
+    qsort(cols, n, sizeof(unsigned), compare);
+    for (size_t t = 0; t != n; t ++) {
+      slot[cols[t]] = B->ptr[I] + t;
+    }
+
+    for (unsigned i = I * bs; i != last; i ++) {
+      for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+        const unsigned j = C->col[k];
+        B->val[slot[j / bs] * size + (j % bs) * B->h + (i - I * bs)] =
+          C->val[k];
+      }
+    }
+
+  }
+
+  free(mark);
+  free(slot);
+  return B;
+
+}
+
+/******************
+ * bsr_from_dense *
+ ******************/
+
+bsr_t*
+bsr_from_dense(const float A[],
+               const unsigned rows,
+               const unsigned cols,
+               const unsigned bs) {
+
+  if (bs == 0 || bs > BSR_MAX) {
+    return NULL;
+  }
+
+  const unsigned brows = (rows + bs - 1) / bs;
+  const unsigned bcols = (cols + bs - 1) / bs;
+
+  // Un bloc est stocké s'il comporte au moins un élément non nul.
+  unsigned char* nonzero = (unsigned char*) calloc((size_t) brows * bcols + 1, 1);
+  size_t nnzb = 0;
+  for (unsigned i = 0; i != rows; i ++) {
+    for (unsigned j = 0; j != cols; j ++) {
+      unsigned char* z = nonzero + (size_t) (i / bs) * bcols + j / bs;
+      if (A[(size_t) i * cols + j] != 0.0f && !*z) {
+        *z = 1;
+        nnzb ++;
+      }
+    }
+  }
+
+  bsr_t* B = create(rows, cols, bs, nnzb);
+  const size_t size = (size_t) B->h * bs;
+  size_t t = 0;
+  for (unsigned I = 0; I != brows; I ++) {
+    for (unsigned J = 0; J != bcols; J ++) {
+      if (!nonzero[(size_t) I * bcols + J]) {
+        continue;
+      }
+      B->col[t] = J;
+      float* v = B->val + t * size;
+      for (unsigned i = I * bs; i < (I + 1) * bs && i < rows; i ++) {
+        for (unsigned j = J * bs; j < (J + 1) * bs && j < cols; j ++) {
+          v[(j - J * bs) * B->h + (i - I * bs)] = A[(size_t) i * cols + j];
+        }
+      }
+      t ++;
+    }
+    B->ptr[I + 1] = t;
+  }
+
+  free(nonzero);
+  return B;
+
+}
+
+/************
+ * bsr_free *
+ ************/
+
+void
+bsr_free(bsr_t* B) {
+
+  if (B == NULL) {
+    return;
+  }
+  free(B->ptr);
+  free(B->col);
+  free(B->val);
+  free(B);
+
+}
+
+/**************
+ * bsr_detect *
+ **************/
+
+unsigned
+bsr_detect(const csr_t* C, double* fill) {
+
+  static const unsigned candidates[] = { 2, 3, 4, 8 };
+
+  unsigned* mark = (unsigned*) malloc(sizeof(unsigned) * (C->cols ? C->cols : 1));
+
+  // Volume lu par un produit CSR : valeurs, colonnes et début des lignes.
+  double best = (sizeof(float) + sizeof(unsigned)) * (double) C->nnz
+    + sizeof(size_t) * ((double) C->rows + 1);
+  unsigned choice = 1;
+  double ratio = 1.0;
+
+  for (unsigned s = 0; s != sizeof(candidates) / sizeof(unsigned); s ++) {
+    const unsigned bs = candidates[s];
+    const size_t nnzb = count(C, bs, mark, NULL);
+    const double bytes =
+      (sizeof(float) * height(bs) * bs + sizeof(unsigned)) * (double) nnzb
+      + sizeof(size_t) * ((double) ((C->rows + bs - 1) / bs) + 1);
+    if (bytes < best) {
+      best = bytes;
+      choice = bs;
+      ratio = (double) C->nnz / ((double) nnzb * bs * bs);
+    }
+  }
+
+  free(mark);
+  if (fill != NULL) {
+    *fill = ratio;
+  }
+  return choice;
+
+}
+
+/**************
+ * bsr_matvec *
+ **************/
+
+void
+bsr_matvec(const bsr_t* B, const float x[restrict], float y[restrict]) {
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int I = 0; I < (int) B->brows; I ++) {
+    switch (B->bs) {
+    case 1:
+      block_row(B, I, x, y, 1, 1);
+      break;
+    case 2:
+      block_row(B, I, x, y, 2, 2);
+      break;
+    case 3:
+      block_row(B, I, x, y, 3, 4);
+      break;
+    case 4:
+      block_row(B, I, x, y, 4, 4);
+      break;
+    case 8:
+      block_row(B, I, x, y, 8, 8);
+      break;
+    default:
+      block_row(B, I, x, y, B->bs, B->h);
+    }
+  }
+
+}
@@ -0,0 +1,108 @@
+#include "csr.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**************
+ * csr_create *
+ **************/
+
+csr_t*
+csr_create(const unsigned rows, const unsigned cols, const size_t nnz) {
+
+  csr_t* C = (csr_t*) malloc(sizeof(csr_t));
+  C->rows = rows;
+  C->cols = cols;
+  C->nnz = nnz;
+  C->ptr = (size_t*) malloc(sizeof(size_t) * ((size_t) rows + 1));
+  C->col = (unsigned*) malloc(sizeof(unsigned) * (nnz ? nnz : 1));
+  C->val = (float*) malloc(sizeof(float) * (nnz ? nnz : 1));
+  C->ptr[0] = 0;
+
+  return C;
+
+}
+
+/************
+ * csr_free *
+ ************/
+
+void
+csr_free(csr_t* C) {
+
+  if (C == NULL) {
+    return;
+  }
+  free(C->ptr);
+  free(C->col);
+  free(C->val);
+  free(C);
+
+}
+
+/******************
+ * csr_from_dense *
+ ******************/
+
+csr_t*
+csr_from_dense(const float A[], const unsigned rows, const unsigned cols) {
+
+  size_t nnz = 0;
+  for (size_t k = 0; k != (size_t) rows * cols; k ++) {
+    nnz += A[k] != 0.0f;
+  }
+
+  csr_t* C = csr_create(rows, cols, nnz);
+  size_t n = 0;
+  for (unsigned i = 0; i != rows; i ++) {
+    const float* a = A + (size_t) i * cols;
+    for (unsigned j = 0; j != cols; j ++) {
+      if (a[j] != 0.0f) {
+        C->col[n] = j;
+        C->val[n] = a[j];
+        n ++;
+      }
+    }
+    C->ptr[i + 1] = n;
+  }
+
+  return C;
+
+}
+
+/****************
+ * csr_to_dense *
+ ****************/
+
+void
+csr_to_dense(const csr_t* C, float A[]) {
+
+  memset(A, 0, sizeof(float) * C->rows * C->cols);
+  for (unsigned i = 0; i != C->rows; i ++) {
+    float* a = A + (size_t) i * C->cols;
+    for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+      a[C->col[k]] = C->val[k];
+    }
+  }
+
+}
+
+/**************
+ * csr_matvec *
+ **************/
+
+void
+csr_matvec(const csr_t* C, const float x[restrict], float b[restrict]) {
+
+  // Les longueurs de lignes pouvant être très irrégulières, les lignes sont
+  // distribuées dynamiquement par paquets.
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < (int) C->rows; i ++) {
+    float sum = 0.0f;
+    for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+      sum += C->val[k] * x[C->col[k]];
+    }
+    b[i] = sum;
+  }
+
+}
@@ -0,0 +1,234 @@
+#include "fft.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <x86intrin.h>
+
+/*
+ * Allocation d'un tableau de floats aligné sur 16 octets (la taille demandée
+ * à aligned_alloc devant être un multiple de l'alignement).
+ */
+static float*
+allocate(const unsigned count) {
+  return (float*) aligned_alloc(16, sizeof(float) * ((count + 3) & ~3u));
+}
+
+/*
+ * Transformée complexe de longueur fft->half, en place, l'entrée étant
+ * fournie dans l'ordre bit-reverse. Pour chaque étage de demi-span h, les
+ * papillons d'indices j, j + 1, j + 2 et j + 3 d'un même groupe partagent des
+ * facteurs de rotation contigus et sont donc calculés dans un même registre
+ * SSE dès que h >= 4.
+ */
+static void
+transform(const fft_t* fft, float zr[restrict], float zi[restrict]) {
+
+  const unsigned n = fft->half;
+
+  for (unsigned h = 1; h < n; h *= 2) {
+
+    const float* twr = fft->twr + h;
+    const float* twi = fft->twi + h;
+
+    for (unsigned k = 0; k < n; k += 2 * h) {
+
+      float* ar = zr + k;
+      float* ai = zi + k;
+      float* br = zr + k + h;
+      float* bi = zi + k + h;
+
+      unsigned j = 0;
+      if (h >= 4) {
+        for (; j != h; j += 4) {
+          const __m128 wr = _mm_load_ps(twr + j);
+          const __m128 wi = _mm_load_ps(twi + j);
+          const __m128 xr = _mm_load_ps(br + j);
+          const __m128 xi = _mm_load_ps(bi + j);
+          const __m128 tr = _mm_sub_ps(_mm_mul_ps(xr, wr), _mm_mul_ps(xi, wi));
+          const __m128 ti = _mm_add_ps(_mm_mul_ps(xr, wi), _mm_mul_ps(xi, wr));
+          const __m128 ur = _mm_load_ps(ar + j);
+          const __m128 ui = _mm_load_ps(ai + j);
+          _mm_store_ps(ar + j, _mm_add_ps(ur, tr));
+          _mm_store_ps(ai + j, _mm_add_ps(ui, ti));
+          _mm_store_ps(br + j, _mm_sub_ps(ur, tr));
+          _mm_store_ps(bi + j, _mm_sub_ps(ui, ti));
+        }
+      }
+
+      // Premiers étages (h < 4) : forme scalaire.
+      for (; j != h; j ++) {
+        const float tr = br[j] * twr[j] - bi[j] * twi[j];
+        const float ti = br[j] * twi[j] + bi[j] * twr[j];
+        const float ur = ar[j];
+        const float ui = ai[j];
+        ar[j] = ur + tr;
+        ai[j] = ui + ti;
+        br[j] = ur - tr;
+        bi[j] = ui - ti;
+      }
+
+    }
+
+  }
+
+}
+
+/**************
+ * fft_create *
+ **************/
+
+fft_t*
+fft_create(const unsigned length) {
+
+  // La longueur doit être une puissance de 2 supérieure ou égale à 2.
+  if (length < 2 || (length & (length - 1)) != 0) {
+    return NULL;
+  }
+
+  fft_t* fft = (fft_t*) malloc(sizeof(fft_t));
+  const unsigned n = length / 2;
+  fft->length = length;
+  fft->half = n;
+  fft->rev = (unsigned*) malloc(sizeof(unsigned) * n);
+  fft->twr = allocate(n);
+  fft->twi = allocate(n);
+  fft->wr = allocate(n + 1);
+  fft->wi = allocate(n + 1);
+  fft->zr = allocate(n);
+  fft->zi = allocate(n);
+
+  // Permutation bit-reverse.
+  unsigned bits = 0;
+  while ((1u << bits) < n) {
+    bits ++;
+  }
+  for (unsigned i = 0; i != n; i ++) {
+    unsigned r = 0;
+    for (unsigned b = 0; b != bits; b ++) {
+      r |= ((i >> b) & 1u) << (bits - 1 - b);
+    }
+    fft->rev[i] = r;
+  }
+
+  // Facteurs de rotation exp(-i.pi.j / h) de chaque étage, rangés de façon
+  // contiguë à partir de la case h. Les calculs sont faits en double
+  // précision pour ne pas dégrader la transformée.
+  const double pi = acos(-1.0);
+  for (unsigned h = 1; h < n; h *= 2) {
+    for (unsigned j = 0; j != h; j ++) {
+      fft->twr[h + j] = (float)  cos(pi * j / h);
+      fft->twi[h + j] = (float) -sin(pi * j / h);
+    }
+  }
+
+  // Facteurs de recombinaison de la transformée réelle.
+  for (unsigned k = 0; k <= n; k ++) {
+    fft->wr[k] = (float)  cos(2.0 * pi * k / length);
+    fft->wi[k] = (float) -sin(2.0 * pi * k / length);
+  }
+
+  return fft;
+
+}
+
+/************
+ * fft_free *
+ ************/
+
+void
+fft_free(fft_t* fft) {
+
+  if (fft == NULL) {
+    return;
+  }
+  free(fft->rev);
+  free(fft->twr);
+  free(fft->twi);
+  free(fft->wr);
+  free(fft->wi);
+  free(fft->zr);
+  free(fft->zi);
+  free(fft);
+
+}
+
+/***************
+ * fft_forward *
+ ***************/
+
+void
+fft_forward(fft_t* fft,
+            const float in[],
+                  float re[],
+                  float im[]) {
+
+  const unsigned n = fft->half;
+  float* zr = fft->zr;
+  float* zi = fft->zi;
+
+  // Le signal réel est vu comme un signal complexe de longueur moitié dont
+  // les parties réelles (resp. imaginaires) sont les échantillons pairs
+  // (resp. impairs). Il est directement rangé dans l'ordre bit-reverse.
+  for (unsigned i = 0; i != n; i ++) {
+    zr[fft->rev[i]] = in[2 * i];
+    zi[fft->rev[i]] = in[2 * i + 1];
+  }
+
+  transform(fft, zr, zi);
+
+  // Recombinaison : X[k] = E[k] + W^k.O[k], où E (resp. O) est le spectre des
+  // échantillons pairs (resp. impairs), obtenu à partir de Z[k] et de
+  // conj(Z[N - k]).
+  for (unsigned k = 0; k <= n; k ++) {
+    const unsigned p = k == n ? 0 : k;
+    const unsigned q = k == 0 ? 0 : n - k;
+    const float evr = 0.5f * (zr[p] + zr[q]);
+    const float evi = 0.5f * (zi[p] - zi[q]);
+    const float odr = 0.5f * (zi[p] + zi[q]);
+    const float odi = 0.5f * (zr[q] - zr[p]);
+    re[k] = evr + fft->wr[k] * odr - fft->wi[k] * odi;
+    im[k] = evi + fft->wr[k] * odi + fft->wi[k] * odr;
+  }
+
+}
+
+/***************
+ * fft_inverse *
+ ***************/
+
+void
+fft_inverse(fft_t* fft,
+            const float re[],
+            const float im[],
+                  float out[]) {
+
+  const unsigned n = fft->half;
+  float* zr = fft->zr;
+  float* zi = fft->zi;
+
+  // Opération inverse de la recombinaison : Z[k] = E[k] + i.O[k] avec
+  // E[k] = (X[k] + conj(X[N - k])) / 2 et
+  // O[k] = (X[k] - conj(X[N - k])).conj(W^k) / 2, rangé dans l'ordre
+  // bit-reverse.
+  for (unsigned k = 0; k != n; k ++) {
+    const float evr = 0.5f * (re[k] + re[n - k]);
+    const float evi = 0.5f * (im[k] - im[n - k]);
+    const float dr = 0.5f * (re[k] - re[n - k]);
+    const float di = 0.5f * (im[k] + im[n - k]);
+    const float odr = dr * fft->wr[k] + di * fft->wi[k];
+    const float odi = di * fft->wr[k] - dr * fft->wi[k];
+    zr[fft->rev[k]] = evr - odi;
+    zi[fft->rev[k]] = evi + odr;
+  }
+
+  // La transformée inverse est obtenue en échangeant parties réelles et
+  // imaginaires avant et après la transformée directe.
+  transform(fft, zi, zr);
+
+  const float scale = 1.0f / n;
+  for (unsigned i = 0; i != n; i ++) {
+    out[2 * i]     = zr[i] * scale;
+    out[2 * i + 1] = zi[i] * scale;
+  }
+
+}
@@ -0,0 +1,108 @@
+#ifndef MatvecFixed_hpp
+#define MatvecFixed_hpp
+
+#include <x86intrin.h>
+
+namespace paralgos {
+
+  /**
+   * @class MatvecUnroll MatvecFixed.hpp
+   *
+   * Déroulage complet, à la compilation, du produit scalaire d'une ligne de
+   * longueur N par le vecteur source : chaque instance traite quatre
+   * composantes à partir de la position K puis instancie la suivante. Quatre
+   * accumulateurs sont utilisés à tour de rôle pour ne pas sérialiser les
+   * additions.
+   */
+  template< unsigned K, unsigned N >
+  class MatvecUnroll {
+  public:
+
+    /**
+     * Accumulation des composantes [K, N[.
+     *
+     * @param[in] row - la ligne de la matrice (alignée sur 16 octets).
+     * @param[in] xx - le vecteur source, compacté en registres 128 bits.
+     * @param[in, out] acc - les quatre accumulateurs.
+     */
+    static inline void
+    apply(const float* row, const __m128* xx, __m128* acc) {
+      acc[(K / 4) % 4] = _mm_add_ps(acc[(K / 4) % 4],
+				    _mm_mul_ps(_mm_load_ps(row + K), xx[K / 4]));
+      MatvecUnroll< K + 4, N >::apply(row, xx, acc);
+    } // apply
+
+  }; // MatvecUnroll
+
+  /**
+   * Fin de la récursion : toutes les composantes ont été traitées.
+   */
+  template< unsigned N >
+  class MatvecUnroll< N, N > {
+  public:
+
+    static inline void
+    apply(const float*, const __m128*, __m128*) {
+    } // apply
+
+  }; // MatvecUnroll< N, N >
+
+  /**
+   * @class MatvecFixed MatvecFixed.hpp
+   *
+   * Forme SIMD de l'algorithme de multiplication matrice-vecteur spécialisée
+   * à la compilation pour une matrice de M lignes et N colonnes. Les bornes
+   * étant des constantes, la boucle sur les colonnes est entièrement déroulée
+   * et le vecteur source est recopié une fois pour toutes dans un tableau
+   * local de N / 4 valeurs __m128 (2 Ko pour N = 512), relu depuis la pile
+   * (et donc depuis le cache L1) pour chaque ligne : seuls les quatre
+   * accumulateurs restent dans des registres.
+   */
+  template< unsigned M, unsigned N >
+  class MatvecFixed {
+  public:
+
+    static_assert(N % 4 == 0, "N doit être un multiple de 4");
+
+    /**
+     * Produit b = A * x.
+     *
+     * @param[in] A - la matrice (dépliée en tableau, alignée sur 16 octets).
+     * @param[in] x - le vecteur source (aligné sur 16 octets).
+     * @param[out] b - le vecteur cible.
+     */
+    static void
+    apply(const float* __restrict__ A,
+	  const float* __restrict__ x,
+	  float* __restrict__ b) {
+
+      // Le vecteur source, compacté.
+      __m128 xx[N / 4];
+      for (unsigned k = 0; k != N / 4; k ++) {
+	xx[k] = _mm_load_ps(x + 4 * k);
+      }
+
+      for (unsigned i = 0; i != M; i ++) {
+
+	__m128 acc[4] = {
+	  _mm_setzero_ps(), _mm_setzero_ps(),
+	  _mm_setzero_ps(), _mm_setzero_ps()
+	};
+	MatvecUnroll< 0, N >::apply(A + i * N, xx, acc);
+
+	// Réduction des accumulateurs puis des composantes du registre.
+	const __m128 sum = _mm_add_ps(_mm_add_ps(acc[0], acc[1]),
+				      _mm_add_ps(acc[2], acc[3]));
+	float lanes[4];
+	_mm_storeu_ps(lanes, sum);
+	b[i] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+      }
+
+    } // apply
+
+  }; // MatvecFixed
+
+} // paralgos
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef BCMAT_H
+#define BCMAT_H
+
+#include <stddef.h>
+
+/**
+ * Nombre de floats par bloc compressé (4 Ko non compressés).
+ */
+#define BCMAT_BLOCK 1024
+
+/**
+ * Matrice carrée compressée sans perte par blocs. Chaque ligne est découpée
+ * en blocs d'au plus @c BCMAT_BLOCK floats, codés indépendamment :
+ *  - codage XOR : chaque float est remplacé par le XOR de sa représentation
+ *    binaire avec celle du float situé quatre positions avant lui (les quatre
+ *    premiers étant conservés tels quels dans l'entête du bloc), ce qui
+ *    annule signes, exposants et bits de poids fort des mantisses identiques ;
+ *  - byte-shuffle : les octets de rang 0, 1, 2 et 3 des résidus forment
+ *    quatre plans distincts ;
+ *  - chaque plan est omis s'il est nul, réduit à un octet s'il est constant
+ *    et stocké tel quel sinon.
+ * Un bloc occupe ainsi 32 octets d'entête suivis de 0 à 4 plans.
+ */
+typedef struct {
+  unsigned size;        // La longueur de nos vecteurs.
+  size_t* rows;         // Position du premier bloc de chaque ligne (size + 1
+                        // entrées, la dernière donnant la taille totale).
+  unsigned char* data;  // Les blocs, alignés sur 16 octets.
+  size_t bytes;         // Taille totale des blocs en octets.
+} bcmat_t;
+
+/**
+ * Compression d'une matrice.
+ *
+ * @param[in] A la matrice (dépliée en tableau).
+ * @param[in] size la longueur de nos vecteurs.
+ * @return la matrice compressée.
+ */
+bcmat_t* bcmat_create(const float A[], const unsigned size);
+
+/**
+ * Destruction d'une matrice compressée.
+ *
+ * @param[in] M la matrice (éventuellement @c NULL).
+ */
+void bcmat_free(bcmat_t* M);
+
+/**
+ * Décompression complète d'une matrice.
+ *
+ * @param[in]  M la matrice compressée.
+ * @param[out] A la matrice (dépliée en tableau).
+ */
+void bcmat_decode(const bcmat_t* M, float A[]);
+
+/**
+ * Multiplication matrice-vecteur sur la matrice compressée : chaque bloc est
+ * décodé avec le jeu d'instructions SSE dans un tampon de 4 Ko, qui réside en
+ * cache L1, puis immédiatement multiplié par le segment correspondant de x.
+ * Les lignes sont réparties entre les threads OpenMP.
+ *
+ * @param[in]  M la matrice compressée.
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ */
+void bcmat_matvec(const bcmat_t* M,
+                  const float x[restrict],
+                        float b[restrict]);
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef BSR_H
+#define BSR_H
+
+#include "csr.h"
+
+/**
+ * Taille maximale des blocs.
+ */
+#define BSR_MAX 8
+
+/**
+ * Matrice creuse par blocs (format BSR, Block Sparse Row) : la matrice est
+ * découpée en blocs carrés de bs x bs éléments, et seuls les blocs
+ * comportant au moins un élément non nul sont stockés, sous forme dense. Les
+ * blocs de la ligne de blocs I occupent les positions ptr[I] à ptr[I + 1] - 1
+ * des tableaux col et val.
+ *
+ * Chaque bloc est stocké colonne par colonne, chaque colonne étant complétée
+ * par des zéros jusqu'à la hauteur h (multiple de 4 pour bs >= 3, afin
+ * qu'elle occupe des registres SSE complets).
+ */
+typedef struct {
+  unsigned rows;    // Le nombre de lignes.
+  unsigned cols;    // Le nombre de colonnes.
+  unsigned bs;      // La taille des blocs.
+  unsigned h;       // La hauteur (complétée) des colonnes d'un bloc.
+  unsigned brows;   // Le nombre de lignes de blocs.
+  size_t nnzb;      // Le nombre de blocs stockés.
+  size_t* ptr;      // Début de chaque ligne de blocs (brows + 1 entrées).
+  unsigned* col;    // Colonne de blocs de chaque bloc.
+  float* val;       // Les blocs (h x bs floats chacun), alignés sur 16
+                    // octets.
+} bsr_t;
+
+/**
+ * Conversion d'une matrice CSR au format BSR.
+ *
+ * @param[in] C la matrice CSR.
+ * @param[in] bs la taille des blocs (1 à @c BSR_MAX).
+ * @return la matrice BSR, ou @c NULL si la taille des blocs est invalide.
+ */
+bsr_t* bsr_from_csr(const csr_t* C, const unsigned bs);
+
+/**
+ * Conversion d'une matrice dense au format BSR.
+ *
+ * @param[in] A la matrice (dépliée en tableau, ligne par ligne).
+ * @param[in] rows le nombre de lignes.
+ * @param[in] cols le nombre de colonnes.
+ * @param[in] bs la taille des blocs (1 à @c BSR_MAX).
+ * @return la matrice BSR, ou @c NULL si la taille des blocs est invalide.
+ */
+bsr_t* bsr_from_dense(const float A[],
+                      const unsigned rows,
+                      const unsigned cols,
+                      const unsigned bs);
+
+/**
+ * Destruction d'une matrice BSR.
+ *
+ * @param[in] B la matrice (éventuellement @c NULL).
+ */
+void bsr_free(bsr_t* B);
+
+/**
+ * Détection de la taille de blocs la plus avantageuse pour une matrice
+ * CSR : pour chaque taille candidate (2, 3, 4 et 8), le nombre de blocs non
+ * nuls est compté et le volume de données lu par un produit (valeurs,
+ * zéros de remplissage compris, et indices) est comparé à celui du format
+ * CSR.
+ *
+ * @param[in]  C la matrice CSR.
+ * @param[out] fill le taux de remplissage des blocs retenus, rapport entre
+ *   le nombre d'éléments non nuls et le nombre d'éléments stockés
+ *   (éventuellement @c NULL).
+ * @return la taille de blocs retenue, ou 1 si le format CSR lit moins de
+ *   données que toute taille de blocs.
+ */
+unsigned bsr_detect(const csr_t* C, double* fill);
+
+/**
+ * Multiplication matrice par blocs-vecteur y = B.x. Pour chaque ligne de
+ * blocs, les bs composantes de y sont accumulées dans un ou deux registres
+ * SSE : chaque colonne d'un bloc y est multipliée par la composante
+ * correspondante de x, diffusée dans un registre (un bloc 2 x 2 occupant à
+ * lui seul un registre). Les micro-noyaux sont spécialisés pour les tailles
+ * 1, 2, 3, 4 et 8 ; les lignes de blocs sont réparties entre les threads
+ * OpenMP.
+ *
+ * @param[in]  B la matrice BSR.
+ * @param[in]  x le vecteur source (cols composantes).
+ * @param[out] y le vecteur cible (rows composantes).
+ */
+void bsr_matvec(const bsr_t* B, const float x[restrict], float y[restrict]);
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include <stddef.h>
+
+/**
+ * Matrice creuse stockée au format CSR (Compressed Sparse Row) : les
+ * éléments non nuls de la ligne i occupent les positions ptr[i] à
+ * ptr[i + 1] - 1 des tableaux col et val, par colonnes croissantes.
+ */
+typedef struct {
+  unsigned rows;  // Le nombre de lignes.
+  unsigned cols;  // Le nombre de colonnes.
+  size_t nnz;     // Le nombre d'éléments non nuls.
+  size_t* ptr;    // Début de chaque ligne (rows + 1 entrées).
+  unsigned* col;  // Colonne de chaque élément.
+  float* val;     // Valeur de chaque élément.
+} csr_t;
+
+/**
+ * Allocation d'une matrice CSR, dont seul ptr[0] est initialisé (à 0).
+ *
+ * @param[in] rows le nombre de lignes.
+ * @param[in] cols le nombre de colonnes.
+ * @param[in] nnz le nombre d'éléments non nuls.
+ * @return la matrice.
+ */
+csr_t* csr_create(const unsigned rows, const unsigned cols, const size_t nnz);
+
+/**
+ * Destruction d'une matrice CSR.
+ *
+ * @param[in] C la matrice (éventuellement @c NULL).
+ */
+void csr_free(csr_t* C);
+
+/**
+ * Conversion d'une matrice dense en matrice CSR (les zéros sont omis).
+ *
+ * @param[in] A la matrice (dépliée en tableau, ligne par ligne).
+ * @param[in] rows le nombre de lignes.
+ * @param[in] cols le nombre de colonnes.
+ * @return la matrice CSR.
+ */
+csr_t* csr_from_dense(const float A[], const unsigned rows, const unsigned cols);
+
+/**
+ * Conversion d'une matrice CSR en matrice dense.
+ *
+ * @param[in]  C la matrice CSR.
+ * @param[out] A la matrice (dépliée en tableau, ligne par ligne), de taille
+ *   rows x cols.
+ */
+void csr_to_dense(const csr_t* C, float A[]);
+
+/**
+ * Multiplication matrice creuse-vecteur b = C.x, les lignes étant réparties
+ * entre les threads OpenMP.
+ *
+ * @param[in]  C la matrice CSR.
+ * @param[in]  x le vecteur source (cols composantes).
+ * @param[out] b le vecteur cible (rows composantes).
+ */
+void csr_matvec(const csr_t* C, const float x[restrict], float b[restrict]);
+
+#endif
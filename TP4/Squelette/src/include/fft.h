@@ -0,0 +1,63 @@
+#ifndef FFT_H
+#define FFT_H
+
+/**
+ * Plan de transformée de Fourier rapide réelle de longueur L (puissance de
+ * 2). La transformée réelle est calculée à l'aide d'une transformée complexe
+ * de longueur L / 2 (radix 2, entrelacement temporel) dont les papillons sont
+ * vectorisés avec le jeu d'instructions SSE, suivie d'une passe de
+ * recombinaison.
+ */
+typedef struct {
+  unsigned length;   // Longueur L de la transformée réelle.
+  unsigned half;     // Longueur N = L / 2 de la transformée complexe.
+  unsigned* rev;     // Permutation bit-reverse sur N éléments.
+  float *twr, *twi;  // Facteurs de rotation des étages : l'étage de demi-span
+                     // h utilise les cases [h, 2h[.
+  float *wr, *wi;    // Facteurs de recombinaison exp(-2i.pi.k / L), k <= N.
+  float *zr, *zi;    // Espace de travail (N complexes).
+} fft_t;
+
+/**
+ * Création d'un plan de transformée.
+ *
+ * @param[in] length la longueur L de la transformée (puissance de 2, >= 2).
+ * @return le plan, ou @c NULL si la longueur n'est pas valide.
+ */
+fft_t* fft_create(const unsigned length);
+
+/**
+ * Destruction d'un plan de transformée.
+ *
+ * @param[in] fft le plan (éventuellement @c NULL).
+ */
+void fft_free(fft_t* fft);
+
+/**
+ * Transformée directe d'un signal réel : X[k] = somme x[n].exp(-2i.pi.kn / L).
+ *
+ * @param[in]  fft le plan (son espace de travail est modifié).
+ * @param[in]  in le signal de longueur L.
+ * @param[out] re les parties réelles des coefficients 0 à L / 2.
+ * @param[out] im les parties imaginaires des coefficients 0 à L / 2.
+ */
+void fft_forward(fft_t* fft,
+                 const float in[],
+                       float re[],
+                       float im[]);
+
+/**
+ * Transformée inverse (normalisée par 1 / L) d'un spectre à symétrie
+ * hermitienne, donc d'un signal réel.
+ *
+ * @param[in]  fft le plan (son espace de travail est modifié).
+ * @param[in]  re les parties réelles des coefficients 0 à L / 2.
+ * @param[in]  im les parties imaginaires des coefficients 0 à L / 2.
+ * @param[out] out le signal de longueur L.
+ */
+void fft_inverse(fft_t* fft,
+                 const float re[],
+                 const float im[],
+                       float out[]);
+
+#endif
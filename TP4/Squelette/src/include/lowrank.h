@@ -0,0 +1,56 @@
+#ifndef LOWRANK_H
+#define LOWRANK_H
+
+/**
+ * Approximation de rang k d'une matrice carrée, A ~ U * V^T, où U est une
+ * matrice n x k et V^T une matrice k x n (toutes deux dépliées ligne par
+ * ligne). Le produit ne lit alors que 2nk floats au lieu de n^2.
+ */
+typedef struct {
+  unsigned size;  // La longueur n de nos vecteurs.
+  unsigned rank;  // Le rang k de l'approximation.
+  float* U;       // Les facteurs U (n x k).
+  float* Vt;      // Les facteurs V^T (k x n).
+  float* work;    // Espace de travail : le vecteur V^T * x (k composantes).
+  double error;   // Norme de Frobenius de A - U * V^T.
+} lowrank_t;
+
+/**
+ * Construction de l'approximation par la méthode de recherche d'image
+ * aléatoire (randomized range finder) : l'image de A est échantillonnée par
+ * le produit de A et d'une matrice gaussienne n x k, éventuellement raffinée
+ * par quelques itérations de puissance, puis orthonormalisée en Q. Nous
+ * posons alors U = Q et V^T = Q^T * A. Les calculs sont faits en double
+ * précision.
+ *
+ * @param[in] A la matrice (dépliée en tableau).
+ * @param[in] size la longueur n de nos vecteurs.
+ * @param[in] rank le rang k de l'approximation (1 <= k <= n).
+ * @param[in] iters le nombre d'itérations de puissance (0, 1 ou 2 suffisent
+ *   en général ; elles améliorent la précision lorsque les valeurs
+ *   singulières de A décroissent lentement).
+ * @return l'approximation, dont le champ @c error borne l'erreur commise :
+ *   pour tout x, ||A * x - U * V^T * x|| <= error * ||x||.
+ */
+lowrank_t* lowrank_create(const float A[],
+                          const unsigned size,
+                          const unsigned rank,
+                          const unsigned iters);
+
+/**
+ * Destruction d'une approximation de rang k.
+ *
+ * @param[in] L l'approximation (éventuellement @c NULL).
+ */
+void lowrank_free(lowrank_t* L);
+
+/**
+ * Multiplication matrice-vecteur b = U * (V^T * x) en O(nk).
+ *
+ * @param[in]  L l'approximation (son espace de travail est modifié).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ */
+void lowrank_matvec(lowrank_t* L, const float x[], float b[]);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef MATVEC_FIXED_H
+#define MATVEC_FIXED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Forme SIMD de l'algorithme de multiplication matrice-vecteur aiguillant les
+ * tailles connues à la compilation (64, 128, 256 et 512) vers les noyaux
+ * spécialisés @c paralgos::MatvecFixed, entièrement déroulés. Les autres
+ * tailles sont traitées par une boucle générique identique à celle de
+ * @c matvec_sse_r4.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @param[in]  size la longueur de nos vecteurs.
+ *
+ * @note la longueur des vecteurs doit obligatoirement être un multiple de 4
+ *   et les trois tableaux alignés sur 16 octets.
+ */
+void matvec_fixed(const float A[], const float x[], float b[],
+                  const unsigned size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef MATVEC_KAHAN_H
+#define MATVEC_KAHAN_H
+
+/**
+ * Forme compensée de l'algorithme de multiplication matrice-vecteur
+ * exploitant le jeu d'instructions SSE (algorithme Dot2 d'Ogita, Rump et
+ * Oishi). Chacun des quatre couloirs d'un registre accumule sa somme
+ * partielle et l'erreur commise :
+ *  - l'erreur d'arrondi de chaque produit a.x est obtenue exactement par
+ *    l'algorithme TwoProduct de Dekker (scission des opérandes en deux
+ *    moitiés de 12 bits) ;
+ *  - l'erreur d'arrondi de chaque addition est obtenue exactement par
+ *    l'algorithme TwoSum de Knuth, sans branchement.
+ * Les erreurs sont sommées à part, puis ajoutées au résultat : celui-ci est
+ * aussi précis que si le produit scalaire avait été calculé en précision
+ * double, à un terme en cond·u² près (u étant l'unité d'arrondi simple
+ * précision), tout en conservant un stockage simple précision.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @param[in]  size la longueur de nos vecteurs.
+ *
+ * @note aucune contrainte d'alignement ni de longueur n'est imposée.
+ * @note les transformations exactes supposent que le compilateur ne
+ *   réassocie ni ne fusionne les opérations flottantes : elles sont
+ *   incompatibles avec -ffast-math et -ffp-contract=fast.
+ */
+void matvec_kahan(const float A[restrict],
+                  const float x[restrict],
+                        float b[restrict],
+                  const unsigned size);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef MATVEC_PARAM_H
+#define MATVEC_PARAM_H
+
+/**
+ * Paramètres d'exécution du noyau @c matvec_param.
+ */
+typedef struct {
+  unsigned unroll;   // Nombre d'accumulateurs SSE par ligne (1, 2 ou 4).
+  unsigned rows;     // Nombre de lignes traitées simultanément (1, 2 ou 4).
+  unsigned prefetch; // Distance de préchargement de A en floats (0 : aucun).
+  unsigned threads;  // Nombre de threads OpenMP (0 : valeur par défaut).
+} matvec_param_t;
+
+/**
+ * Forme SIMD paramétrable de l'algorithme de multiplication matrice-vecteur.
+ * Elle généralise @c matvec_sse_r4 (qui correspond à unroll = 1, rows = 1,
+ * prefetch = 0, threads = 1) et sert d'espace de recherche à l'autotuner.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @param[in]  size la longueur de nos vecteurs.
+ * @param[in]  param les paramètres d'exécution.
+ *
+ * @note la longueur des vecteurs doit obligatoirement être un multiple de 4
+ *   et les trois tableaux alignés sur 16 octets.
+ */
+void matvec_param(const float A[restrict],
+                  const float x[restrict],
+                        float b[restrict],
+                  const unsigned size,
+                  const matvec_param_t* param);
+
+#endif
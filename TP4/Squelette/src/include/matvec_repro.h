@@ -0,0 +1,56 @@
+#ifndef MATVEC_REPRO_H
+#define MATVEC_REPRO_H
+
+/**
+ * Taille (en composantes) des blocs de la réduction reproductible. Elle fait
+ * partie de la définition du résultat : la modifier change les valeurs
+ * obtenues.
+ */
+#define MATVEC_REPRO_BLOCK 64
+
+/**
+ * Forme reproductible bit à bit de l'algorithme de multiplication
+ * matrice-vecteur. Chaque composante de b est calculée selon un ordre de
+ * sommation canonique, indépendant du nombre de threads et du jeu
+ * d'instructions :
+ *  - chaque ligne est découpée en blocs de @c MATVEC_REPRO_BLOCK composantes ;
+ *  - dans un bloc, la composante k est accumulée dans le couloir k % 4, puis
+ *    les couloirs sont sommés sous la forme (c0 + c1) + (c2 + c3) ;
+ *  - les sommes de blocs sont combinées selon un arbre binaire fixe (celui
+ *    d'un compteur binaire : deux sous-arbres de même hauteur sont fusionnés
+ *    dès que possible, les sous-arbres restants étant sommés de droite à
+ *    gauche).
+ * Les lignes sont réparties entre les threads OpenMP, chacune étant
+ * entièrement calculée par un seul thread.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @param[in]  size la longueur de nos vecteurs.
+ *
+ * @note aucune contrainte d'alignement ni de longueur n'est imposée.
+ * @note la reproductibilité suppose que le compilateur ne fusionne pas les
+ *   multiplications et additions (FMA) : c'est le cas de gcc en mode
+ *   -std=c11, qui implique -ffp-contract=off.
+ */
+void matvec_repro(const float A[restrict],
+                  const float x[restrict],
+                        float b[restrict],
+                  const unsigned size);
+
+/**
+ * Version scalaire et séquentielle de @c matvec_repro, suivant exactement le
+ * même ordre de sommation : elle sert de référence pour vérifier que les deux
+ * formes produisent des résultats identiques bit à bit.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @param[in]  size la longueur de nos vecteurs.
+ */
+void matvec_repro_ref(const float A[],
+                      const float x[],
+                            float b[],
+                      const unsigned size);
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef MATVEC_SERVER_H
+#define MATVEC_SERVER_H
+
+#include <time.h>
+
+/**
+ * Serveur de produits matrice-vecteur (type opaque).
+ */
+typedef struct matvec_server matvec_server_t;
+
+/**
+ * Requête soumise au serveur, jouant le rôle de « future » : elle est allouée
+ * par l'appelant, qui ne doit ni la modifier ni la libérer avant qu'elle soit
+ * terminée.
+ */
+typedef struct matvec_request {
+  const float* x;               // Le vecteur source.
+  float* b;                     // Le vecteur cible.
+  int done;                     // Non nul une fois b calculé.
+  struct timespec arrival;      // Date de soumission.
+  struct matvec_request* next;  // Chaînage de la file d'attente.
+} matvec_request_t;
+
+/**
+ * Création d'un serveur : un thread dédié attend les requêtes portant sur la
+ * matrice A et les traite par lots, sous la forme d'un unique produit
+ * matrice-matrice (une colonne par requête). Un lot est lancé dès que batch
+ * requêtes sont en attente, ou lorsque la plus ancienne attend depuis
+ * timeout secondes.
+ *
+ * @param[in] A la matrice (dépliée en tableau), qui doit rester valide et
+ *   inchangée pendant toute la vie du serveur.
+ * @param[in] size la longueur de nos vecteurs.
+ * @param[in] batch le nombre maximal de requêtes par lot.
+ * @param[in] timeout le délai d'attente maximal d'une requête avant le
+ *   lancement d'un lot incomplet (en secondes).
+ * @return le serveur, ou @c NULL si son allocation ou la création de son
+ *   thread a échoué.
+ */
+matvec_server_t* matvec_server_create(const float A[],
+                                      const unsigned size,
+                                      const unsigned batch,
+                                      const double timeout);
+
+/**
+ * Arrêt d'un serveur : les requêtes en attente sont traitées, puis le thread
+ * du serveur est arrêté et ses ressources sont libérées.
+ *
+ * @param[in] S le serveur (éventuellement @c NULL).
+ */
+void matvec_server_free(matvec_server_t* S);
+
+/**
+ * Soumission d'une requête b = A.x, sans attendre son traitement.
+ *
+ * @param[in]  S le serveur.
+ * @param[out] r la requête, initialisée par la fonction.
+ * @param[in]  x le vecteur source, qui doit rester valide jusqu'à la fin de
+ *   la requête.
+ * @param[out] b le vecteur cible.
+ */
+void matvec_server_submit(matvec_server_t* S,
+                          matvec_request_t* r,
+                          const float x[],
+                                float b[]);
+
+/**
+ * Attente de la fin d'une requête.
+ *
+ * @param[in] S le serveur.
+ * @param[in] r la requête.
+ */
+void matvec_server_wait(matvec_server_t* S, matvec_request_t* r);
+
+/**
+ * Multiplication matrice-vecteur synchrone : soumission puis attente.
+ *
+ * @param[in]  S le serveur.
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ */
+void matvec_server_matvec(matvec_server_t* S, const float x[], float b[]);
+
+/**
+ * Statistiques du serveur.
+ *
+ * @param[in]  S le serveur.
+ * @param[out] batches le nombre de lots traités.
+ * @param[out] requests le nombre de requêtes traitées.
+ */
+void matvec_server_stats(matvec_server_t* S,
+                         unsigned long* batches,
+                         unsigned long* requests);
+
+#endif
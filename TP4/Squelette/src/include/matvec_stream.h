@@ -0,0 +1,44 @@
+#ifndef MATVEC_STREAM_H
+#define MATVEC_STREAM_H
+
+#include <sys/types.h>
+
+/**
+ * Mesures effectuées lors d'un produit en flux.
+ */
+typedef struct {
+  double total;   // Durée totale du produit (en secondes).
+  double io;      // Durée cumulée des lectures (thread d'entrées-sorties).
+  double compute; // Durée cumulée des calculs (thread appelant).
+  double overlap; // Pourcentage de la plus courte des deux activités
+                  // recouvert par l'autre : 100 * (io + compute - total) /
+                  // min(io, compute).
+} matvec_stream_stats_t;
+
+/**
+ * Multiplication matrice-vecteur d'une matrice lue dans un fichier, par
+ * panneaux de lignes et en double tampon : pendant que le noyau SSE (celui de
+ * @c sgemv) traite le panneau courant, un thread d'entrées-sorties lit le
+ * panneau suivant à l'aide de @c pread dans le second tampon.
+ *
+ * @param[in]  fd le descripteur du fichier, ouvert en lecture.
+ * @param[in]  offset la position (en octets) de la matrice dans le fichier,
+ *   celle-ci y étant stockée ligne par ligne sous forme de floats.
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @param[in]  size la longueur de nos vecteurs.
+ * @param[in]  panel le nombre de lignes par panneau (0 : panneaux d'environ
+ *   1 Mo).
+ * @param[out] stats les mesures effectuées (éventuellement @c NULL).
+ * @return 0 en cas de succès (immédiat si size est nul), -1 si la lecture du
+ *   fichier, l'allocation des tampons ou la création du thread a échoué.
+ */
+int matvec_stream(const int fd,
+                  const off_t offset,
+                  const float x[],
+                        float b[],
+                  const unsigned size,
+                  const unsigned panel,
+                  matvec_stream_stats_t* stats);
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef MATVEC_TUNE_H
+#define MATVEC_TUNE_H
+
+#include "matvec_param.h"
+
+/**
+ * Chemin par défaut du fichier de tuning. La génération cmake le fixe au
+ * fichier écrit par la cible autotune ; à défaut, il est relatif au
+ * répertoire courant.
+ */
+#ifndef MATVEC_TUNE_DEFAULT
+#define MATVEC_TUNE_DEFAULT "matvec.tune"
+#endif
+
+/**
+ * Noyaux candidats à l'autotuning.
+ */
+typedef enum {
+  MATVEC_RAW,    // matvec.
+  MATVEC_R4,     // matvec_r4.
+  MATVEC_SSE_R4, // matvec_sse_r4.
+  MATVEC_SGEMV,  // sgemv (alpha = 1, beta = 0).
+  MATVEC_FIXED,  // matvec_fixed (noyaux spécialisés à la compilation).
+  MATVEC_PARAM,  // matvec_param, avec les paramètres associés.
+  MATVEC_KERNELS // Nombre de noyaux.
+} matvec_kernel_t;
+
+/**
+ * Configuration retenue pour une taille de problème donnée. Chaque
+ * configuration occupe une ligne du fichier de tuning, sous la forme :
+ * @code
+ * size kernel unroll rows prefetch threads gflops
+ * @endcode
+ * les lignes commençant par @c # étant ignorées.
+ */
+typedef struct {
+  unsigned        size;   // La longueur des vecteurs.
+  matvec_kernel_t kernel; // Le noyau retenu.
+  matvec_param_t  param;  // Ses paramètres (noyau MATVEC_PARAM uniquement).
+  double          gflops; // La performance mesurée en GFLOP/s.
+} matvec_tuning_t;
+
+/**
+ * Évalue l'ensemble des noyaux et de leurs paramètres (déroulage, nombre de
+ * lignes par bloc, distance de préchargement, nombre de threads) pour chacune
+ * des tailles fournies, puis écrit la meilleure configuration de chaque taille
+ * dans un fichier de tuning.
+ *
+ * @param[in] path le chemin du fichier de tuning à écrire.
+ * @param[in] sizes les tailles de problème à évaluer (multiples de 4).
+ * @param[in] count le nombre de tailles.
+ * @param[in] verbose si non nul, chaque mesure est affichée sur la sortie
+ *   standard.
+ * @return 0 en cas de succès, -1 si le fichier n'a pu être écrit.
+ */
+int matvec_tune(const char* path,
+                const unsigned sizes[],
+                const unsigned count,
+                const int verbose);
+
+/**
+ * Charge un fichier de tuning et en fait la table utilisée par
+ * @c matvec_tuned.
+ *
+ * @param[in] path le chemin du fichier de tuning.
+ * @return 0 en cas de succès, -1 si le fichier n'a pu être lu.
+ *
+ * @note cette routine n'est pas thread-safe : elle doit être appelée avant
+ *   tout appel concurrent à @c matvec_tuned, ou à @c matvec_tune_load.
+ */
+int matvec_tune_load(const char* path);
+
+/**
+ * Recherche la configuration de la table dont la taille est la plus proche
+ * (en échelle logarithmique) de celle fournie.
+ *
+ * @param[in] size la longueur des vecteurs.
+ * @return la configuration retenue ; @c matvec_sse_r4 à défaut de table.
+ */
+matvec_tuning_t matvec_tune_lookup(const unsigned size);
+
+/**
+ * Multiplication matrice-vecteur déléguée au noyau désigné par la table de
+ * tuning pour la taille considérée. Si aucune table n'a été chargée, le
+ * fichier désigné par la variable d'environnement @c MATVEC_TUNE_FILE (à
+ * défaut @c MATVEC_TUNE_DEFAULT) est chargé lors du premier appel ; ce
+ * chargement est effectué une seule fois (pthread_once) même si plusieurs
+ * threads appellent simultanément cette routine.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ * @param[in]  size la longueur de nos vecteurs.
+ *
+ * @note la longueur des vecteurs doit obligatoirement être un multiple de 4
+ *   et les trois tableaux alignés sur 16 octets.
+ */
+void matvec_tuned(const float A[restrict],
+                  const float x[restrict],
+                        float b[restrict],
+                  const unsigned size);
+
+#endif
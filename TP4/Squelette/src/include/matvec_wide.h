@@ -0,0 +1,76 @@
+#ifndef MATVEC_WIDE_H
+#define MATVEC_WIDE_H
+
+/**
+ * Répartitions du travail entre les threads.
+ */
+typedef enum {
+  MATVEC_SPLIT_ROWS, // Chaque thread calcule un groupe de composantes de b.
+  MATVEC_SPLIT_COLS  // Chaque thread traite une tranche de colonnes de A.
+} matvec_split_t;
+
+/**
+ * Choix de la répartition pour une matrice rows x cols et un nombre de
+ * threads donné. Le coût de la répartition par lignes est celui du thread le
+ * plus chargé (les lignes étant distribuées par groupes de 4) ; celui de la
+ * répartition par colonnes ajoute à une part équitable de la matrice
+ * l'écriture puis la réduction des vecteurs partiels, en
+ * ceil(log2(threads)) étapes de rows additions. Les tranches de colonnes
+ * trop étroites (moins de 64 colonnes par thread) sont écartées.
+ *
+ * @param[in] rows le nombre de lignes.
+ * @param[in] cols le nombre de colonnes.
+ * @param[in] threads le nombre de threads.
+ * @return la répartition la moins coûteuse.
+ */
+matvec_split_t matvec_wide_split(const unsigned rows,
+                                 const unsigned cols,
+                                 const unsigned threads);
+
+/**
+ * Multiplication matrice-vecteur b = A.x d'une matrice rectangulaire,
+ * stockée ligne par ligne, selon une répartition donnée. Le noyau SSE traite
+ * quatre lignes simultanément afin de réutiliser chaque chargement de x.
+ *
+ * Avec @c MATVEC_SPLIT_COLS, chaque thread calcule le produit de sa tranche
+ * de colonnes dans un vecteur partiel de rows composantes, qui lui est
+ * propre ; ces vecteurs sont espacés d'un multiple de 64 octets afin
+ * qu'aucune ligne de cache ne soit partagée entre deux threads. Les vecteurs
+ * partiels sont ensuite sommés deux à deux selon un arbre binaire, les
+ * threads se synchronisant entre deux niveaux, et le dernier niveau est
+ * écrit dans b.
+ *
+ * @param[in]  A la matrice (dépliée en tableau, ligne par ligne).
+ * @param[in]  x le vecteur source (cols composantes).
+ * @param[out] b le vecteur cible (rows composantes).
+ * @param[in]  rows le nombre de lignes.
+ * @param[in]  cols le nombre de colonnes.
+ * @param[in]  split la répartition.
+ *
+ * @note aucune contrainte d'alignement ni de longueur n'est imposée.
+ */
+void matvec_wide_by(const float A[restrict],
+                    const float x[restrict],
+                          float b[restrict],
+                    const unsigned rows,
+                    const unsigned cols,
+                    const matvec_split_t split);
+
+/**
+ * Multiplication matrice-vecteur b = A.x d'une matrice rectangulaire, selon
+ * la répartition choisie par @c matvec_wide_split pour le nombre de threads
+ * OpenMP disponibles.
+ *
+ * @param[in]  A la matrice (dépliée en tableau, ligne par ligne).
+ * @param[in]  x le vecteur source (cols composantes).
+ * @param[out] b le vecteur cible (rows composantes).
+ * @param[in]  rows le nombre de lignes.
+ * @param[in]  cols le nombre de colonnes.
+ */
+void matvec_wide(const float A[restrict],
+                 const float x[restrict],
+                       float b[restrict],
+                 const unsigned rows,
+                 const unsigned cols);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef MTX_H
+#define MTX_H
+
+#include "csr.h"
+
+/**
+ * Chargement d'une matrice sous forme CSR. Le fichier peut être :
+ *  - un fichier Matrix Market (.mtx) de type « matrix coordinate » ou
+ *    « matrix array », à valeurs « real », « double », « integer » ou
+ *    « pattern » (coordinate uniquement), « general », « symmetric » ou
+ *    « skew-symmetric » (les éléments symétriques étant alors développés) ;
+ *  - un fichier cache écrit par @c mtx_save_csr ou @c mtx_save_dense.
+ * Le fichier est projeté en mémoire (mmap), puis découpé en autant de
+ * tranches que de threads OpenMP, aux frontières de lignes ; chaque thread
+ * compte puis analyse les éléments de sa tranche à l'aide d'un analyseur
+ * numérique dédié, et la matrice CSR est construite en parallèle.
+ *
+ * @param[in] path le chemin du fichier.
+ * @return la matrice, ou @c NULL si le fichier est illisible, mal formé ou
+ *   d'un type non pris en charge (complex, hermitian).
+ *
+ * @note les lignes de la matrice obtenue sont triées par colonnes
+ *   croissantes ; les éléments figurant plusieurs fois (doublons d'un
+ *   fichier « coordinate », ou élément et symétrique tous deux présents
+ *   dans un fichier « symmetric ») sont fusionnés, leurs valeurs
+ *   s'ajoutant, conformément à la convention Matrix Market.
+ */
+csr_t* mtx_load_csr(const char* path);
+
+/**
+ * Chargement d'une matrice sous forme dense, dans les mêmes conditions que
+ * @c mtx_load_csr (les doublons étant de même additionnés).
+ *
+ * @param[in]  path le chemin du fichier.
+ * @param[out] rows le nombre de lignes.
+ * @param[out] cols le nombre de colonnes.
+ * @return la matrice (dépliée en tableau ligne par ligne, alignée sur 16
+ *   octets, à libérer par @c free), ou @c NULL en cas d'erreur.
+ */
+float* mtx_load_dense(const char* path, unsigned* rows, unsigned* cols);
+
+/**
+ * Écriture d'une matrice CSR dans un fichier cache binaire, relu sans
+ * analyse par @c mtx_load_csr et @c mtx_load_dense.
+ *
+ * @param[in] C la matrice.
+ * @param[in] path le chemin du fichier.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'écriture.
+ *
+ * @note le format est natif (boutisme et taille de @c size_t de la machine) :
+ *   il s'agit d'un cache, non d'un format d'échange.
+ */
+int mtx_save_csr(const csr_t* C, const char* path);
+
+/**
+ * Écriture d'une matrice dense dans un fichier cache binaire.
+ *
+ * @param[in] A la matrice (dépliée en tableau ligne par ligne).
+ * @param[in] rows le nombre de lignes.
+ * @param[in] cols le nombre de colonnes.
+ * @param[in] path le chemin du fichier.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'écriture.
+ */
+int mtx_save_dense(const float A[],
+                   const unsigned rows,
+                   const unsigned cols,
+                   const char* path);
+
+#endif
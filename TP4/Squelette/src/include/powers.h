@@ -0,0 +1,117 @@
+#ifndef POWERS_H
+#define POWERS_H
+
+#include "csr.h"
+
+/**
+ * Plan de calcul des puissances A x, A^2 x, ..., A^k x d'une matrice creuse
+ * carrée (noyau "matrix powers"). Les lignes sont découpées en tuiles de
+ * lignes consécutives ; pour que chaque tuile puisse calculer ses k niveaux
+ * sans attendre les autres, elle calcule aussi, de manière redondante, les
+ * lignes fantômes dont ses propres lignes dépendent :
+ *  - au niveau k, les lignes de la tuile, notées S_k ;
+ *  - au niveau j < k, S_j = S_{j+1} augmenté des colonnes des lignes de
+ *    S_{j+1}, S_0 désignant les composantes de x utilisées.
+ * Les lignes de S_0 sont renumérotées localement, S_k puis les lignes
+ * ajoutées à chaque niveau, si bien que chaque S_j en est un préfixe, et
+ * les lignes de S_1 sont recopiées (au format CSR) avec leurs colonnes
+ * traduites dans cette numérotation : les k niveaux d'une tuile lisent
+ * ainsi des données contiguës, la copie n'étant lue en mémoire centrale
+ * qu'au premier niveau.
+ */
+typedef struct {
+  unsigned k;         // La puissance maximale.
+  unsigned tiles;     // Le nombre de tuiles.
+  unsigned scratch;   // Taille maximale de S_0 sur l'ensemble des tuiles.
+  size_t* offset;     // Début des lignes de chaque tuile dans rows
+                      // (tiles + 1 entrées).
+  unsigned* rows;     // Lignes (globales) de S_0, pour chaque tuile.
+  unsigned* count;    // Taille de S_j pour chaque tuile et chaque niveau
+                      // (tiles * (k + 1) entrées, count[t * (k + 1) + j]).
+  size_t* lbase;      // Début des lignes de S_1 de chaque tuile dans lptr
+                      // (tiles + 1 entrées).
+  size_t* lptr;       // Début des colonnes locales de chaque ligne de S_1.
+  unsigned* lcol;     // Colonnes locales des lignes de S_1.
+  float* lval;        // Valeurs des lignes de S_1.
+  double redundancy;  // Nombre de lignes calculées rapporté à k * rows.
+  unsigned threads;   // Nombre maximal de threads de powers_csr.
+  size_t stride;      // Taille (en floats) d'un tampon de thread.
+  float* buffer;      // Tampons des threads : deux par thread, alloués une
+                      // fois pour toutes.
+} powers_t;
+
+/**
+ * Analyse d'une matrice creuse carrée : construction des tuiles et de leurs
+ * lignes fantômes. Le plan peut être réutilisé pour tout vecteur x tant
+ * que la matrice ne change pas (il contient une copie de ses valeurs).
+ *
+ * @param[in] C la matrice.
+ * @param[in] k la puissance maximale (au moins 1).
+ * @param[in] tile le nombre de lignes par tuile (0 : 4096). Les lignes
+ *   fantômes d'une tuile s'étendant sur k fois la largeur de bande de part
+ *   et d'autre, une tuile doit être nettement plus haute que cette
+ *   largeur pour que la redondance reste faible.
+ * @return le plan, ou @c NULL si la matrice n'est pas carrée ou si k est
+ *   nul.
+ *
+ * @note les tampons du plan sont utilisés par @c powers_csr : deux calculs
+ *   simultanés doivent utiliser des plans distincts.
+ */
+powers_t* powers_create(const csr_t* C, const unsigned k, const unsigned tile);
+
+/**
+ * Destruction d'un plan.
+ *
+ * @param[in] P le plan (éventuellement @c NULL).
+ */
+void powers_free(powers_t* P);
+
+/**
+ * Calcul des puissances V_j = A^j x, j = 1 à k, d'une matrice creuse. Les
+ * tuiles sont réparties entre les threads OpenMP (au plus autant qu'à la
+ * création du plan) ; chacune rassemble les composantes de x qu'elle
+ * utilise puis calcule ses k niveaux dans deux tampons du plan, qui restent
+ * en cache, la copie locale de ses lignes y restant également si la tuile
+ * est assez petite : la matrice n'est lue qu'environ une fois en mémoire
+ * centrale au lieu de k. Chaque ligne est sommée dans le même ordre que par
+ * @c csr_matvec : les résultats sont identiques bit à bit à ceux de k
+ * produits successifs.
+ *
+ * @param[in]  P le plan, construit pour la structure de C.
+ * @param[in]  C la matrice (seule sa dimension est lue, ses valeurs étant
+ *   copiées dans le plan).
+ * @param[in]  x le vecteur source.
+ * @param[out] V les k vecteurs résultats, mis bout à bout (V_j commence à
+ *   la position (j - 1) * rows).
+ */
+void powers_csr(const powers_t* P,
+                const csr_t* C,
+                const float x[restrict],
+                      float V[restrict]);
+
+/**
+ * Calcul des puissances V_j = A^j x, j = 1 à k, d'une matrice dense. Chaque
+ * niveau dépendant de la totalité du précédent, la matrice est relue à
+ * chaque niveau ; les niveaux successifs la parcourent toutefois en sens
+ * alternés (les lignes étant distribuées statiquement entre les threads, un
+ * thread reprend sa propre tranche là où il l'a quittée), si bien que les
+ * dernières lignes lues par un niveau, encore en cache, sont les premières
+ * relues par le suivant.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  x le vecteur source.
+ * @param[out] V les k vecteurs résultats, mis bout à bout.
+ * @param[in]  size la longueur de nos vecteurs.
+ * @param[in]  k la puissance maximale.
+ *
+ * @note aucune contrainte d'alignement ni de longueur n'est imposée ; pour
+ *   une longueur multiple de 4, chaque niveau est identique bit à bit au
+ *   résultat de @c matvec_sse_r4.
+ */
+void powers_dense(const float A[restrict],
+                  const float x[restrict],
+                        float V[restrict],
+                  const unsigned size,
+                  const unsigned k);
+
+#endif
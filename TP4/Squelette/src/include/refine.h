@@ -0,0 +1,109 @@
+#ifndef REFINE_H
+#define REFINE_H
+
+/**
+ * Mesures effectuées lors d'une résolution.
+ */
+typedef struct {
+  unsigned iterations; // Nombre de corrections appliquées.
+  double error;        // Erreur inverse finale ||b - Ax|| / (||A|| ||x||
+                       // + ||b||), en norme infinie.
+  int fallback;        // Non nul si le raffinement n'a pas convergé et que
+                       // le système a été résolu en double précision.
+} refine_stats_t;
+
+/**
+ * Factorisation LU en simple précision, avec pivotage partiel, de la matrice
+ * A (PA = LU). Les mises à jour de la sous-matrice restante utilisent le jeu
+ * d'instructions SSE, ses lignes étant réparties entre les threads OpenMP.
+ *
+ * @param[in,out] A la matrice (dépliée en tableau), remplacée par L (sous la
+ *   diagonale, diagonale unité implicite) et U.
+ * @param[out] piv les pivots : la ligne k a été échangée avec la ligne
+ *   piv[k].
+ * @param[in] n la longueur de nos vecteurs.
+ * @return 0 en cas de succès, -1 si la matrice est singulière.
+ */
+int refine_lu_f(float A[], unsigned piv[], const unsigned n);
+
+/**
+ * Résolution en simple précision à partir d'une factorisation LU.
+ *
+ * @param[in]     LU la factorisation obtenue par @c refine_lu_f.
+ * @param[in]     piv les pivots.
+ * @param[in,out] x le second membre, remplacé par la solution.
+ * @param[in]     n la longueur de nos vecteurs.
+ */
+void refine_solve_f(const float LU[],
+                    const unsigned piv[],
+                          float x[],
+                    const unsigned n);
+
+/**
+ * Factorisation LU en double précision (mêmes conventions que
+ * @c refine_lu_f).
+ *
+ * @param[in,out] A la matrice, remplacée par sa factorisation.
+ * @param[out]    piv les pivots.
+ * @param[in]     n la longueur de nos vecteurs.
+ * @return 0 en cas de succès, -1 si la matrice est singulière.
+ */
+int refine_lu_d(double A[], unsigned piv[], const unsigned n);
+
+/**
+ * Résolution en double précision à partir d'une factorisation LU.
+ *
+ * @param[in]     LU la factorisation obtenue par @c refine_lu_d.
+ * @param[in]     piv les pivots.
+ * @param[in,out] x le second membre, remplacé par la solution.
+ * @param[in]     n la longueur de nos vecteurs.
+ */
+void refine_solve_d(const double LU[],
+                    const unsigned piv[],
+                          double x[],
+                    const unsigned n);
+
+/**
+ * Résolution du système Ax = b par raffinement itératif en précision mixte :
+ * A est factorisée en simple précision, puis la solution est corrigée en
+ * calculant le résidu r = b - Ax en double précision et en résolvant
+ * Ad = r à l'aide de la factorisation simple précision. Le raffinement
+ * s'arrête dès que ||r|| <= ||A|| ||x|| sqrt(n) eps (eps étant la précision
+ * du type double), ce qui donne une solution de qualité double précision
+ * pour un coût proche de celui d'une résolution en simple précision. S'il
+ * ne converge pas en iters corrections (matrice trop mal conditionnée pour
+ * la simple précision), le système est résolu en double précision.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  b le second membre.
+ * @param[out] x la solution.
+ * @param[in]  n la longueur de nos vecteurs.
+ * @param[in]  iters le nombre maximal de corrections.
+ * @param[out] stats les mesures effectuées (éventuellement @c NULL).
+ * @return 0 en cas de succès, -1 si la matrice est singulière.
+ */
+int refine_solve(const double A[],
+                 const double b[],
+                       double x[],
+                 const unsigned n,
+                 const unsigned iters,
+                 refine_stats_t* stats);
+
+/**
+ * Résolution du système Ax = b entièrement en double précision, servant de
+ * référence.
+ *
+ * @param[in]  A la matrice (dépliée en tableau).
+ * @param[in]  b le second membre.
+ * @param[out] x la solution.
+ * @param[in]  n la longueur de nos vecteurs.
+ * @param[out] stats les mesures effectuées (éventuellement @c NULL).
+ * @return 0 en cas de succès, -1 si la matrice est singulière.
+ */
+int refine_direct(const double A[],
+                  const double b[],
+                        double x[],
+                  const unsigned n,
+                  refine_stats_t* stats);
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "csr.h"
+
+/**
+ * Méthodes de renumérotation.
+ */
+typedef enum {
+  REORDER_RCM,    // Cuthill-McKee inverse : réduction de la largeur de bande.
+  REORDER_DEGREE, // Sommets par degrés croissants.
+  REORDER_ROWS    // Lignes par longueurs décroissantes.
+} reorder_method_t;
+
+/**
+ * Calcul d'une permutation symétrique des lignes et colonnes d'une matrice
+ * creuse carrée. Pour les méthodes @c REORDER_RCM et @c REORDER_DEGREE, la
+ * matrice est vue comme le graphe (non orienté) de la structure de A + A^T :
+ *  - @c REORDER_RCM parcourt en largeur chaque composante connexe depuis un
+ *    sommet pseudo-périphérique (algorithme de George et Liu), en visitant
+ *    les voisins par degrés croissants, puis inverse l'ordre obtenu ; les
+ *    éléments non nuls se concentrent alors près de la diagonale, et les
+ *    accès à x d'un produit deviennent quasi séquentiels ;
+ *  - @c REORDER_DEGREE trie les sommets par degrés croissants ;
+ *  - @c REORDER_ROWS trie les lignes par nombres d'éléments décroissants,
+ *    regroupant les lignes de longueurs voisines.
+ * Les tris sont stables.
+ *
+ * @param[in] C la matrice.
+ * @param[in] method la méthode.
+ * @return la permutation perm (la nouvelle ligne k est l'ancienne ligne
+ *   perm[k]), à libérer par @c free, ou @c NULL si la matrice n'est pas
+ *   carrée.
+ */
+unsigned* reorder_compute(const csr_t* C, const reorder_method_t method);
+
+/**
+ * Application d'une permutation symétrique : construction de P.C.P^T, dont
+ * l'élément (k, l) est l'élément (perm[k], perm[l]) de C.
+ *
+ * @param[in] C la matrice.
+ * @param[in] perm la permutation.
+ * @return la matrice permutée, dont les lignes sont triées par colonnes.
+ */
+csr_t* reorder_apply(const csr_t* C, const unsigned perm[]);
+
+/**
+ * Permutation d'un vecteur : y[k] = x[perm[k]].
+ *
+ * @param[in]  perm la permutation.
+ * @param[in]  x le vecteur dans la numérotation d'origine.
+ * @param[out] y le vecteur dans la nouvelle numérotation.
+ * @param[in]  n la longueur des vecteurs.
+ */
+void reorder_gather(const unsigned perm[],
+                    const float x[restrict],
+                          float y[restrict],
+                    const unsigned n);
+
+/**
+ * Permutation inverse d'un vecteur : x[perm[k]] = y[k].
+ *
+ * @param[in]  perm la permutation.
+ * @param[in]  y le vecteur dans la nouvelle numérotation.
+ * @param[out] x le vecteur dans la numérotation d'origine.
+ * @param[in]  n la longueur des vecteurs.
+ */
+void reorder_scatter(const unsigned perm[],
+                     const float y[restrict],
+                           float x[restrict],
+                     const unsigned n);
+
+/**
+ * Largeur de bande d'une matrice : max |i - j| sur ses éléments non nuls.
+ *
+ * @param[in] C la matrice.
+ * @return la largeur de bande.
+ */
+size_t reorder_bandwidth(const csr_t* C);
+
+/**
+ * Profil (ou enveloppe) d'une matrice : somme sur les lignes i de i - f(i),
+ * où f(i) est la plus petite colonne non nulle de la ligne i si elle est
+ * inférieure à i (0 sinon).
+ *
+ * @param[in] C la matrice.
+ * @return le profil.
+ */
+size_t reorder_profile(const csr_t* C);
+
+#endif
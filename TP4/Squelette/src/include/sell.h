@@ -0,0 +1,80 @@
+#ifndef SELL_H
+#define SELL_H
+
+#include "csr.h"
+
+/**
+ * Hauteur des tranches (nombre de couloirs d'un registre SSE).
+ */
+#define SELL_C 4
+
+/**
+ * Matrice creuse au format SELL-C-sigma (Sliced ELLPACK) : les lignes sont
+ * regroupées par tranches de @c SELL_C lignes, chaque tranche étant stockée
+ * colonne par colonne et complétée par des zéros jusqu'à la longueur de sa
+ * plus longue ligne. L'élément k de la ligne l (0 <= l < @c SELL_C) de la
+ * tranche s occupe la position ptr[s] + k * SELL_C + l des tableaux col et
+ * val : un registre SSE couvre ainsi un élément de chacune des lignes de la
+ * tranche.
+ *
+ * Afin de limiter le remplissage, les lignes sont au préalable triées par
+ * longueurs décroissantes au sein de fenêtres de sigma lignes consécutives
+ * (ce qui préserve en grande partie la localité des accès à x) : la ligne
+ * permutée r est la ligne perm[r] de la matrice d'origine.
+ */
+typedef struct {
+  unsigned rows;    // Le nombre de lignes.
+  unsigned cols;    // Le nombre de colonnes.
+  unsigned sigma;   // La taille des fenêtres de tri.
+  unsigned slices;  // Le nombre de tranches.
+  size_t nnz;       // Le nombre d'éléments non nuls.
+  size_t stored;    // Le nombre d'éléments stockés, remplissage compris.
+  size_t* ptr;      // Début de chaque tranche (slices + 1 entrées).
+  unsigned* perm;   // Ligne d'origine de chaque ligne permutée (slices *
+                    // SELL_C entrées, les dernières pouvant valoir rows).
+  unsigned* len;    // Longueur de chaque ligne permutée (slices * SELL_C
+                    // entrées), au-delà de laquelle le remplissage est masqué.
+  unsigned* col;    // Colonne de chaque élément (dernière colonne de la ligne
+                    // pour le remplissage).
+  float* val;       // Valeur de chaque élément, alignées sur 16 octets.
+} sell_t;
+
+/**
+ * Conversion d'une matrice CSR au format SELL-C-sigma.
+ *
+ * @param[in] C la matrice CSR.
+ * @param[in] sigma la taille des fenêtres de tri (1 : pas de tri ; elle est
+ *   arrondie au multiple de @c SELL_C supérieur).
+ * @return la matrice SELL.
+ */
+sell_t* sell_from_csr(const csr_t* C, const unsigned sigma);
+
+/**
+ * Nombre d'éléments que stockerait une conversion au format SELL-C-sigma,
+ * sans la réaliser.
+ *
+ * @param[in] C la matrice CSR.
+ * @param[in] sigma la taille des fenêtres de tri.
+ * @return le nombre d'éléments stockés, remplissage compris.
+ */
+size_t sell_stored(const csr_t* C, const unsigned sigma);
+
+/**
+ * Destruction d'une matrice SELL.
+ *
+ * @param[in] S la matrice (éventuellement @c NULL).
+ */
+void sell_free(sell_t* S);
+
+/**
+ * Multiplication matrice creuse-vecteur b = S.x : chaque tranche est
+ * calculée dans un registre SSE, les éléments de x étant rassemblés couloir
+ * par couloir. Les tranches sont réparties entre les threads OpenMP.
+ *
+ * @param[in]  S la matrice SELL.
+ * @param[in]  x le vecteur source (cols composantes).
+ * @param[out] b le vecteur cible (rows composantes).
+ */
+void sell_matvec(const sell_t* S, const float x[restrict], float b[restrict]);
+
+#endif
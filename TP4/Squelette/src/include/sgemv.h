@@ -0,0 +1,64 @@
+#ifndef SGEMV_H
+#define SGEMV_H
+
+/**
+ * Ordre de stockage de la matrice (les valeurs sont celles de CBLAS afin de
+ * faciliter le remplacement d'un appel à @c cblas_sgemv).
+ */
+enum sgemv_order {
+  SGEMV_ROW_MAJOR = 101, // Matrice stockée ligne par ligne.
+  SGEMV_COL_MAJOR = 102  // Matrice stockée colonne par colonne.
+};
+
+/**
+ * Opération à appliquer à la matrice avant le produit.
+ */
+enum sgemv_trans {
+  SGEMV_NO_TRANS = 111, // b = alpha * A * x + beta * b.
+  SGEMV_TRANS    = 112  // b = alpha * A^T * x + beta * b.
+};
+
+/**
+ * Multiplication matrice-vecteur généralisée avec la même sémantique que la
+ * routine BLAS @c sgemv : b = alpha * op(A) * x + beta * b.
+ *
+ * Contrairement à un appel à @c matvec suivi d'une passe de mise à l'échelle
+ * sur b, les facteurs alpha et beta sont appliqués directement par les noyaux
+ * SSE au moment où chaque composante de b est produite, si bien que b n'est
+ * parcouru qu'une seule fois.
+ *
+ * @param[in]     order l'ordre de stockage de la matrice A.
+ * @param[in]     trans l'opération op() appliquée à A.
+ * @param[in]     m le nombre de lignes de A.
+ * @param[in]     n le nombre de colonnes de A.
+ * @param[in]     alpha le facteur appliqué au produit op(A) * x.
+ * @param[in]     A la matrice (dépliée en tableau).
+ * @param[in]     lda la dimension principale de A (distance en éléments entre
+ *   deux lignes si @c order vaut @c SGEMV_ROW_MAJOR, entre deux colonnes
+ *   sinon).
+ * @param[in]     x le vecteur source.
+ * @param[in]     incx le pas entre deux composantes de x (éventuellement
+ *   négatif, auquel cas x est parcouru à rebours comme en BLAS).
+ * @param[in]     beta le facteur appliqué à b avant accumulation. Lorsqu'il
+ *   est nul, b n'est pas lu (il peut donc contenir des valeurs quelconques).
+ * @param[in,out] b le vecteur cible.
+ * @param[in]     incb le pas entre deux composantes de b (non nul).
+ *
+ * @note aucune contrainte d'alignement ni de longueur multiple de 4 n'est
+ *   imposée : les noyaux utilisent des chargements non alignés et traitent
+ *   les éléments résiduels sous forme scalaire.
+ */
+void sgemv(const enum sgemv_order order,
+           const enum sgemv_trans trans,
+           const int m,
+           const int n,
+           const float alpha,
+           const float A[],
+           const int lda,
+           const float x[],
+           const int incx,
+           const float beta,
+                 float b[],
+           const int incb);
+
+#endif
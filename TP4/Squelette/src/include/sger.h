@@ -0,0 +1,92 @@
+#ifndef SGER_H
+#define SGER_H
+
+/**
+ * Nombre de colonnes des blocs de @c sger_k.
+ */
+#define SGER_BLOCK 512
+
+/**
+ * Mise à jour de rang 1 d'une matrice carrée (routine BLAS @c sger) :
+ * A = A + alpha * u * v^T. Chaque ligne i reçoit (alpha * u[i]) * v, avec le
+ * jeu d'instructions SSE ; les lignes sont réparties entre les threads
+ * OpenMP.
+ *
+ * @param[in,out] A la matrice (dépliée en tableau).
+ * @param[in]     size la longueur de nos vecteurs.
+ * @param[in]     alpha le facteur de la mise à jour.
+ * @param[in]     u le vecteur colonne.
+ * @param[in]     v le vecteur ligne.
+ *
+ * @note aucune contrainte d'alignement ni de longueur n'est imposée.
+ */
+void sger(float A[],
+          const unsigned size,
+          const float alpha,
+          const float u[],
+          const float v[]);
+
+/**
+ * Mise à jour symétrique de rang 1 (routine BLAS @c ssyr, matrice stockée
+ * entièrement) : A = A + alpha * u * u^T. L'élément (i, j) reçoit
+ * alpha * (u[i] * u[j]), le produit u[i] * u[j] étant commutatif : une
+ * matrice exactement symétrique le reste.
+ *
+ * @param[in,out] A la matrice (dépliée en tableau).
+ * @param[in]     size la longueur de nos vecteurs.
+ * @param[in]     alpha le facteur de la mise à jour.
+ * @param[in]     u le vecteur.
+ */
+void ssyr(float A[],
+          const unsigned size,
+          const float alpha,
+          const float u[]);
+
+/**
+ * Mise à jour de rang k : A = A + alpha * U * V^T, où U est une matrice
+ * size x k et V^T une matrice k x size (toutes deux dépliées ligne par
+ * ligne, comme les facteurs de @c lowrank_t). Les k mises à jour sont
+ * appliquées en une seule passe sur A : chaque groupe de quatre éléments
+ * d'une ligne est chargé une fois, reçoit les k contributions dans un
+ * registre, puis est écrit. Les colonnes sont traitées par blocs de
+ * @c SGER_BLOCK afin que le bloc correspondant de V^T reste en cache d'une
+ * ligne à l'autre.
+ *
+ * @param[in,out] A la matrice (dépliée en tableau).
+ * @param[in]     size la longueur de nos vecteurs.
+ * @param[in]     alpha le facteur de la mise à jour.
+ * @param[in]     U la matrice des vecteurs colonnes (size x k).
+ * @param[in]     Vt la matrice des vecteurs lignes (k x size).
+ * @param[in]     k le rang de la mise à jour.
+ */
+void sger_k(float A[],
+            const unsigned size,
+            const float alpha,
+            const float U[],
+            const float Vt[],
+            const unsigned k);
+
+/**
+ * Mise à jour de rang 1 suivie d'une multiplication matrice-vecteur,
+ * fusionnées : A = A + alpha * u * v^T, puis b = A * x (avec la matrice mise
+ * à jour). Chaque groupe de quatre éléments de A est chargé, mis à jour,
+ * écrit et multiplié par x sans quitter les registres : la matrice n'est
+ * parcourue qu'une fois, au lieu de deux pour @c sger suivi d'un produit.
+ *
+ * @param[in,out] A la matrice (dépliée en tableau).
+ * @param[in]     size la longueur de nos vecteurs.
+ * @param[in]     alpha le facteur de la mise à jour.
+ * @param[in]     u le vecteur colonne.
+ * @param[in]     v le vecteur ligne.
+ * @param[in]     x le vecteur source du produit.
+ * @param[out]    b le vecteur cible du produit.
+ */
+void sger_matvec(float A[],
+                 const unsigned size,
+                 const float alpha,
+                 const float u[],
+                 const float v[],
+                 const float x[],
+                       float b[]);
+
+#endif
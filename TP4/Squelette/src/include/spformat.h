@@ -0,0 +1,165 @@
+#ifndef SPFORMAT_H
+#define SPFORMAT_H
+
+#include "bsr.h"
+#include "csr.h"
+#include "sell.h"
+
+/**
+ * Formats de stockage candidats.
+ */
+typedef enum {
+  SPFORMAT_DENSE, // Matrice dense, produit par matvec_wide.
+  SPFORMAT_CSR,   // Matrice CSR, produit par csr_matvec.
+  SPFORMAT_SELL,  // Matrice SELL-C-sigma, produit par sell_matvec.
+  SPFORMAT_BSR    // Matrice BSR, produit par bsr_matvec.
+} spformat_kind_t;
+
+/**
+ * Nombre de formats candidats.
+ */
+#define SPFORMAT_KINDS 4
+
+/**
+ * Taille des fenêtres de tri du format SELL.
+ */
+#define SPFORMAT_SIGMA 128
+
+/**
+ * Nombre de colonnes au-delà duquel les accès à x sont considérés comme
+ * lointains : lorsque la largeur de bande (ou, si elle est inférieure, le
+ * nombre de colonnes) le dépasse, la portion de x lue par des lignes
+ * voisines n'est plus contenue dans le cache.
+ */
+#define SPFORMAT_NEAR (1u << 20)
+
+/**
+ * Taille maximale (en octets) d'une matrice convertie au format dense.
+ */
+#define SPFORMAT_DENSE_MAX (1ul << 30)
+
+/**
+ * Modèle de coût : durée d'un produit par élément lu, pour chaque format.
+ * Les formats creux distinguent accès proches ([0]) et lointains ([1]) à x.
+ */
+typedef struct {
+  double dense;                // Par élément de la matrice dense.
+  double csr[2];               // Par élément non nul.
+  double sell[2];              // Par élément stocké, remplissage compris.
+  double bsr[2][BSR_MAX + 1];  // Par élément stocké, pour chaque taille de
+                               // blocs (2, 3, 4 et 8).
+} spformat_model_t;
+
+/**
+ * Caractéristiques de la structure d'une matrice creuse.
+ */
+typedef struct {
+  unsigned rows;       // Le nombre de lignes.
+  unsigned cols;       // Le nombre de colonnes.
+  size_t nnz;          // Le nombre d'éléments non nuls.
+  double ratio;        // La proportion d'éléments non nuls.
+  double row_mean;     // La longueur moyenne des lignes.
+  double row_var;      // La variance des longueurs de lignes.
+  unsigned row_max;    // La longueur maximale des lignes.
+  unsigned bandwidth;  // La largeur de bande, max |i - j|.
+  unsigned bs;         // La taille de blocs retenue par bsr_detect (1 si
+                       // aucune n'est avantageuse).
+  double fill;         // Le taux de remplissage des blocs correspondant.
+  size_t sell_stored;  // Le nombre d'éléments stockés au format SELL.
+} spformat_stats_t;
+
+/**
+ * Matrice convertie dans le format dont le produit est prédit le plus
+ * rapide.
+ */
+typedef struct {
+  spformat_kind_t kind;                // Le format retenu.
+  spformat_stats_t stats;              // La structure de la matrice.
+  double predicted[SPFORMAT_KINDS];    // La durée prédite d'un produit pour
+                                       // chaque format (en secondes,
+                                       // HUGE_VAL s'il est écarté).
+  const csr_t* csr;                    // La matrice d'origine (non
+                                       // possédée), utilisée au format CSR.
+  float* dense;                        // La matrice au format dense.
+  sell_t* sell;                        // La matrice au format SELL.
+  bsr_t* bsr;                          // La matrice au format BSR.
+} spformat_t;
+
+/**
+ * Modèle de coût par défaut, mesuré sur la machine de développement (un
+ * thread).
+ *
+ * @param[out] M le modèle.
+ */
+void spformat_default(spformat_model_t* M);
+
+/**
+ * Calibrage du modèle de coût sur la machine courante, avec le nombre de
+ * threads OpenMP courant : chaque noyau est chronométré sur des matrices
+ * synthétiques (lignes de 16 éléments, blocs denses pour le format BSR)
+ * dont les accès à x sont proches puis lointains. Le calibrage dure de
+ * l'ordre de la seconde.
+ *
+ * @param[out] M le modèle.
+ */
+void spformat_calibrate(spformat_model_t* M);
+
+/**
+ * Analyse de la structure d'une matrice creuse.
+ *
+ * @param[in]  C la matrice.
+ * @param[out] S ses caractéristiques.
+ */
+void spformat_analyze(const csr_t* C, spformat_stats_t* S);
+
+/**
+ * Analyse d'une matrice, prédiction de la durée d'un produit dans chaque
+ * format (coefficient du modèle multiplié par le nombre d'éléments lus), puis
+ * conversion unique dans le format le plus rapide.
+ *
+ * @param[in] C la matrice, qui doit survivre au résultat si le format CSR
+ *   est retenu.
+ * @param[in] M le modèle de coût (@c NULL : le modèle par défaut).
+ * @return la matrice convertie.
+ */
+spformat_t* spformat_create(const csr_t* C, const spformat_model_t* M);
+
+/**
+ * Conversion d'une matrice dans un format imposé, sans prédiction (les
+ * durées prédites valent HUGE_VAL). Le format BSR utilise la taille de blocs
+ * retenue par bsr_detect, éventuellement 1.
+ *
+ * @param[in] C    la matrice, qui doit survivre au résultat si @p kind vaut
+ *   @c SPFORMAT_CSR.
+ * @param[in] kind le format.
+ * @return la matrice convertie.
+ */
+spformat_t* spformat_convert(const csr_t* C, const spformat_kind_t kind);
+
+/**
+ * Destruction d'une matrice convertie (la matrice d'origine est conservée).
+ *
+ * @param[in] F la matrice (éventuellement @c NULL).
+ */
+void spformat_free(spformat_t* F);
+
+/**
+ * Multiplication matrice-vecteur b = F.x avec le noyau du format retenu.
+ *
+ * @param[in]  F la matrice convertie.
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ */
+void spformat_matvec(const spformat_t* F,
+                     const float x[restrict],
+                           float b[restrict]);
+
+/**
+ * Nom d'un format, pour la journalisation.
+ *
+ * @param[in] kind le format.
+ * @return son nom.
+ */
+const char* spformat_name(const spformat_kind_t kind);
+
+#endif
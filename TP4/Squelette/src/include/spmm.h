@@ -0,0 +1,27 @@
+#ifndef SPMM_H
+#define SPMM_H
+
+#include "csr.h"
+
+/**
+ * Multiplication matrice creuse-multivecteur Y = C.X, où X (cols x k) et Y
+ * (rows x k) sont stockés ligne par ligne : les k composantes associées à
+ * une même ligne sont contiguës. Chaque élément non nul de C n'est lu
+ * qu'une fois depuis la mémoire et appliqué aux k vecteurs à l'aide du jeu
+ * d'instructions SSE, par paquets de 16 vecteurs conservés dans quatre
+ * registres, puis de 8 et de 4, les derniers étant traités ensemble. Les
+ * lignes sont réparties dynamiquement entre les threads OpenMP.
+ *
+ * @param[in]  C la matrice creuse.
+ * @param[in]  X le multivecteur source.
+ * @param[out] Y le multivecteur cible.
+ * @param[in]  k le nombre de vecteurs.
+ *
+ * @note aucune contrainte d'alignement n'est imposée.
+ */
+void spmm(const csr_t* C,
+          const float X[restrict],
+                float Y[restrict],
+          const unsigned k);
+
+#endif
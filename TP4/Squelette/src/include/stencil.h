@@ -0,0 +1,100 @@
+#ifndef STENCIL_H
+#define STENCIL_H
+
+/**
+ * Opérateur stencil à 5 points (grille 2D) ou 7 points (grille 3D) appliqué
+ * sans assembler la matrice. Les inconnues sont rangées selon l'ordre
+ * lexicographique i + nx * (j + ny * k), i étant l'axe de pas unitaire, et les
+ * voisins situés hors de la grille sont nuls (conditions de Dirichlet
+ * homogènes). Le produit calculé est donc celui de la matrice creuse
+ * habituellement assemblée pour ce stencil :
+ * @code
+ * b[i,j,k] = diag * x[i,j,k]
+ *          + cx * (x[i-1,j,k] + x[i+1,j,k])
+ *          + cy * (x[i,j-1,k] + x[i,j+1,k])
+ *          + cz * (x[i,j,k-1] + x[i,j,k+1])
+ * @endcode
+ * Le laplacien discret correspond à diag = 4 (resp. 6) et cx = cy = cz = -1.
+ */
+typedef struct {
+  unsigned nx, ny, nz; // Les dimensions de la grille (nz = 1 en 2D).
+  float diag;          // Le coefficient du point central.
+  float cx, cy, cz;    // Les coefficients des voisins selon chaque axe.
+  unsigned bx, by;     // La taille des blocs selon les axes i et j.
+  float* zero;         // Une ligne nulle, voisine des lignes du bord.
+} stencil_t;
+
+/**
+ * Création d'un opérateur stencil.
+ *
+ * @param[in] nx la dimension de la grille selon l'axe i (pas unitaire).
+ * @param[in] ny la dimension de la grille selon l'axe j.
+ * @param[in] nz la dimension de la grille selon l'axe k (1 pour une grille
+ *   2D, auquel cas cz est ignoré).
+ * @param[in] diag le coefficient du point central.
+ * @param[in] cx le coefficient des voisins selon l'axe i.
+ * @param[in] cy le coefficient des voisins selon l'axe j.
+ * @param[in] cz le coefficient des voisins selon l'axe k.
+ * @return l'opérateur, dont les tailles de blocs (champs @c bx et @c by)
+ *   peuvent être modifiées avant usage.
+ */
+stencil_t* stencil_create(const unsigned nx,
+                          const unsigned ny,
+                          const unsigned nz,
+                          const float diag,
+                          const float cx,
+                          const float cy,
+                          const float cz);
+
+/**
+ * Destruction d'un opérateur stencil.
+ *
+ * @param[in] S l'opérateur (éventuellement @c NULL).
+ */
+void stencil_free(stencil_t* S);
+
+/**
+ * Nombre d'inconnues de la grille, i.e. la longueur de nos vecteurs.
+ *
+ * @param[in] S l'opérateur.
+ * @return nx * ny * nz.
+ */
+unsigned stencil_size(const stencil_t* S);
+
+/**
+ * Nombre de coefficients non nuls de la matrice équivalente : le produit
+ * effectue 2 * nnz opérations flottantes au sens du produit dense.
+ *
+ * @param[in] S l'opérateur.
+ * @return le nombre de coefficients non nuls.
+ */
+unsigned long stencil_nnz(const stencil_t* S);
+
+/**
+ * Application de l'opérateur : b = S * x. Les plans k et les blocs de by
+ * lignes sont répartis entre les threads OpenMP ; à l'intérieur d'un bloc,
+ * les lignes sont parcourues par segments de bx composantes afin que les
+ * segments des lignes voisines restent en cache, et chaque segment est
+ * calculé avec le jeu d'instructions SSE le long de l'axe i.
+ *
+ * @param[in]  S l'opérateur.
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ *
+ * @note le mot-clé @c restrict indique qu'il n'existe aucun recouvrement entre
+ *   les zones mémoires associées aux deux vecteurs.
+ */
+void stencil_matvec(const stencil_t* S,
+                    const float x[restrict],
+                          float b[restrict]);
+
+/**
+ * Assemblage de la matrice dense équivalente, pour comparaison avec les
+ * noyaux @c matvec.
+ *
+ * @param[in]  S l'opérateur.
+ * @param[out] A la matrice (dépliée en tableau) de côté @c stencil_size(S).
+ */
+void stencil_assemble(const stencil_t* S, float A[]);
+
+#endif
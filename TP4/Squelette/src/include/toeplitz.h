@@ -0,0 +1,63 @@
+#ifndef TOEPLITZ_H
+#define TOEPLITZ_H
+
+#include "fft.h"
+
+/**
+ * Matrice de Toeplitz carrée, A[i][j] = t[i - j], représentée par son seul
+ * vecteur générateur. Le produit est calculé en O(n log n) en plongeant A dans
+ * une matrice circulante de taille L >= 2n - 1 (puissance de 2), diagonalisée
+ * par la transformée de Fourier : seul le spectre du générateur de cette
+ * matrice circulante est conservé.
+ */
+typedef struct {
+  unsigned size;   // La longueur n de nos vecteurs.
+  fft_t* fft;      // Le plan de transformée de longueur L.
+  float *vr, *vi;  // Spectre du générateur de la matrice circulante (L/2 + 1).
+  float *xr, *xi;  // Espace de travail : spectre du vecteur source.
+  float* work;     // Espace de travail : signal de longueur L.
+} toeplitz_t;
+
+/**
+ * Création d'une matrice de Toeplitz.
+ *
+ * @param[in] col la première colonne de la matrice (t[0], t[1], ... t[n-1]).
+ * @param[in] row la première ligne de la matrice (t[0], t[-1], ... t[1-n]),
+ *   dont le premier élément est ignoré.
+ * @param[in] size la longueur n de nos vecteurs (n >= 1).
+ * @return la matrice, ou @c NULL si size est nul ou si son allocation a
+ *   échoué.
+ */
+toeplitz_t* toeplitz_create(const float col[],
+                            const float row[],
+                            const unsigned size);
+
+/**
+ * Création d'une matrice circulante, A[i][j] = c[(i - j) mod n], cas
+ * particulier de matrice de Toeplitz.
+ *
+ * @param[in] col la première colonne de la matrice.
+ * @param[in] size la longueur n de nos vecteurs (n >= 1).
+ * @return la matrice, ou @c NULL si size est nul ou si son allocation a
+ *   échoué.
+ */
+toeplitz_t* circulant_create(const float col[], const unsigned size);
+
+/**
+ * Destruction d'une matrice de Toeplitz.
+ *
+ * @param[in] T la matrice (éventuellement @c NULL).
+ */
+void toeplitz_free(toeplitz_t* T);
+
+/**
+ * Multiplication matrice-vecteur b = T * x par transformée de Fourier.
+ *
+ * @param[in]  T la matrice (son espace de travail est modifié : deux appels
+ *   concurrents sur une même matrice ne sont pas permis).
+ * @param[in]  x le vecteur source.
+ * @param[out] b le vecteur cible.
+ */
+void toeplitz_matvec(toeplitz_t* T, const float x[], float b[]);
+
+#endif
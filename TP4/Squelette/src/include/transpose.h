@@ -0,0 +1,39 @@
+#ifndef TRANSPOSE_H
+#define TRANSPOSE_H
+
+/**
+ * Côté des tuiles réparties entre les threads.
+ */
+#define TRANSPOSE_TILE 256
+
+/**
+ * Transposition hors place B = A^T. La matrice est découpée en tuiles de
+ * @c TRANSPOSE_TILE x @c TRANSPOSE_TILE réparties entre les threads OpenMP ;
+ * chaque tuile est transposée récursivement (découpage de sa plus grande
+ * dimension en deux jusqu'à des feuilles d'au plus 32 x 32, indépendamment
+ * de la taille des caches), chaque feuille étant traitée par blocs de 8 x 8
+ * transposés dans les registres SSE (quatre transpositions 4 x 4).
+ *
+ * @param[in]  A la matrice source (rows x cols, dépliée ligne par ligne).
+ * @param[out] B la matrice cible (cols x rows, dépliée ligne par ligne).
+ * @param[in]  rows le nombre de lignes de A.
+ * @param[in]  cols le nombre de colonnes de A.
+ *
+ * @note aucune contrainte d'alignement ni de dimension n'est imposée.
+ */
+void transpose(const float A[restrict],
+                     float B[restrict],
+               const unsigned rows,
+               const unsigned cols);
+
+/**
+ * Transposition en place d'une matrice carrée. Les paires de tuiles
+ * symétriques sont échangées et transposées simultanément, avec le même
+ * découpage récursif et les mêmes noyaux SSE que @c transpose.
+ *
+ * @param[in,out] A la matrice (dépliée en tableau).
+ * @param[in]     n la longueur de nos vecteurs.
+ */
+void transpose_inplace(float A[], const unsigned n);
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef TRISOLVE_H
+#define TRISOLVE_H
+
+#include "csr.h"
+
+/**
+ * Nombre moyen minimal de lignes par niveau et par thread. En deçà, les
+ * synchronisations entre niveaux coûtent plus que le calcul qu'elles
+ * séparent (sur la numérotation naturelle d'un laplacien 2D 1000 x 1000,
+ * 1999 niveaux d'en moyenne 500 lignes, la résolution parallèle est plus
+ * lente que la résolution séquentielle) : l'analyse produit alors un plan
+ * séquentiel.
+ */
+#define TRISOLVE_MIN_ROWS 512
+
+/**
+ * Forme d'une matrice triangulaire.
+ */
+typedef enum {
+  TRISOLVE_LOWER, // Triangulaire inférieure : descente.
+  TRISOLVE_UPPER  // Triangulaire supérieure : remontée.
+} trisolve_uplo_t;
+
+/**
+ * Analyse d'une matrice triangulaire creuse en vue de sa résolution
+ * parallèle par niveaux (ordonnancement en fronts d'onde). La composante i
+ * de la solution appartient au niveau 0 si elle ne dépend d'aucune autre,
+ * et sinon au niveau suivant le plus élevé de ses dépendances : les
+ * composantes d'un même niveau sont indépendantes.
+ *
+ * Les lignes sont renumérotées niveau par niveau, et le plan conserve une
+ * copie de la matrice permutée (P.L.P^T) : les lignes d'un niveau, comme les
+ * composantes dont elles dépendent, y sont contiguës, alors que dans la
+ * numérotation d'origine (sur une grille, les niveaux en sont les
+ * anti-diagonales) elles sont dispersées.
+ *
+ * Chaque niveau est découpé en autant de tranches que de threads
+ * (virtuels), la tranche t de chaque niveau revenant au thread t. Plutôt
+ * que de séparer les niveaux par une barrière globale, chaque thread publie
+ * le nombre de niveaux qu'il a terminés, et chaque tranche comporte la
+ * liste des seuls threads (et niveaux) qu'elle doit attendre ; une attente
+ * déjà satisfaite par une tranche précédente du même thread est omise.
+ *
+ * Le plan conserve enfin les tampons de la résolution (second membre et
+ * solution permutés, compteurs de progression), alloués une fois pour
+ * toutes.
+ */
+typedef struct {
+  unsigned n;             // La dimension de la matrice.
+  trisolve_uplo_t uplo;   // La forme de la matrice.
+  unsigned levels;        // Le nombre de niveaux.
+  unsigned threads;       // Le nombre de threads (virtuels).
+  unsigned* order;        // Ligne d'origine de chaque ligne permutée.
+  size_t* ptr;            // La matrice permutée, au format CSR : début de
+  unsigned* col;          // chaque ligne, colonnes (dans le même ordre que
+  float* val;             // dans L) et valeurs.
+  size_t* diag;           // Position de l'élément diagonal de chaque ligne
+                          // permutée.
+  unsigned* start;        // Première ligne (permutée) de la tranche (l, t),
+                          // à l'indice l * threads + t (levels * threads + 1
+                          // entrées).
+  size_t* wptr;           // Début des attentes de chaque tranche
+                          // (levels * threads + 1 entrées).
+  unsigned* wthread;      // Thread attendu par chaque attente.
+  unsigned* wlevel;       // Nombre de niveaux que ce thread doit avoir
+                          // terminés.
+  float* bp;              // Le second membre permuté (n composantes).
+  float* xp;              // La solution permutée (n composantes).
+  void* progress;         // Les compteurs de progression des threads.
+} trisolve_t;
+
+/**
+ * Analyse d'une matrice triangulaire. Le plan peut être conservé et
+ * réutilisé pour toute résolution avec la même matrice ; si seules ses
+ * valeurs changent, @c trisolve_update suffit à le mettre à jour.
+ *
+ * @param[in] L la matrice, dont chaque ligne comporte son élément diagonal
+ *   (non nul) et aucun élément du mauvais côté de la diagonale.
+ * @param[in] uplo la forme de la matrice.
+ * @param[in] threads le nombre de threads (0 : le nombre de threads OpenMP
+ *   disponibles). Il est ramené à 1 si les niveaux comptent en moyenne
+ *   moins de @c TRISOLVE_MIN_ROWS lignes par thread ; un plan à un seul
+ *   thread ne comporte qu'un niveau, les lignes gardant leur numérotation
+ *   d'origine.
+ * @return le plan, ou @c NULL si la matrice n'est pas carrée ou n'est pas
+ *   triangulaire de la forme indiquée.
+ */
+trisolve_t* trisolve_analyze(const csr_t* L,
+                             const trisolve_uplo_t uplo,
+                             const unsigned threads);
+
+/**
+ * Mise à jour des valeurs du plan, pour une matrice de même structure que
+ * celle de l'analyse (typiquement une nouvelle factorisation incomplète).
+ *
+ * @param[in,out] T le plan.
+ * @param[in]     L la matrice.
+ */
+void trisolve_update(trisolve_t* T, const csr_t* L);
+
+/**
+ * Destruction d'un plan.
+ *
+ * @param[in] T le plan (éventuellement @c NULL).
+ */
+void trisolve_free(trisolve_t* T);
+
+/**
+ * Résolution parallèle de L.x = b. Le second membre est permuté, le
+ * système permuté résolu, puis la solution remise dans la numérotation
+ * d'origine. Les threads OpenMP se partagent les threads virtuels du plan
+ * (un thread réel traitant, niveau par niveau, les tranches de plusieurs
+ * threads virtuels s'il y en a moins), et ne se synchronisent que deux à
+ * deux, selon les attentes du plan. Un plan séquentiel (un seul thread),
+ * ou l'absence de threads OpenMP supplémentaires, donne lieu à une
+ * résolution ligne par ligne, sans région parallèle ni synchronisation.
+ *
+ * @param[in]  T le plan de la matrice.
+ * @param[in]  b le second membre.
+ * @param[out] x la solution.
+ *
+ * @note chaque composante est calculée dans le même ordre que par
+ *   @c trisolve_serial : les résultats sont identiques bit à bit.
+ * @note les tampons du plan sont utilisés : deux résolutions simultanées
+ *   doivent utiliser des plans distincts.
+ */
+void trisolve_solve(const trisolve_t* T,
+                    const float b[restrict],
+                          float x[restrict]);
+
+/**
+ * Résolution séquentielle de L.x = b, ligne par ligne.
+ *
+ * @param[in]  L la matrice.
+ * @param[in]  uplo la forme de la matrice.
+ * @param[in]  b le second membre.
+ * @param[out] x la solution.
+ */
+void trisolve_serial(const csr_t* L,
+                     const trisolve_uplo_t uplo,
+                     const float b[restrict],
+                           float x[restrict]);
+
+#endif
@@ -0,0 +1,251 @@
+#include "lowrank.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <x86intrin.h>
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Tirage d'un nombre suivant une loi normale centrée réduite (générateur
+ * xorshift64* et transformation de Box-Muller). Le générateur est local afin
+ * que la construction soit reproductible et n'altère pas l'état de rand().
+ */
+static double
+gaussian(unsigned long long* state) {
+
+  double u[2];
+  for (int i = 0; i != 2; i ++) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    const unsigned long long r = *state * 2685821657736338717ULL;
+    u[i] = ((r >> 11) + 0.5) / 9007199254740992.0; // Dans ]0, 1[.
+  }
+  return sqrt(-2.0 * log(u[0])) * cos(2.0 * acos(-1.0) * u[1]);
+
+}
+
+/*
+ * Orthonormalisation de k vecteurs de longueur n rangés consécutivement, par
+ * Gram-Schmidt modifié appliqué deux fois (la seconde passe corrigeant la
+ * perte d'orthogonalité de la première). Un vecteur linéairement dépendant
+ * des précédents est remplacé par le vecteur nul.
+ */
+static void
+orthonormalize(double Q[], const unsigned n, const unsigned k) {
+
+  for (unsigned r = 0; r != k; r ++) {
+    double* q = Q + (size_t) r * n;
+    for (int pass = 0; pass != 2; pass ++) {
+      for (unsigned s = 0; s != r; s ++) {
+        const double* p = Q + (size_t) s * n;
+        double proj = 0.0;
+        for (unsigned i = 0; i != n; i ++) {
+          proj += p[i] * q[i];
+        }
+        for (unsigned i = 0; i != n; i ++) {
+          q[i] -= proj * p[i];
+        }
+      }
+    }
+    double norm = 0.0;
+    for (unsigned i = 0; i != n; i ++) {
+      norm += q[i] * q[i];
+    }
+    norm = sqrt(norm);
+    const double inv = norm > 1e-12 ? 1.0 / norm : 0.0;
+    for (unsigned i = 0; i != n; i ++) {
+      q[i] *= inv;
+    }
+  }
+
+}
+
+/*
+ * Produits out_r = A * in_r pour k vecteurs consécutifs de longueur n.
+ */
+static void
+apply(const float A[], const double in[], double out[],
+      const unsigned n, const unsigned k) {
+
+  for (unsigned i = 0; i != n; i ++) {
+    const float* Ai = A + (size_t) i * n;
+    for (unsigned r = 0; r != k; r ++) {
+      const double* v = in + (size_t) r * n;
+      double acc = 0.0;
+      for (unsigned j = 0; j != n; j ++) {
+        acc += Ai[j] * v[j];
+      }
+      out[(size_t) r * n + i] = acc;
+    }
+  }
+
+}
+
+/*
+ * Produits out_r = A^T * in_r pour k vecteurs consécutifs de longueur n. La
+ * matrice est parcourue ligne par ligne, chaque ligne étant accumulée dans
+ * les k vecteurs cibles.
+ */
+static void
+apply_t(const float A[], const double in[], double out[],
+        const unsigned n, const unsigned k) {
+
+  for (size_t i = 0; i != (size_t) n * k; out[i ++] = 0.0);
+
+  for (unsigned i = 0; i != n; i ++) {
+    const float* Ai = A + (size_t) i * n;
+    for (unsigned r = 0; r != k; r ++) {
+      const double w = in[(size_t) r * n + i];
+      double* o = out + (size_t) r * n;
+      for (unsigned j = 0; j != n; j ++) {
+        o[j] += w * Ai[j];
+      }
+    }
+  }
+
+}
+
+/*
+ * Produit scalaire SSE de deux tableaux non nécessairement alignés.
+ */
+static inline float
+dot(const float a[restrict], const float b[restrict], const unsigned len) {
+
+  xmm_t acc;
+  acc.m128_vec = _mm_setzero_ps();
+  unsigned k = 0;
+  for (; k + 4 <= len; k += 4) {
+    acc.m128_vec = _mm_add_ps(acc.m128_vec,
+                              _mm_mul_ps(_mm_loadu_ps(a + k),
+                                         _mm_loadu_ps(b + k)));
+  }
+  float sum = acc.m128_f32[0] + acc.m128_f32[1]
+    + acc.m128_f32[2] + acc.m128_f32[3];
+  for (; k != len; k ++) {
+    sum += a[k] * b[k];
+  }
+  return sum;
+
+}
+
+/******************
+ * lowrank_create *
+ ******************/
+
+lowrank_t*
+lowrank_create(const float A[],
+               const unsigned size,
+               const unsigned rank,
+               const unsigned iters) {
+
+  const unsigned n = size;
+  const unsigned k = rank;
+
+  double* omega = (double*) malloc(sizeof(double) * n * k);
+  double* Q = (double*) malloc(sizeof(double) * n * k);
+
+  // Échantillonnage de l'image de A : Q = orth(A * omega).
+  unsigned long long state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i != (size_t) n * k; i ++) {
+    omega[i] = gaussian(&state);
+  }
+  apply(A, omega, Q, n, k);
+  orthonormalize(Q, n, k);
+
+  // Itérations de puissance : Q = orth(A * orth(A^T * Q)).
+  for (unsigned it = 0; it != iters; it ++) {
+    apply_t(A, Q, omega, n, k);
+    orthonormalize(omega, n, k);
+    apply(A, omega, Q, n, k);
+    orthonormalize(Q, n, k);
+  }
+
+  // Facteurs : U = Q (n x k) et V^T = Q^T * A (k x n), i.e. les lignes de V^T
+  // sont les vecteurs A^T * q_r.
+  apply_t(A, Q, omega, n, k);
+
+  lowrank_t* L = (lowrank_t*) malloc(sizeof(lowrank_t));
+  L->size = n;
+  L->rank = k;
+  L->U = (float*) malloc(sizeof(float) * n * k);
+  L->Vt = (float*) malloc(sizeof(float) * n * k);
+  L->work = (float*) malloc(sizeof(float) * k);
+  for (unsigned i = 0; i != n; i ++) {
+    for (unsigned r = 0; r != k; r ++) {
+      L->U[(size_t) i * k + r] = (float) Q[(size_t) r * n + i];
+    }
+  }
+  for (size_t i = 0; i != (size_t) n * k; i ++) {
+    L->Vt[i] = (float) omega[i];
+  }
+
+  // Norme de Frobenius du résidu, calculée sur les facteurs en simple
+  // précision effectivement utilisés par le produit. Elle majore la norme
+  // spectrale du résidu, d'où la borne sur l'erreur de chaque produit.
+  double residual = 0.0;
+  for (unsigned i = 0; i != n; i ++) {
+    const float* Ui = L->U + (size_t) i * k;
+    for (unsigned j = 0; j != n; j ++) {
+      double approx = 0.0;
+      for (unsigned r = 0; r != k; r ++) {
+        approx += (double) Ui[r] * L->Vt[(size_t) r * n + j];
+      }
+      const double d = A[(size_t) i * n + j] - approx;
+      residual += d * d;
+    }
+  }
+  L->error = sqrt(residual);
+
+  free(omega);
+  free(Q);
+  return L;
+
+}
+
+/****************
+ * lowrank_free *
+ ****************/
+
+void
+lowrank_free(lowrank_t* L) {
+
+  if (L == NULL) {
+    return;
+  }
+  free(L->U);
+  free(L->Vt);
+  free(L->work);
+  free(L);
+
+}
+
+/******************
+ * lowrank_matvec *
+ ******************/
+
+void
+lowrank_matvec(lowrank_t* L, const float x[], float b[]) {
+
+  const unsigned n = L->size;
+  const unsigned k = L->rank;
+
+  // y = V^T * x : k produits scalaires de longueur n.
+  for (unsigned r = 0; r != k; r ++) {
+    L->work[r] = dot(L->Vt + (size_t) r * n, x, n);
+  }
+
+  // b = U * y : n produits scalaires de longueur k.
+  for (unsigned i = 0; i != n; i ++) {
+    b[i] = dot(L->U + (size_t) i * k, L->work, k);
+  }
+
+}
@@ -0,0 +1,44 @@
+#include "matvec_fixed.h"
+#include "MatvecFixed.hpp"
+
+/*
+ * Boucle générique utilisée pour les tailles non spécialisées : c'est celle
+ * de matvec_sse_r4.
+ */
+static void
+generic(const float* __restrict__ A,
+	const float* __restrict__ x,
+	float* __restrict__ b,
+	const unsigned size) {
+
+  for (unsigned i = 0; i != size; i ++) {
+    __m128 acc = _mm_setzero_ps();
+    for (unsigned j = i * size, k = 0; k != size; j += 4, k += 4) {
+      acc = _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(A + j), _mm_load_ps(x + k)));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    b[i] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+
+}
+
+/****************
+ * matvec_fixed *
+ ****************/
+
+void
+matvec_fixed(const float A[], const float x[], float b[],
+	     const unsigned size) {
+
+  using paralgos::MatvecFixed;
+
+  switch (size) {
+  case  64: MatvecFixed<  64,  64 >::apply(A, x, b); break;
+  case 128: MatvecFixed< 128, 128 >::apply(A, x, b); break;
+  case 256: MatvecFixed< 256, 256 >::apply(A, x, b); break;
+  case 512: MatvecFixed< 512, 512 >::apply(A, x, b); break;
+  default:  generic(A, x, b, size);                  break;
+  }
+
+}
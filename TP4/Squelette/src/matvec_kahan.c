@@ -0,0 +1,129 @@
+#include "matvec_kahan.h"
+
+#include <stddef.h>
+#include <x86intrin.h>
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Scission de Dekker : a = hi + lo, hi et lo tenant chacun sur 12 bits de
+ * mantisse (facteur 2^12 + 1).
+ */
+static inline void
+split(const __m128 a, __m128* hi, __m128* lo) {
+
+  const __m128 c = _mm_mul_ps(_mm_set1_ps(4097.0f), a);
+  *hi = _mm_sub_ps(c, _mm_sub_ps(c, a));
+  *lo = _mm_sub_ps(a, *hi);
+
+}
+
+/*
+ * TwoProduct : p = fl(a.x) et e tel que a.x = p + e exactement.
+ */
+static inline void
+two_product(const __m128 a, const __m128 x, __m128* p, __m128* e) {
+
+  __m128 ah, al, xh, xl;
+  split(a, &ah, &al);
+  split(x, &xh, &xl);
+  *p = _mm_mul_ps(a, x);
+  *e = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(ah, xh), *p),
+                  _mm_mul_ps(ah, xl));
+  *e = _mm_add_ps(_mm_add_ps(*e, _mm_mul_ps(al, xh)), _mm_mul_ps(al, xl));
+
+}
+
+/*
+ * TwoSum : s = fl(a + b) et e tel que a + b = s + e exactement.
+ */
+static inline void
+two_sum(const __m128 a, const __m128 b, __m128* s, __m128* e) {
+
+  *s = _mm_add_ps(a, b);
+  const __m128 bb = _mm_sub_ps(*s, a);
+  *e = _mm_add_ps(_mm_sub_ps(a, _mm_sub_ps(*s, bb)), _mm_sub_ps(b, bb));
+
+}
+
+/*
+ * Versions scalaires pour la fin des lignes et la réduction des couloirs.
+ */
+static inline float
+two_sum_1(const float a, const float b, float* e) {
+
+  const float s = a + b;
+  const float bb = s - a;
+  *e = (a - (s - bb)) + (b - bb);
+  return s;
+
+}
+
+static inline float
+two_product_1(const float a, const float x, float* e) {
+
+  const float ca = 4097.0f * a, cx = 4097.0f * x;
+  const float ah = ca - (ca - a), al = a - ah;
+  const float xh = cx - (cx - x), xl = x - xh;
+  const float p = a * x;
+  *e = (((ah * xh - p) + ah * xl) + al * xh) + al * xl;
+  return p;
+
+}
+
+/****************
+ * matvec_kahan *
+ ****************/
+
+void
+matvec_kahan(const float A[restrict],
+             const float x[restrict],
+                   float b[restrict],
+             const unsigned size) {
+
+  for (unsigned i = 0; i != size; i ++) {
+
+    const float* a = A + (size_t) i * size;
+
+    // Sommes partielles et erreurs accumulées de chaque couloir.
+    xmm_t sum, err;
+    sum.m128_vec = _mm_setzero_ps();
+    err.m128_vec = _mm_setzero_ps();
+
+    unsigned k = 0;
+    for (; k + 4 <= size; k += 4) {
+      __m128 p, ep, es;
+      two_product(_mm_loadu_ps(a + k), _mm_loadu_ps(x + k), &p, &ep);
+      two_sum(sum.m128_vec, p, &sum.m128_vec, &es);
+      err.m128_vec = _mm_add_ps(err.m128_vec, _mm_add_ps(ep, es));
+    }
+
+    // Réduction des couloirs, puis fin de ligne, toujours sous forme
+    // compensée.
+    float s = sum.m128_f32[0];
+    float c = err.m128_f32[0] + err.m128_f32[1]
+      + err.m128_f32[2] + err.m128_f32[3];
+    for (unsigned l = 1; l != 4; l ++) {
+      float e;
+      s = two_sum_1(s, sum.m128_f32[l], &e);
+      c += e;
+    }
+    for (; k != size; k ++) {
+      float ep, es;
+      const float p = two_product_1(a[k], x[k], &ep);
+      s = two_sum_1(s, p, &es);
+      c += ep + es;
+    }
+
+    b[i] = s + c;
+
+  }
+
+}
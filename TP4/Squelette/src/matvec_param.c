@@ -0,0 +1,153 @@
+#include "matvec_param.h"
+
+#include <x86intrin.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Calcul de rows composantes consécutives de b à partir de la ligne i, avec
+ * unroll accumulateurs par ligne. Les paramètres rows et unroll étant passés
+ * sous forme de constantes par l'appelant, le compilateur peut spécialiser
+ * chaque instance de cette fonction et conserver les accumulateurs dans des
+ * registres.
+ */
+static inline void
+block(const float A[restrict],
+      const float x[restrict],
+            float b[restrict],
+      const unsigned size,
+      const unsigned i,
+      const unsigned rows,
+      const unsigned unroll,
+      const unsigned prefetch) {
+
+  // Au plus quatre lignes et quatre accumulateurs par ligne. Le tableau est
+  // entièrement mis à zéro (les accumulateurs inutilisés sont éliminés par
+  // le compilateur).
+  __m128 acc[4][4];
+  for (unsigned r = 0; r != 4; r ++) {
+    for (unsigned u = 0; u != 4; u ++) {
+      acc[r][u] = _mm_setzero_ps();
+    }
+  }
+
+  // Partie principale : pas de 4 * unroll composantes.
+  const unsigned step = 4 * unroll;
+  const unsigned body = size - size % step;
+  unsigned k = 0;
+  for (; k != body; k += step) {
+
+    // Un préchargement par ligne de cache (16 floats) suffit.
+    if (prefetch && k % 16 == 0) {
+      for (unsigned r = 0; r != rows; r ++) {
+        _mm_prefetch((const char*) (A + (i + r) * size + k + prefetch),
+                     _MM_HINT_T0);
+      }
+    }
+
+    for (unsigned u = 0; u != unroll; u ++) {
+      const __m128 xx = _mm_load_ps(x + k + 4 * u);
+      for (unsigned r = 0; r != rows; r ++) {
+        const __m128 AA = _mm_load_ps(A + (i + r) * size + k + 4 * u);
+        acc[r][u] = _mm_add_ps(acc[r][u], _mm_mul_ps(AA, xx));
+      }
+    }
+
+  }
+
+  // Reliquat : pas de 4 composantes sur le premier accumulateur.
+  for (; k != size; k += 4) {
+    const __m128 xx = _mm_load_ps(x + k);
+    for (unsigned r = 0; r != rows; r ++) {
+      const __m128 AA = _mm_load_ps(A + (i + r) * size + k);
+      acc[r][0] = _mm_add_ps(acc[r][0], _mm_mul_ps(AA, xx));
+    }
+  }
+
+  // Réduction des accumulateurs de chaque ligne.
+  for (unsigned r = 0; r != rows; r ++) {
+    xmm_t sum;
+    sum.m128_vec = acc[r][0];
+    for (unsigned u = 1; u != unroll; u ++) {
+      sum.m128_vec = _mm_add_ps(sum.m128_vec, acc[r][u]);
+    }
+    b[i + r] = sum.m128_f32[0]
+      + sum.m128_f32[1]
+      + sum.m128_f32[2]
+      + sum.m128_f32[3];
+  }
+
+}
+
+/*
+ * Parcours des blocs de lignes pour une combinaison (rows, unroll) donnée.
+ */
+static inline void
+sweep(const float A[restrict],
+      const float x[restrict],
+            float b[restrict],
+      const unsigned size,
+      const unsigned rows,
+      const unsigned unroll,
+      const unsigned prefetch,
+      const unsigned threads) {
+
+  const int blocks = size / rows;
+
+#pragma omp parallel for schedule(static) num_threads(threads) if(threads != 1)
+  for (int blk = 0; blk < blocks; blk ++) {
+    block(A, x, b, size, blk * rows, rows, unroll, prefetch);
+  }
+
+}
+
+/****************
+ * matvec_param *
+ ****************/
+
+void
+matvec_param(const float A[restrict],
+             const float x[restrict],
+                   float b[restrict],
+             const unsigned size,
+             const matvec_param_t* param) {
+
+  // Nombre de threads effectif.
+  unsigned threads = param->threads;
+#ifdef _OPENMP
+  if (threads == 0) {
+    threads = omp_get_max_threads();
+  }
+#else
+  threads = 1;
+#endif
+
+  const unsigned pf = param->prefetch;
+
+  // Chaque combinaison est appelée avec des constantes littérales afin que
+  // le compilateur en produise une version spécialisée.
+#define SWEEP(R, U) sweep(A, x, b, size, R, U, pf, threads)
+  switch (param->rows * 8 + param->unroll) {
+  case 1 * 8 + 1: SWEEP(1, 1); break;
+  case 1 * 8 + 2: SWEEP(1, 2); break;
+  case 1 * 8 + 4: SWEEP(1, 4); break;
+  case 2 * 8 + 1: SWEEP(2, 1); break;
+  case 2 * 8 + 2: SWEEP(2, 2); break;
+  case 2 * 8 + 4: SWEEP(2, 4); break;
+  case 4 * 8 + 1: SWEEP(4, 1); break;
+  case 4 * 8 + 2: SWEEP(4, 2); break;
+  default:        SWEEP(4, 4); break;
+  }
+#undef SWEEP
+
+}
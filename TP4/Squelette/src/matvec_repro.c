@@ -0,0 +1,144 @@
+#include "matvec_repro.h"
+
+#include <stddef.h>
+#include <x86intrin.h>
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Pile des sous-arbres de la réduction : sommes partielles et hauteurs. Une
+ * profondeur de 32 suffit pour 2^32 blocs.
+ */
+typedef struct {
+  float sum[32];
+  unsigned height[32];
+  unsigned top;
+} tree_t;
+
+/*
+ * Ajout de la somme d'un bloc : tant que le sommet de la pile est un
+ * sous-arbre de même hauteur, les deux sont fusionnés.
+ */
+static inline void
+push(tree_t* tree, float s) {
+
+  unsigned h = 0;
+  while (tree->top != 0 && tree->height[tree->top - 1] == h) {
+    s = tree->sum[-- tree->top] + s;
+    h ++;
+  }
+  tree->sum[tree->top] = s;
+  tree->height[tree->top] = h;
+  tree->top ++;
+
+}
+
+/*
+ * Somme des sous-arbres restants, de droite à gauche.
+ */
+static inline float
+fold(tree_t* tree) {
+
+  if (tree->top == 0) {
+    return 0.0f;
+  }
+  float s = tree->sum[-- tree->top];
+  while (tree->top != 0) {
+    s = tree->sum[-- tree->top] + s;
+  }
+  return s;
+
+}
+
+/*
+ * Ligne calculée avec le jeu d'instructions SSE : les quatre couloirs d'un
+ * registre sont les quatre accumulateurs du bloc.
+ */
+static float
+row_sse(const float a[restrict], const float x[restrict], const unsigned n) {
+
+  tree_t tree;
+  tree.top = 0;
+
+  for (unsigned k0 = 0; k0 < n; k0 += MATVEC_REPRO_BLOCK) {
+    const unsigned k1 = n - k0 < MATVEC_REPRO_BLOCK ? n : k0 + MATVEC_REPRO_BLOCK;
+    xmm_t acc;
+    acc.m128_vec = _mm_setzero_ps();
+    unsigned k = k0;
+    for (; k + 4 <= k1; k += 4) {
+      acc.m128_vec = _mm_add_ps(acc.m128_vec,
+                                _mm_mul_ps(_mm_loadu_ps(a + k),
+                                           _mm_loadu_ps(x + k)));
+    }
+    for (; k != k1; k ++) {
+      acc.m128_f32[k % 4] += a[k] * x[k];
+    }
+    push(&tree, (acc.m128_f32[0] + acc.m128_f32[1])
+               + (acc.m128_f32[2] + acc.m128_f32[3]));
+  }
+
+  return fold(&tree);
+
+}
+
+/*
+ * Même calcul sous forme scalaire.
+ */
+static float
+row_scalar(const float a[], const float x[], const unsigned n) {
+
+  tree_t tree;
+  tree.top = 0;
+
+  for (unsigned k0 = 0; k0 < n; k0 += MATVEC_REPRO_BLOCK) {
+    const unsigned k1 = n - k0 < MATVEC_REPRO_BLOCK ? n : k0 + MATVEC_REPRO_BLOCK;
+    float lane[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (unsigned k = k0; k != k1; k ++) {
+      lane[k % 4] += a[k] * x[k];
+    }
+    push(&tree, (lane[0] + lane[1]) + (lane[2] + lane[3]));
+  }
+
+  return fold(&tree);
+
+}
+
+/****************
+ * matvec_repro *
+ ****************/
+
+void
+matvec_repro(const float A[restrict],
+             const float x[restrict],
+                   float b[restrict],
+             const unsigned size) {
+
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < (int) size; i ++) {
+    b[i] = row_sse(A + (size_t) i * size, x, size);
+  }
+
+}
+
+/********************
+ * matvec_repro_ref *
+ ********************/
+
+void
+matvec_repro_ref(const float A[],
+                 const float x[],
+                       float b[],
+                 const unsigned size) {
+
+  for (unsigned i = 0; i != size; i ++) {
+    b[i] = row_scalar(A + (size_t) i * size, x, size);
+  }
+
+}
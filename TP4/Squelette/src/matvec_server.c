@@ -0,0 +1,319 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime.
+
+#include "matvec_server.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <x86intrin.h>
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * État du serveur. La file d'attente et les drapeaux des requêtes sont
+ * protégés par mutex.
+ */
+struct matvec_server {
+  const float* A;           // La matrice.
+  unsigned size;            // La longueur de nos vecteurs.
+  unsigned batch;           // Le nombre maximal de requêtes par lot.
+  matvec_request_t** slots; // Les requêtes du lot en cours de traitement.
+  double timeout;           // Le délai d'attente maximal (en secondes).
+  matvec_request_t* head;   // Première requête en attente.
+  matvec_request_t* tail;   // Dernière requête en attente.
+  unsigned pending;         // Nombre de requêtes en attente.
+  int stop;                 // Non nul lorsque l'arrêt est demandé.
+  unsigned long batches;    // Nombre de lots traités.
+  unsigned long requests;   // Nombre de requêtes traitées.
+  pthread_t thread;         // Le thread du serveur.
+  pthread_mutex_t mutex;    // Protection de l'état partagé.
+  pthread_cond_t work;      // Signalement de nouvelles requêtes.
+  pthread_cond_t done;      // Signalement de requêtes terminées.
+};
+
+/*
+ * Produit de la matrice par count vecteurs : chaque ligne de A, lue une seule
+ * fois depuis la mémoire, est multipliée par les vecteurs quatre à quatre
+ * pendant qu'elle réside en cache. Les lignes sont réparties entre les
+ * threads OpenMP.
+ */
+static void
+multiply(const float A[],
+         matvec_request_t* const batch[],
+         const unsigned count,
+         const unsigned size) {
+
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < (int) size; i ++) {
+
+    const float* a = A + (size_t) i * size;
+
+    for (unsigned j0 = 0; j0 < count; j0 += 4) {
+
+      const unsigned group = count - j0 < 4 ? count - j0 : 4;
+      const float* x[4];
+      for (unsigned j = 0; j != 4; j ++) {
+        // Les couloirs inutilisés du dernier groupe recalculent le premier
+        // vecteur du groupe, sans stocker le résultat.
+        x[j] = batch[j0 + (j < group ? j : 0)]->x;
+      }
+
+      xmm_t acc[4];
+      for (unsigned j = 0; j != 4; j ++) {
+        acc[j].m128_vec = _mm_setzero_ps();
+      }
+      unsigned k = 0;
+      for (; k + 4 <= size; k += 4) {
+        const __m128 v = _mm_loadu_ps(a + k);
+        acc[0].m128_vec = _mm_add_ps(acc[0].m128_vec,
+                                     _mm_mul_ps(v, _mm_loadu_ps(x[0] + k)));
+        acc[1].m128_vec = _mm_add_ps(acc[1].m128_vec,
+                                     _mm_mul_ps(v, _mm_loadu_ps(x[1] + k)));
+        acc[2].m128_vec = _mm_add_ps(acc[2].m128_vec,
+                                     _mm_mul_ps(v, _mm_loadu_ps(x[2] + k)));
+        acc[3].m128_vec = _mm_add_ps(acc[3].m128_vec,
+                                     _mm_mul_ps(v, _mm_loadu_ps(x[3] + k)));
+      }
+
+      for (unsigned j = 0; j != group; j ++) {
+        float sum = acc[j].m128_f32[0] + acc[j].m128_f32[1]
+          + acc[j].m128_f32[2] + acc[j].m128_f32[3];
+        for (unsigned t = k; t != size; t ++) {
+          sum += a[t] * x[j][t];
+        }
+        batch[j0 + j]->b[i] = sum;
+      }
+
+    }
+
+  }
+
+}
+
+/*
+ * Date d'expiration du délai d'attente de la plus ancienne requête.
+ */
+static struct timespec
+deadline(const matvec_server_t* S) {
+
+  struct timespec t = S->head->arrival;
+  const long ns = (long) (S->timeout * 1e9);
+  t.tv_sec += ns / 1000000000L;
+  t.tv_nsec += ns % 1000000000L;
+  if (t.tv_nsec >= 1000000000L) {
+    t.tv_sec ++;
+    t.tv_nsec -= 1000000000L;
+  }
+  return t;
+
+}
+
+/*
+ * Corps du thread du serveur.
+ */
+static void*
+serve(void* arg) {
+
+  matvec_server_t* S = (matvec_server_t*) arg;
+  matvec_request_t** batch = S->slots;
+
+  pthread_mutex_lock(&S->mutex);
+  for (;;) {
+
+    while (S->pending == 0 && !S->stop) {
+      pthread_cond_wait(&S->work, &S->mutex);
+    }
+    if (S->pending == 0) {
+      break;
+    }
+
+    // Attente d'un lot complet, dans la limite du délai.
+    const struct timespec limit = deadline(S);
+    while (S->pending < S->batch && !S->stop) {
+      if (pthread_cond_timedwait(&S->work, &S->mutex, &limit) == ETIMEDOUT) {
+        break;
+      }
+    }
+
+    // Extraction du lot.
+    unsigned count = 0;
+    while (count != S->batch && S->head != NULL) {
+      batch[count ++] = S->head;
+      S->head = S->head->next;
+    }
+    if (S->head == NULL) {
+      S->tail = NULL;
+    }
+    S->pending -= count;
+    pthread_mutex_unlock(&S->mutex);
+
+    multiply(S->A, batch, count, S->size);
+
+    pthread_mutex_lock(&S->mutex);
+    for (unsigned j = 0; j != count; j ++) {
+      batch[j]->done = 1;
+    }
+    S->batches ++;
+    S->requests += count;
+    pthread_cond_broadcast(&S->done);
+
+  }
+  pthread_mutex_unlock(&S->mutex);
+
+  return NULL;
+
+}
+
+/************************
+ * matvec_server_create *
+ ************************/
+
+matvec_server_t*
+matvec_server_create(const float A[],
+                     const unsigned size,
+                     const unsigned batch,
+                     const double timeout) {
+
+  matvec_server_t* S = (matvec_server_t*) malloc(sizeof(matvec_server_t));
+  if (S == NULL) {
+    return NULL;
+  }
+  S->A = A;
+  S->size = size;
+  S->batch = batch != 0 ? batch : 1;
+  S->slots =
+    (matvec_request_t**) malloc(sizeof(matvec_request_t*) * S->batch);
+  if (S->slots == NULL) {
+    free(S);
+    return NULL;
+  }
+  S->timeout = timeout > 0.0 ? timeout : 0.0;
+  S->head = S->tail = NULL;
+  S->pending = 0;
+  S->stop = 0;
+  S->batches = S->requests = 0;
+  pthread_mutex_init(&S->mutex, NULL);
+  pthread_cond_init(&S->work, NULL);
+  pthread_cond_init(&S->done, NULL);
+  if (pthread_create(&S->thread, NULL, serve, S) != 0) {
+    pthread_mutex_destroy(&S->mutex);
+    pthread_cond_destroy(&S->work);
+    pthread_cond_destroy(&S->done);
+    free(S->slots);
+    free(S);
+    return NULL;
+  }
+
+  return S;
+
+}
+
+/**********************
+ * matvec_server_free *
+ **********************/
+
+void
+matvec_server_free(matvec_server_t* S) {
+
+  if (S == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&S->mutex);
+  S->stop = 1;
+  pthread_cond_signal(&S->work);
+  pthread_mutex_unlock(&S->mutex);
+
+  pthread_join(S->thread, NULL);
+  pthread_mutex_destroy(&S->mutex);
+  pthread_cond_destroy(&S->work);
+  pthread_cond_destroy(&S->done);
+  free(S->slots);
+  free(S);
+
+}
+
+/************************
+ * matvec_server_submit *
+ ************************/
+
+void
+matvec_server_submit(matvec_server_t* S,
+                     matvec_request_t* r,
+                     const float x[],
+                           float b[]) {
+
+  r->x = x;
+  r->b = b;
+  r->done = 0;
+  r->next = NULL;
+  clock_gettime(CLOCK_REALTIME, &r->arrival);
+
+  pthread_mutex_lock(&S->mutex);
+  if (S->tail == NULL) {
+    S->head = r;
+  } else {
+    S->tail->next = r;
+  }
+  S->tail = r;
+  S->pending ++;
+  // Le serveur n'est réveillé qu'à l'arrivée d'une première requête ou
+  // lorsqu'un lot est complet.
+  if (S->pending == 1 || S->pending >= S->batch) {
+    pthread_cond_signal(&S->work);
+  }
+  pthread_mutex_unlock(&S->mutex);
+
+}
+
+/**********************
+ * matvec_server_wait *
+ **********************/
+
+void
+matvec_server_wait(matvec_server_t* S, matvec_request_t* r) {
+
+  pthread_mutex_lock(&S->mutex);
+  while (!r->done) {
+    pthread_cond_wait(&S->done, &S->mutex);
+  }
+  pthread_mutex_unlock(&S->mutex);
+
+}
+
+/************************
+ * matvec_server_matvec *
+ ************************/
+
+void
+matvec_server_matvec(matvec_server_t* S, const float x[], float b[]) {
+
+  matvec_request_t r;
+  matvec_server_submit(S, &r, x, b);
+  matvec_server_wait(S, &r);
+
+}
+
+/***********************
+ * matvec_server_stats *
+ ***********************/
+
+void
+matvec_server_stats(matvec_server_t* S,
+                    unsigned long* batches,
+                    unsigned long* requests) {
+
+  pthread_mutex_lock(&S->mutex);
+  *batches = S->batches;
+  *requests = S->requests;
+  pthread_mutex_unlock(&S->mutex);
+
+}
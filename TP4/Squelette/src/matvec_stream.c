@@ -0,0 +1,213 @@
+#define _POSIX_C_SOURCE 200809L // pread.
+
+#include "matvec_stream.h"
+#include "sgemv.h"
+
+#include <errno.h>
+#include <omp.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*
+ * État partagé entre le thread d'entrées-sorties et le thread de calcul. Le
+ * panneau k est lu dans le tampon k % 2 ; un tampon est plein lorsqu'il
+ * contient un panneau lu mais pas encore traité.
+ */
+typedef struct {
+  int fd;                 // Le fichier.
+  off_t offset;           // La position de la matrice dans le fichier.
+  unsigned size;          // La longueur de nos vecteurs.
+  unsigned panel;         // Le nombre de lignes par panneau.
+  unsigned panels;        // Le nombre de panneaux.
+  float* buffer[2];       // Les deux tampons.
+  int full[2];            // L'état des deux tampons.
+  int error;              // Non nul si une lecture a échoué.
+  double io;              // Durée cumulée des lectures.
+  pthread_mutex_t mutex;  // Protection de full et error.
+  pthread_cond_t cond;    // Signalement des changements d'état.
+} pipeline_t;
+
+/*
+ * Lecture de len octets à la position off, en reprenant les lectures
+ * partielles ou interrompues.
+ */
+static int
+read_all(const int fd, char* buf, size_t len, off_t off) {
+
+  while (len != 0) {
+    const ssize_t got = pread(fd, buf, len, off);
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got <= 0) {
+      return -1;
+    }
+    buf += got;
+    len -= got;
+    off += got;
+  }
+  return 0;
+
+}
+
+/*
+ * Nombre de lignes du panneau k (le dernier pouvant être incomplet).
+ */
+static inline unsigned
+rows_of(const pipeline_t* p, const unsigned k) {
+  const unsigned first = k * p->panel;
+  return p->size - first < p->panel ? p->size - first : p->panel;
+}
+
+/*
+ * Corps du thread d'entrées-sorties.
+ */
+static void*
+reader(void* arg) {
+
+  pipeline_t* p = (pipeline_t*) arg;
+  const size_t row = sizeof(float) * p->size;
+
+  for (unsigned k = 0; k != p->panels; k ++) {
+
+    const unsigned slot = k % 2;
+
+    // Attente de la libération du tampon par le thread de calcul.
+    pthread_mutex_lock(&p->mutex);
+    while (p->full[slot]) {
+      pthread_cond_wait(&p->cond, &p->mutex);
+    }
+    pthread_mutex_unlock(&p->mutex);
+
+    const double start = omp_get_wtime();
+    const int status = read_all(p->fd,
+                                (char*) p->buffer[slot],
+                                row * rows_of(p, k),
+                                p->offset + (off_t) row * k * p->panel);
+    p->io += omp_get_wtime() - start;
+
+    pthread_mutex_lock(&p->mutex);
+    if (status != 0) {
+      p->error = 1;
+    } else {
+      p->full[slot] = 1;
+    }
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->mutex);
+
+    if (status != 0) {
+      break;
+    }
+
+  }
+
+  return NULL;
+
+}
+
+/*****************
+ * matvec_stream *
+ *****************/
+
+int
+matvec_stream(const int fd,
+              const off_t offset,
+              const float x[],
+                    float b[],
+              const unsigned size,
+              const unsigned panel,
+              matvec_stream_stats_t* stats) {
+
+  const double start = omp_get_wtime();
+
+  if (size == 0) {
+    if (stats != NULL) {
+      stats->total = omp_get_wtime() - start;
+      stats->io = stats->compute = stats->overlap = 0.0;
+    }
+    return 0;
+  }
+
+  pipeline_t p;
+  p.fd = fd;
+  p.offset = offset;
+  p.size = size;
+  p.panel = panel != 0 ? panel : (1u << 20) / (sizeof(float) * size);
+  if (p.panel == 0) {
+    p.panel = 1;
+  }
+  if (p.panel > size) {
+    p.panel = size;
+  }
+  p.panels = (size + p.panel - 1) / p.panel;
+  p.buffer[0] = (float*) malloc(sizeof(float) * p.panel * size);
+  p.buffer[1] = (float*) malloc(sizeof(float) * p.panel * size);
+  p.full[0] = p.full[1] = 0;
+  p.error = 0;
+  p.io = 0.0;
+  pthread_mutex_init(&p.mutex, NULL);
+  pthread_cond_init(&p.cond, NULL);
+
+  // Sans tampons ni thread d'entrées-sorties, le thread de calcul attendrait
+  // indéfiniment le premier panneau.
+  pthread_t io;
+  if (p.buffer[0] == NULL || p.buffer[1] == NULL
+      || pthread_create(&io, NULL, reader, &p) != 0) {
+    pthread_mutex_destroy(&p.mutex);
+    pthread_cond_destroy(&p.cond);
+    free(p.buffer[0]);
+    free(p.buffer[1]);
+    return -1;
+  }
+
+  double compute = 0.0;
+  for (unsigned k = 0; k != p.panels; k ++) {
+
+    const unsigned slot = k % 2;
+
+    // Attente du panneau k.
+    pthread_mutex_lock(&p.mutex);
+    while (!p.full[slot] && !p.error) {
+      pthread_cond_wait(&p.cond, &p.mutex);
+    }
+    const int ready = p.full[slot];
+    pthread_mutex_unlock(&p.mutex);
+    if (!ready) {
+      break;
+    }
+
+    // Produit du panneau : ses lignes sont contiguës et de longueur size.
+    const double begin = omp_get_wtime();
+    sgemv(SGEMV_ROW_MAJOR, SGEMV_NO_TRANS, rows_of(&p, k), size,
+          1.0f, p.buffer[slot], size, x, 1, 0.0f, b + k * p.panel, 1);
+    compute += omp_get_wtime() - begin;
+
+    // Libération du tampon au profit du panneau k + 2.
+    pthread_mutex_lock(&p.mutex);
+    p.full[slot] = 0;
+    pthread_cond_broadcast(&p.cond);
+    pthread_mutex_unlock(&p.mutex);
+
+  }
+
+  pthread_join(io, NULL);
+  pthread_mutex_destroy(&p.mutex);
+  pthread_cond_destroy(&p.cond);
+  free(p.buffer[0]);
+  free(p.buffer[1]);
+
+  if (stats != NULL) {
+    stats->total = omp_get_wtime() - start;
+    stats->io = p.io;
+    stats->compute = compute;
+    const double shortest = p.io < compute ? p.io : compute;
+    const double hidden = p.io + compute - stats->total;
+    stats->overlap = shortest > 0.0 && hidden > 0.0
+      ? 100.0 * (hidden < shortest ? hidden : shortest) / shortest
+      : 0.0;
+  }
+
+  return p.error ? -1 : 0;
+
+}
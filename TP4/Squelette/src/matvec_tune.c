@@ -0,0 +1,302 @@
+#define _POSIX_C_SOURCE 200809L // pthread_once.
+
+#include "matvec_tune.h"
+#include "matvec.h"
+#include "matvec_r4.h"
+#include "matvec_sse_r4.h"
+#include "matvec_fixed.h"
+#include "sgemv.h"
+
+#include <omp.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TABLE_MAX 64 // Nombre maximal de configurations dans la table.
+
+// Noms des noyaux tels qu'ils apparaissent dans le fichier de tuning.
+static const char* names[MATVEC_KERNELS] = {
+  "raw", "r4", "sse_r4", "sgemv", "fixed", "param"
+};
+
+// Table de tuning utilisée par matvec_tuned.
+static matvec_tuning_t table[TABLE_MAX];
+static unsigned entries = 0;
+static int loaded = 0;
+static pthread_once_t once = PTHREAD_ONCE_INIT;
+
+/*
+ * Exécution d'un produit avec la configuration fournie.
+ */
+static void
+run(const matvec_tuning_t* conf,
+    const float A[restrict],
+    const float x[restrict],
+          float b[restrict],
+    const unsigned size) {
+
+  switch (conf->kernel) {
+  case MATVEC_RAW:
+    matvec(A, x, b, size);
+    break;
+  case MATVEC_R4:
+    matvec_r4(A, x, b, size);
+    break;
+  case MATVEC_SGEMV:
+    sgemv(SGEMV_ROW_MAJOR, SGEMV_NO_TRANS, size, size,
+          1.0f, A, size, x, 1, 0.0f, b, 1);
+    break;
+  case MATVEC_FIXED:
+    matvec_fixed(A, x, b, size);
+    break;
+  case MATVEC_PARAM:
+    matvec_param(A, x, b, size, &conf->param);
+    break;
+  default:
+    matvec_sse_r4(A, x, b, size);
+    break;
+  }
+
+}
+
+/*
+ * Mesure de la performance (en GFLOP/s) d'une configuration. Le nombre de
+ * répétitions est choisi de façon à ce que chaque mesure porte sur environ
+ * 2^27 opérations flottantes, et la meilleure de trois mesures est retenue.
+ */
+static double
+measure(const matvec_tuning_t* conf,
+        const float A[restrict],
+        const float x[restrict],
+              float b[restrict],
+        const unsigned size) {
+
+  const unsigned reps = 1 + (1u << 26) / (size * size);
+
+  // Mise en cache préalable.
+  run(conf, A, x, b, size);
+
+  double best = -1.0;
+  for (unsigned t = 0; t != 3; t ++) {
+    const double start = omp_get_wtime();
+    for (unsigned r = 0; r != reps; r ++) {
+      run(conf, A, x, b, size);
+    }
+    const double elapsed = omp_get_wtime() - start;
+    if (best < 0.0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+
+  return 2.0 * size * size * reps / best * 1e-9;
+
+}
+
+/*
+ * Évaluation d'une configuration candidate et mise à jour de la meilleure.
+ */
+static void
+consider(matvec_tuning_t* best,
+         matvec_tuning_t conf,
+         const float A[restrict],
+         const float x[restrict],
+               float b[restrict],
+         const int verbose) {
+
+  conf.gflops = measure(&conf, A, x, b, conf.size);
+  if (verbose) {
+    printf("%6u %-7s u=%u r=%u pf=%3u t=%2u : %7.3f GFLOP/s\n",
+           conf.size, names[conf.kernel],
+           conf.param.unroll, conf.param.rows,
+           conf.param.prefetch, conf.param.threads,
+           conf.gflops);
+  }
+  if (conf.gflops > best->gflops) {
+    *best = conf;
+  }
+
+}
+
+/***************
+ * matvec_tune *
+ ***************/
+
+int
+matvec_tune(const char* path,
+            const unsigned sizes[],
+            const unsigned count,
+            const int verbose) {
+
+  // Espace de recherche du noyau paramétrable.
+  static const unsigned unrolls[]    = { 1, 2, 4 };
+  static const unsigned rows[]       = { 1, 2, 4 };
+  static const unsigned prefetches[] = { 0, 64, 256 };
+
+  // Nombres de threads évalués : les puissances de 2 inférieures au maximum
+  // disponible, puis ce maximum.
+  const unsigned maxThreads = omp_get_max_threads();
+  unsigned threads[32];
+  unsigned nthreads = 0;
+  for (unsigned t = 1; t < maxThreads && nthreads != 31; t *= 2) {
+    threads[nthreads ++] = t;
+  }
+  threads[nthreads ++] = maxThreads;
+
+  FILE* out = fopen(path, "w");
+  if (out == NULL) {
+    return -1;
+  }
+  fprintf(out, "# size kernel unroll rows prefetch threads gflops\n");
+
+  for (unsigned s = 0; s != count; s ++) {
+
+    const unsigned size = sizes[s];
+    float* A = (float*) aligned_alloc(16, sizeof(float) * size * size);
+    float* x = (float*) aligned_alloc(16, sizeof(float) * size);
+    float* b = (float*) aligned_alloc(16, sizeof(float) * size);
+    for (unsigned i = 0; i != size * size; A[i ++] = 1.0);
+    for (unsigned i = 0; i != size;        x[i ++] = 1.0);
+
+    matvec_tuning_t best;
+    memset(&best, 0, sizeof(best));
+
+    // Noyaux non paramétrables.
+    for (int k = MATVEC_RAW; k != MATVEC_PARAM; k ++) {
+      const matvec_tuning_t conf = {
+        size, (matvec_kernel_t) k, { 1, 1, 0, 1 }, 0.0
+      };
+      consider(&best, conf, A, x, b, verbose);
+    }
+
+    // Noyau paramétrable : produit cartésien des paramètres.
+    for (unsigned t = 0; t != nthreads; t ++) {
+      for (unsigned u = 0; u != sizeof(unrolls) / sizeof(unsigned); u ++) {
+        for (unsigned r = 0; r != sizeof(rows) / sizeof(unsigned); r ++) {
+          for (unsigned p = 0; p != sizeof(prefetches) / sizeof(unsigned); p ++) {
+            const matvec_tuning_t conf = {
+              size, MATVEC_PARAM,
+              { unrolls[u], rows[r], prefetches[p], threads[t] }, 0.0
+            };
+            consider(&best, conf, A, x, b, verbose);
+          }
+        }
+      }
+    }
+
+    fprintf(out, "%u %s %u %u %u %u %.3f\n",
+            best.size, names[best.kernel],
+            best.param.unroll, best.param.rows,
+            best.param.prefetch, best.param.threads,
+            best.gflops);
+
+    free(A);
+    free(x);
+    free(b);
+
+  }
+
+  fclose(out);
+  return 0;
+
+}
+
+/********************
+ * matvec_tune_load *
+ ********************/
+
+int
+matvec_tune_load(const char* path) {
+
+  loaded = 1;
+  entries = 0;
+
+  FILE* in = fopen(path, "r");
+  if (in == NULL) {
+    return -1;
+  }
+
+  char line[256];
+  while (entries != TABLE_MAX && fgets(line, sizeof(line), in) != NULL) {
+    if (line[0] == '#') {
+      continue;
+    }
+    char name[16];
+    matvec_tuning_t conf;
+    if (sscanf(line, "%u %15s %u %u %u %u %lf",
+               &conf.size, name,
+               &conf.param.unroll, &conf.param.rows,
+               &conf.param.prefetch, &conf.param.threads,
+               &conf.gflops) != 7) {
+      continue;
+    }
+    conf.kernel = MATVEC_SSE_R4;
+    for (int k = 0; k != MATVEC_KERNELS; k ++) {
+      if (strcmp(name, names[k]) == 0) {
+        conf.kernel = (matvec_kernel_t) k;
+      }
+    }
+    table[entries ++] = conf;
+  }
+
+  fclose(in);
+  return 0;
+
+}
+
+/**********************
+ * matvec_tune_lookup *
+ **********************/
+
+matvec_tuning_t
+matvec_tune_lookup(const unsigned size) {
+
+  matvec_tuning_t conf = { size, MATVEC_SSE_R4, { 1, 1, 0, 1 }, 0.0 };
+
+  // La distance entre deux tailles est leur rapport, ce qui revient à une
+  // distance en échelle logarithmique.
+  double nearest = 0.0;
+  for (unsigned e = 0; e != entries; e ++) {
+    const double ratio = table[e].size > size
+      ? (double) table[e].size / size
+      : (double) size / table[e].size;
+    if (e == 0 || ratio < nearest) {
+      nearest = ratio;
+      conf = table[e];
+    }
+  }
+
+  return conf;
+
+}
+
+/*
+ * Chargement de la table par défaut lors du premier appel à matvec_tuned,
+ * sauf si une table a déjà été chargée explicitement.
+ */
+static void
+load_default(void) {
+
+  if (!loaded) {
+    const char* path = getenv("MATVEC_TUNE_FILE");
+    matvec_tune_load(path != NULL ? path : MATVEC_TUNE_DEFAULT);
+  }
+
+}
+
+/****************
+ * matvec_tuned *
+ ****************/
+
+void
+matvec_tuned(const float A[restrict],
+             const float x[restrict],
+                   float b[restrict],
+             const unsigned size) {
+
+  pthread_once(&once, load_default);
+
+  const matvec_tuning_t conf = matvec_tune_lookup(size);
+  run(&conf, A, x, b, size);
+
+}
@@ -0,0 +1,234 @@
+#include "matvec_wide.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <x86intrin.h>
+#include <omp.h>
+
+#define MIN_COLS 64 // Nombre minimal de colonnes par thread.
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Produit des lignes r0 à r1 - 1, restreintes aux colonnes c0 à c1 - 1, par
+ * le segment correspondant de x : out[i - r0] reçoit la contribution de la
+ * ligne i. Quatre lignes sont traitées simultanément, leurs accumulateurs
+ * étant transposés en fin de tranche. Un dernier groupe incomplet répète sa
+ * dernière ligne plutôt que de relire x ligne par ligne : pour une matrice de
+ * 2 lignes très longues, x n'est ainsi lu qu'une fois.
+ */
+static void
+block(const float A[restrict],
+      const unsigned cols,
+      const float x[restrict],
+      const unsigned r0,
+      const unsigned r1,
+      const unsigned c0,
+      const unsigned c1,
+            float out[restrict]) {
+
+  const unsigned c4 = c0 + ((c1 - c0) & ~3u);
+
+  for (unsigned i = r0; i < r1; i += 4) {
+    const unsigned last = r1 - 1;
+    const float* A0 = A + (size_t) i * cols;
+    const float* A1 = A + (size_t) (i + 1 < last ? i + 1 : last) * cols;
+    const float* A2 = A + (size_t) (i + 2 < last ? i + 2 : last) * cols;
+    const float* A3 = A + (size_t) (i + 3 < last ? i + 3 : last) * cols;
+
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+    unsigned k = c0;
+    for (; k != c4; k += 4) {
+      const __m128 xx = _mm_loadu_ps(x + k);
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(A0 + k), xx));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(A1 + k), xx));
+      acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(A2 + k), xx));
+      acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(A3 + k), xx));
+    }
+
+    _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+    xmm_t dot;
+    dot.m128_vec = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+    for (; k != c1; k ++) {
+      dot.m128_f32[0] += A0[k] * x[k];
+      dot.m128_f32[1] += A1[k] * x[k];
+      dot.m128_f32[2] += A2[k] * x[k];
+      dot.m128_f32[3] += A3[k] * x[k];
+    }
+    if (i + 4 <= r1) {
+      _mm_storeu_ps(out + (i - r0), dot.m128_vec);
+    } else {
+      for (unsigned r = 0; i + r != r1; r ++) {
+        out[i - r0 + r] = dot.m128_f32[r];
+      }
+    }
+  }
+
+}
+
+/*
+ * Somme dst = a + b de deux vecteurs partiels (alignés sur 16 octets et
+ * complétés à un multiple de 4 composantes).
+ */
+static inline void
+add(float dst[], const float a[], const float b[], const unsigned len) {
+  for (unsigned i = 0; i < len; i += 4) {
+    _mm_store_ps(dst + i, _mm_add_ps(_mm_load_ps(a + i), _mm_load_ps(b + i)));
+  }
+}
+
+/*
+ * Répartition par lignes : les groupes de 4 lignes sont distribués entre
+ * les threads.
+ */
+static void
+by_rows(const float A[restrict],
+        const float x[restrict],
+              float b[restrict],
+        const unsigned rows,
+        const unsigned cols) {
+
+  const int groups = (int) ((rows + 3) / 4);
+
+#pragma omp parallel for schedule(static)
+  for (int g = 0; g < groups; g ++) {
+    const unsigned r0 = 4 * g;
+    const unsigned r1 = r0 + 4 < rows ? r0 + 4 : rows;
+    block(A, cols, x, r0, r1, 0, cols, b + r0);
+  }
+
+}
+
+/*
+ * Répartition par colonnes, suivie de la réduction en arbre des vecteurs
+ * partiels.
+ */
+static void
+by_cols(const float A[restrict],
+        const float x[restrict],
+              float b[restrict],
+        const unsigned rows,
+        const unsigned cols) {
+
+  // Vecteurs partiels espacés d'un multiple de 16 floats (64 octets).
+  const unsigned stride = (rows + 15) & ~15u;
+  const int max = omp_get_max_threads();
+  float* partial =
+    (float*) aligned_alloc(64, sizeof(float) * stride * (size_t) max);
+
+#pragma omp parallel
+  {
+
+    const unsigned t = omp_get_thread_num();
+    const unsigned threads = omp_get_num_threads();
+
+    // Tranches de colonnes de largeur multiple de 4.
+    const unsigned width = ((cols + threads - 1) / threads + 3) & ~3u;
+    const unsigned c0 = t * width < cols ? t * width : cols;
+    const unsigned c1 = c0 + width < cols ? c0 + width : cols;
+    float* mine = partial + (size_t) t * stride;
+    block(A, cols, x, 0, rows, c0, c1, mine);
+    for (unsigned i = rows; i != stride; i ++) {
+      mine[i] = 0.0f;
+    }
+
+    // Réduction : au niveau de pas step, le thread t (multiple de 2 step)
+    // reçoit le vecteur du thread t + step. Le dernier niveau écrit
+    // directement dans b.
+    for (unsigned step = 1; step < threads; step *= 2) {
+#pragma omp barrier
+      if (t % (2 * step) == 0 && t + step < threads) {
+        const float* other = partial + (size_t) (t + step) * stride;
+        if (2 * step >= threads) {
+          for (unsigned i = 0; i != rows; i ++) {
+            b[i] = mine[i] + other[i];
+          }
+        } else {
+          add(mine, mine, other, stride);
+        }
+      }
+    }
+    if (threads == 1) {
+      for (unsigned i = 0; i != rows; i ++) {
+        b[i] = mine[i];
+      }
+    }
+
+  }
+
+  free(partial);
+
+}
+
+/*********************
+ * matvec_wide_split *
+ *********************/
+
+matvec_split_t
+matvec_wide_split(const unsigned rows,
+                  const unsigned cols,
+                  const unsigned threads) {
+
+  if (threads <= 1 || cols < MIN_COLS * threads) {
+    return MATVEC_SPLIT_ROWS;
+  }
+
+  // Coûts exprimés en éléments traités par le thread le plus chargé. Une
+  // composante de vecteur partiel (écrite, relue puis sommée, avec une
+  // barrière par niveau) est comptée comme 4 éléments de la matrice.
+  const unsigned groups = ((rows + 3) / 4 + threads - 1) / threads;
+  const double by_rows = 4.0 * groups * cols;
+  unsigned levels = 0;
+  while ((1u << levels) < threads) {
+    levels ++;
+  }
+  const double by_cols =
+    (double) rows * cols / threads + 4.0 * rows * (levels + 1);
+
+  return by_cols < by_rows ? MATVEC_SPLIT_COLS : MATVEC_SPLIT_ROWS;
+
+}
+
+/******************
+ * matvec_wide_by *
+ ******************/
+
+void
+matvec_wide_by(const float A[restrict],
+               const float x[restrict],
+                     float b[restrict],
+               const unsigned rows,
+               const unsigned cols,
+               const matvec_split_t split) {
+
+  if (split == MATVEC_SPLIT_COLS) {
+    by_cols(A, x, b, rows, cols);
+  } else {
+    by_rows(A, x, b, rows, cols);
+  }
+
+}
+
+/***************
+ * matvec_wide *
+ ***************/
+
+void
+matvec_wide(const float A[restrict],
+            const float x[restrict],
+                  float b[restrict],
+            const unsigned rows,
+            const unsigned cols) {
+
+  matvec_wide_by(A, x, b, rows, cols,
+                       matvec_wide_split(rows, cols, omp_get_max_threads()));
+
+}
@@ -0,0 +1,875 @@
+#define _POSIX_C_SOURCE 200809L // mmap, fstat, posix_madvise.
+
+#include "mtx.h"
+
+#include <ctype.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <omp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAGIC "MVCACHE1" // Signature des fichiers cache (8 octets).
+
+// Contenu d'un fichier cache.
+enum { CACHE_DENSE = 0, CACHE_CSR = 1 };
+
+// Attributs d'un fichier Matrix Market.
+enum { ARRAY, COORDINATE };
+enum { REAL, INTEGER, PATTERN };
+enum { GENERAL, SYMMETRIC, SKEW };
+
+/*
+ * Entête d'un fichier cache, suivi des données : la matrice dense, ou les
+ * tableaux ptr, col et val d'une matrice CSR.
+ */
+typedef struct {
+  char magic[8];   // La signature MAGIC.
+  uint32_t kind;   // Le contenu (CACHE_DENSE ou CACHE_CSR).
+  uint32_t rows;   // Le nombre de lignes.
+  uint32_t cols;   // Le nombre de colonnes.
+  uint32_t word;   // La taille de size_t lors de l'écriture.
+  uint64_t nnz;    // Le nombre d'éléments non nuls (CSR uniquement).
+} cache_t;
+
+/*
+ * Fichier projeté en mémoire.
+ */
+typedef struct {
+  const char* data; // Le contenu.
+  size_t len;       // Sa taille en octets.
+} mapping_t;
+
+/*
+ * Entête d'un fichier Matrix Market.
+ */
+typedef struct {
+  int format;         // ARRAY ou COORDINATE.
+  int field;          // REAL, INTEGER ou PATTERN.
+  int symmetry;       // GENERAL, SYMMETRIC ou SKEW.
+  unsigned rows;      // Le nombre de lignes.
+  unsigned cols;      // Le nombre de colonnes.
+  size_t entries;     // Le nombre d'éléments stockés dans le fichier.
+  const char* body;   // Le début des éléments.
+} header_t;
+
+/*
+ * Éléments lus dans un fichier Matrix Market, avant développement des
+ * éléments symétriques.
+ */
+typedef struct {
+  unsigned rows;  // Le nombre de lignes.
+  unsigned cols;  // Le nombre de colonnes.
+  size_t count;   // Le nombre d'éléments.
+  int format;     // ARRAY ou COORDINATE.
+  int symmetry;   // GENERAL, SYMMETRIC ou SKEW.
+  unsigned* I;    // Ligne de chaque élément.
+  unsigned* J;    // Colonne de chaque élément.
+  float* V;       // Valeur de chaque élément.
+} triplets_t;
+
+/*
+ * Puissances de 10 représentées exactement en double précision.
+ */
+static const double powers[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+ * Projection d'un fichier en mémoire.
+ */
+static int
+map(const char* path, mapping_t* m) {
+
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return -1;
+  }
+  m->len = (size_t) st.st_size;
+  void* data = mmap(NULL, m->len, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return -1;
+  }
+  // Les tranches étant lues simultanément, la lecture anticipée porte sur
+  // tout le fichier plutôt que sur un parcours séquentiel.
+  posix_madvise(data, m->len, POSIX_MADV_WILLNEED);
+  m->data = (const char*) data;
+  return 0;
+
+}
+
+/*
+ * Fin de projection.
+ */
+static void
+unmap(mapping_t* m) {
+  munmap((void*) m->data, m->len);
+}
+
+/*
+ * Caractères séparant les champs d'une ligne.
+ */
+static inline int
+blank(const char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/*
+ * Saut des séparateurs.
+ */
+static inline const char*
+skip(const char* p, const char* end) {
+  while (p != end && blank(*p)) {
+    p ++;
+  }
+  return p;
+}
+
+/*
+ * Début de la ligne suivante.
+ */
+static inline const char*
+next_line(const char* p, const char* end) {
+  const char* q = (const char*) memchr(p, '\n', end - p);
+  return q != NULL ? q + 1 : end;
+}
+
+/*
+ * Lecture d'un entier non signé. Retourne la position suivant l'entier, ou
+ * NULL si aucun chiffre n'a été lu.
+ */
+static inline const char*
+parse_unsigned(const char* p, const char* end, size_t* v) {
+
+  p = skip(p, end);
+  const char* start = p;
+  size_t n = 0;
+  for (; p != end && *p >= '0' && *p <= '9'; p ++) {
+    n = n * 10 + (size_t) (*p - '0');
+  }
+  *v = n;
+  return p != start ? p : NULL;
+
+}
+
+/*
+ * Lecture d'un nombre flottant ([signe] chiffres [. chiffres] [e [signe]
+ * chiffres]). Les 19 premiers chiffres significatifs sont accumulés dans un
+ * entier 64 bits, puis mis à l'échelle en double précision par une puissance
+ * de 10 exacte lorsque c'est possible. Retourne la position suivant le
+ * nombre, ou NULL s'il est mal formé.
+ */
+static inline const char*
+parse_float(const char* p, const char* end, float* v) {
+
+  p = skip(p, end);
+  int negative = 0;
+  if (p != end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    p ++;
+  }
+
+  uint64_t mantissa = 0;
+  int digits = 0, scale = 0, seen = 0;
+  for (; p != end && *p >= '0' && *p <= '9'; p ++) {
+    seen = 1;
+    if (digits < 19) {
+      mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+      digits += mantissa != 0;
+    } else {
+      scale ++;
+    }
+  }
+  if (p != end && *p == '.') {
+    for (p ++; p != end && *p >= '0' && *p <= '9'; p ++) {
+      seen = 1;
+      if (digits < 19) {
+        mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+        digits += mantissa != 0;
+        scale --;
+      }
+    }
+  }
+  if (!seen) {
+    return NULL;
+  }
+
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    p ++;
+    int down = 0;
+    if (p != end && (*p == '-' || *p == '+')) {
+      down = *p == '-';
+      p ++;
+    }
+    const char* start = p;
+    int exponent = 0;
+    for (; p != end && *p >= '0' && *p <= '9'; p ++) {
+      if (exponent < 10000) {
+        exponent = exponent * 10 + (*p - '0');
+      }
+    }
+    if (p == start) {
+      return NULL;
+    }
+    scale += down ? -exponent : exponent;
+  }
+
+  double d = (double) mantissa;
+  if (scale >= 0 && scale <= 22) {
+    d *= powers[scale];
+  } else if (scale < 0 && scale >= -22) {
+    d /= powers[-scale];
+  } else {
+    d *= pow(10.0, scale);
+  }
+  *v = (float) (negative ? -d : d);
+  return p;
+
+}
+
+/*
+ * Lecture d'un mot de l'entête, converti en minuscules.
+ */
+static int
+word(const char** p, const char* end, char buf[], const size_t size) {
+
+  const char* q = skip(*p, end);
+  size_t n = 0;
+  for (; q != end && !blank(*q) && *q != '\n'; q ++) {
+    if (n + 1 < size) {
+      buf[n ++] = (char) tolower((unsigned char) *q);
+    }
+  }
+  buf[n] = '\0';
+  *p = q;
+  return n != 0;
+
+}
+
+/*
+ * Analyse de l'entête d'un fichier Matrix Market.
+ */
+static int
+header(const mapping_t* m, header_t* h) {
+
+  const char* p = m->data;
+  const char* end = p + m->len;
+  char buf[32];
+
+  if (!word(&p, end, buf, sizeof(buf)) || strcmp(buf, "%%matrixmarket") != 0
+      || !word(&p, end, buf, sizeof(buf)) || strcmp(buf, "matrix") != 0) {
+    return -1;
+  }
+
+  word(&p, end, buf, sizeof(buf));
+  if (strcmp(buf, "coordinate") == 0) {
+    h->format = COORDINATE;
+  } else if (strcmp(buf, "array") == 0) {
+    h->format = ARRAY;
+  } else {
+    return -1;
+  }
+
+  word(&p, end, buf, sizeof(buf));
+  if (strcmp(buf, "real") == 0 || strcmp(buf, "double") == 0) {
+    h->field = REAL;
+  } else if (strcmp(buf, "integer") == 0) {
+    h->field = INTEGER;
+  } else if (strcmp(buf, "pattern") == 0 && h->format == COORDINATE) {
+    h->field = PATTERN;
+  } else {
+    return -1;
+  }
+
+  word(&p, end, buf, sizeof(buf));
+  if (strcmp(buf, "general") == 0) {
+    h->symmetry = GENERAL;
+  } else if (strcmp(buf, "symmetric") == 0) {
+    h->symmetry = SYMMETRIC;
+  } else if (strcmp(buf, "skew-symmetric") == 0) {
+    h->symmetry = SKEW;
+  } else {
+    return -1;
+  }
+
+  // Commentaires et lignes vides précédant la ligne des dimensions.
+  p = next_line(p, end);
+  for (;;) {
+    const char* q = skip(p, end);
+    if (q == end) {
+      return -1;
+    }
+    if (*q != '%' && *q != '\n') {
+      break;
+    }
+    p = next_line(q, end);
+  }
+
+  size_t rows, cols, entries = 0;
+  p = parse_unsigned(p, end, &rows);
+  p = p != NULL ? parse_unsigned(p, end, &cols) : NULL;
+  if (p != NULL && h->format == COORDINATE) {
+    p = parse_unsigned(p, end, &entries);
+  }
+  if (p == NULL || rows > UINT_MAX || cols > UINT_MAX
+      || (h->symmetry != GENERAL && rows != cols)) {
+    return -1;
+  }
+  if (h->format == ARRAY) {
+    entries = h->symmetry == GENERAL ? rows * cols
+      : h->symmetry == SYMMETRIC ? rows * (rows + 1) / 2
+      : rows * (rows - 1) / 2;
+  }
+
+  h->rows = (unsigned) rows;
+  h->cols = (unsigned) cols;
+  h->entries = entries;
+  h->body = next_line(p, end);
+  return 0;
+
+}
+
+/*
+ * Première ligne stockée de la colonne j d'un fichier « array » : la partie
+ * triangulaire inférieure seule est stockée pour une matrice symétrique, et
+ * sans la diagonale pour une matrice antisymétrique.
+ */
+static inline size_t
+first_row(const header_t* h, const size_t j) {
+  return h->symmetry == GENERAL ? 0 : h->symmetry == SYMMETRIC ? j : j + 1;
+}
+
+/*
+ * Nombre de lignes non vides d'une tranche.
+ */
+static size_t
+count_lines(const char* p, const char* end) {
+
+  size_t n = 0;
+  while (p != end) {
+    const char* q = skip(p, end);
+    n += q != end && *q != '\n';
+    p = next_line(q, end);
+  }
+  return n;
+
+}
+
+/*
+ * Analyse d'une tranche dont le premier élément porte le numéro e.
+ */
+static int
+parse_slice(const header_t* h,
+            const char* p,
+            const char* end,
+            size_t e,
+            triplets_t* T) {
+
+  // Position du premier élément d'une tranche de fichier « array », stocké
+  // colonne par colonne.
+  size_t i = 0, j = 0;
+  if (h->format == ARRAY) {
+    size_t rest = e;
+    while (j < h->cols && rest >= h->rows - first_row(h, j)) {
+      rest -= h->rows - first_row(h, j);
+      j ++;
+    }
+    i = first_row(h, j) + rest;
+  }
+
+  while (p != end) {
+
+    const char* q = skip(p, end);
+    if (q == end || *q == '\n') {
+      p = next_line(q, end);
+      continue;
+    }
+
+    size_t r, c;
+    float v = 1.0f;
+    if (h->format == COORDINATE) {
+      q = parse_unsigned(q, end, &r);
+      q = q != NULL ? parse_unsigned(q, end, &c) : NULL;
+      if (q == NULL || r == 0 || r > h->rows || c == 0 || c > h->cols) {
+        return -1;
+      }
+      r --;
+      c --;
+      if (h->field != PATTERN) {
+        q = parse_float(q, end, &v);
+      }
+    } else {
+      if (j >= h->cols) {
+        return -1;
+      }
+      q = parse_float(q, end, &v);
+      r = i;
+      c = j;
+      if (++ i == h->rows) {
+        j ++;
+        i = first_row(h, j);
+      }
+    }
+
+    if (q == NULL) {
+      return -1;
+    }
+    q = skip(q, end);
+    if (q != end && *q != '\n') {
+      return -1;
+    }
+
+    T->I[e] = (unsigned) r;
+    T->J[e] = (unsigned) c;
+    T->V[e] = v;
+    e ++;
+    p = next_line(q, end);
+
+  }
+
+  return 0;
+
+}
+
+/*
+ * Lecture de tous les éléments d'un fichier Matrix Market : le corps du
+ * fichier est découpé en tranches aux frontières de lignes, chaque thread
+ * compte les éléments de sa tranche, puis, connaissant le numéro de son
+ * premier élément, les analyse.
+ */
+static int
+parse(const mapping_t* m, triplets_t* T) {
+
+  header_t h;
+  if (header(m, &h) != 0) {
+    return -1;
+  }
+
+  const char* end = m->data + m->len;
+  const size_t len = end - h.body;
+  const int slices = omp_get_max_threads();
+  const char** bound = (const char**) malloc(sizeof(char*) * (slices + 1));
+  size_t* first = (size_t*) malloc(sizeof(size_t) * (slices + 1));
+
+  bound[0] = h.body;
+  for (int t = 1; t != slices; t ++) {
+    const char* q = h.body + len * t / slices;
+    if (q <= bound[t - 1]) {
+      q = bound[t - 1];
+    } else if (q[-1] != '\n') {
+      q = next_line(q, end);
+    }
+    bound[t] = q;
+  }
+  bound[slices] = end;
+
+  // Numérotation des éléments.
+  first[0] = 0;
+#pragma omp parallel for schedule(static, 1)
+  for (int t = 0; t < slices; t ++) {
+    first[t + 1] = count_lines(bound[t], bound[t + 1]);
+  }
+  for (int t = 0; t != slices; t ++) {
+    first[t + 1] += first[t];
+  }
+
+  int error = first[slices] != h.entries;
+  if (!error) {
+    T->rows = h.rows;
+    T->cols = h.cols;
+    T->count = h.entries;
+    T->format = h.format;
+    T->symmetry = h.symmetry;
+    T->I = (unsigned*) malloc(sizeof(unsigned) * (h.entries ? h.entries : 1));
+    T->J = (unsigned*) malloc(sizeof(unsigned) * (h.entries ? h.entries : 1));
+    T->V = (float*) malloc(sizeof(float) * (h.entries ? h.entries : 1));
+
+#pragma omp parallel for schedule(static, 1) reduction(|:error)
+    for (int t = 0; t < slices; t ++) {
+      error |= parse_slice(&h, bound[t], bound[t + 1], first[t], T) != 0;
+    }
+
+    if (error) {
+      free(T->I);
+      free(T->J);
+      free(T->V);
+    }
+  }
+
+  free(bound);
+  free(first);
+  return error ? -1 : 0;
+
+}
+
+/*
+ * Ordre des éléments d'une ligne : par colonnes, puis par valeurs afin que
+ * l'ordre des doublons éventuels soit déterministe.
+ */
+typedef struct {
+  unsigned col;
+  float val;
+} entry_t;
+
+static int
+compare(const void* a, const void* b) {
+
+  const entry_t* x = (const entry_t*) a;
+  const entry_t* y = (const entry_t*) b;
+  if (x->col != y->col) {
+    return x->col < y->col ? -1 : 1;
+  }
+  return (x->val > y->val) - (x->val < y->val);
+
+}
+
+/*
+ * Construction de la matrice CSR : les éléments (et leurs symétriques) sont
+ * comptés ligne par ligne, puis répartis en parallèle, chaque position étant
+ * réservée par incrément atomique. Les lignes sont enfin triées et les
+ * doublons fusionnés, leurs valeurs s'ajoutant (convention Matrix Market) ;
+ * le tri préalable par valeurs rend cette somme déterministe.
+ */
+static csr_t*
+to_csr(const triplets_t* T) {
+
+  const long count = (long) T->count;
+  const int mirror = T->symmetry != GENERAL;
+  const float sign = T->symmetry == SKEW ? -1.0f : 1.0f;
+  size_t* next = (size_t*) calloc((size_t) T->rows + 1, sizeof(size_t));
+
+#pragma omp parallel for schedule(static)
+  for (long e = 0; e < count; e ++) {
+#pragma omp atomic
+    next[T->I[e] + 1] ++;
+    if (mirror && T->I[e] != T->J[e]) {
+#pragma omp atomic
+      next[T->J[e] + 1] ++;
+    }
+  }
+  for (unsigned i = 0; i != T->rows; i ++) {
+    next[i + 1] += next[i];
+  }
+
+  csr_t* C = csr_create(T->rows, T->cols, next[T->rows]);
+  memcpy(C->ptr, next, sizeof(size_t) * ((size_t) T->rows + 1));
+
+#pragma omp parallel for schedule(static)
+  for (long e = 0; e < count; e ++) {
+    const unsigned i = T->I[e], j = T->J[e];
+    size_t k;
+#pragma omp atomic capture
+    k = next[i] ++;
+    C->col[k] = j;
+    C->val[k] = T->V[e];
+    if (mirror && i != j) {
+#pragma omp atomic capture
+      k = next[j] ++;
+      C->col[k] = i;
+      C->val[k] = sign * T->V[e];
+    }
+  }
+
+  // Tri puis fusion de chaque ligne ; next reçoit le nombre d'éléments
+  // distincts de chaque ligne.
+  next[0] = 0;
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < (int) C->rows; i ++) {
+    const size_t begin = C->ptr[i], n = C->ptr[i + 1] - begin;
+    // Seule une ligne de colonnes strictement croissantes, donc sans
+    // doublons, échappe au tri : l'ordre de doublons issu de la répartition
+    // parallèle varie d'une exécution à l'autre.
+    size_t k = 1;
+    while (k < n && C->col[begin + k - 1] < C->col[begin + k]) {
+      k ++;
+    }
+    if (k < n) {
+      entry_t* row = (entry_t*) malloc(sizeof(entry_t) * n);
+      for (k = 0; k != n; k ++) {
+        row[k].col = C->col[begin + k];
+        row[k].val = C->val[begin + k];
+      }
+      qsort(row, n, sizeof(entry_t), compare);
+      for (k = 0; k != n; k ++) {
+        C->col[begin + k] = row[k].col;
+        C->val[begin + k] = row[k].val;
+      }
+      free(row);
+    }
+    size_t w = 0;
+    for (k = 0; k != n; k ++) {
+      if (w != 0 && C->col[begin + k] == C->col[begin + w - 1]) {
+        C->val[begin + w - 1] += C->val[begin + k];
+      } else {
+        C->col[begin + w] = C->col[begin + k];
+        C->val[begin + w] = C->val[begin + k];
+        w ++;
+      }
+    }
+    next[i + 1] = w;
+  }
+  for (unsigned i = 0; i != T->rows; i ++) {
+    next[i + 1] += next[i];
+  }
+
+  // Compactage, si des doublons ont été fusionnés.
+  if (next[T->rows] != C->nnz) {
+    csr_t* D = csr_create(T->rows, T->cols, next[T->rows]);
+    memcpy(D->ptr, next, sizeof(size_t) * ((size_t) T->rows + 1));
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < (int) C->rows; i ++) {
+      const size_t n = D->ptr[i + 1] - D->ptr[i];
+      memcpy(D->col + D->ptr[i], C->col + C->ptr[i], sizeof(unsigned) * n);
+      memcpy(D->val + D->ptr[i], C->val + C->ptr[i], sizeof(float) * n);
+    }
+    csr_free(C);
+    C = D;
+  }
+  free(next);
+
+  return C;
+
+}
+
+/*
+ * Construction de la matrice dense. Un fichier « array » ne stockant chaque
+ * élément qu'une fois, ses éléments sont écrits directement ; ceux d'un
+ * fichier « coordinate » pouvant comporter des doublons, ils transitent par
+ * la matrice CSR, dont les lignes sont écrites par des threads distincts.
+ */
+static float*
+to_dense(const triplets_t* T) {
+
+  const size_t bytes = (sizeof(float) * T->rows * T->cols + 15) & ~(size_t) 15;
+  float* A = (float*) aligned_alloc(16, bytes ? bytes : 16);
+  memset(A, 0, bytes);
+
+  if (T->format == COORDINATE) {
+    csr_t* C = to_csr(T);
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < (int) C->rows; i ++) {
+      float* a = A + (size_t) i * T->cols;
+      for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+        a[C->col[k]] = C->val[k];
+      }
+    }
+    csr_free(C);
+    return A;
+  }
+
+  const long count = (long) T->count;
+  const int mirror = T->symmetry != GENERAL;
+  const float sign = T->symmetry == SKEW ? -1.0f : 1.0f;
+#pragma omp parallel for schedule(static)
+  for (long e = 0; e < count; e ++) {
+    const size_t i = T->I[e], j = T->J[e];
+    A[i * T->cols + j] = T->V[e];
+    if (mirror && i != j) {
+      A[j * T->cols + i] = sign * T->V[e];
+    }
+  }
+
+  return A;
+
+}
+
+/*
+ * Reconnaissance et validation d'un fichier cache.
+ */
+static int
+cache(const mapping_t* m, cache_t* h) {
+
+  if (m->len < sizeof(cache_t) || memcmp(m->data, MAGIC, 8) != 0) {
+    return 0;
+  }
+  memcpy(h, m->data, sizeof(cache_t));
+  const size_t expected = h->kind == CACHE_DENSE
+    ? sizeof(float) * h->rows * h->cols
+    : sizeof(size_t) * ((size_t) h->rows + 1)
+      + (sizeof(unsigned) + sizeof(float)) * h->nnz;
+  return h->word == sizeof(size_t) && (h->kind == CACHE_DENSE
+                                       || h->kind == CACHE_CSR)
+    && m->len == sizeof(cache_t) + expected ? 1 : -1;
+
+}
+
+/*
+ * Vue CSR (sans copie) sur le contenu d'un fichier cache.
+ */
+static csr_t
+view(const mapping_t* m, const cache_t* h) {
+
+  csr_t C;
+  C.rows = h->rows;
+  C.cols = h->cols;
+  C.nnz = h->nnz;
+  C.ptr = (size_t*) (m->data + sizeof(cache_t));
+  C.col = (unsigned*) (C.ptr + C.rows + 1);
+  C.val = (float*) (C.col + C.nnz);
+  return C;
+
+}
+
+/*
+ * Écriture d'un fichier cache.
+ */
+static int
+save(const char* path,
+     const cache_t* h,
+     const void* const parts[],
+     const size_t sizes[],
+     const unsigned count) {
+
+  FILE* file = fopen(path, "wb");
+  if (file == NULL) {
+    return -1;
+  }
+  int ok = fwrite(h, sizeof(cache_t), 1, file) == 1;
+  for (unsigned k = 0; k != count && ok; k ++) {
+    ok = sizes[k] == 0 || fwrite(parts[k], 1, sizes[k], file) == sizes[k];
+  }
+  ok = fclose(file) == 0 && ok;
+  return ok ? 0 : -1;
+
+}
+
+/****************
+ * mtx_load_csr *
+ ****************/
+
+csr_t*
+mtx_load_csr(const char* path) {
+
+  mapping_t m;
+  if (map(path, &m) != 0) {
+    return NULL;
+  }
+
+  csr_t* C = NULL;
+  cache_t h;
+  triplets_t T;
+  const int cached = cache(&m, &h);
+  if (cached > 0 && h.kind == CACHE_DENSE) {
+    C = csr_from_dense((const float*) (m.data + sizeof(cache_t)),
+                       h.rows, h.cols);
+  } else if (cached > 0) {
+    const csr_t V = view(&m, &h);
+    C = csr_create(V.rows, V.cols, V.nnz);
+    memcpy(C->ptr, V.ptr, sizeof(size_t) * ((size_t) V.rows + 1));
+    memcpy(C->col, V.col, sizeof(unsigned) * V.nnz);
+    memcpy(C->val, V.val, sizeof(float) * V.nnz);
+  } else if (cached == 0 && parse(&m, &T) == 0) {
+    C = to_csr(&T);
+    free(T.I);
+    free(T.J);
+    free(T.V);
+  }
+
+  unmap(&m);
+  return C;
+
+}
+
+/******************
+ * mtx_load_dense *
+ ******************/
+
+float*
+mtx_load_dense(const char* path, unsigned* rows, unsigned* cols) {
+
+  mapping_t m;
+  if (map(path, &m) != 0) {
+    return NULL;
+  }
+
+  float* A = NULL;
+  cache_t h;
+  triplets_t T;
+  const int cached = cache(&m, &h);
+  if (cached > 0) {
+    const size_t bytes = (sizeof(float) * h.rows * h.cols + 15) & ~(size_t) 15;
+    A = (float*) aligned_alloc(16, bytes ? bytes : 16);
+    if (h.kind == CACHE_DENSE) {
+      memcpy(A, m.data + sizeof(cache_t), sizeof(float) * h.rows * h.cols);
+    } else {
+      const csr_t V = view(&m, &h);
+      csr_to_dense(&V, A);
+    }
+    *rows = h.rows;
+    *cols = h.cols;
+  } else if (cached == 0 && parse(&m, &T) == 0) {
+    A = to_dense(&T);
+    *rows = T.rows;
+    *cols = T.cols;
+    free(T.I);
+    free(T.J);
+    free(T.V);
+  }
+
+  unmap(&m);
+  return A;
+
+}
+
+/****************
+ * mtx_save_csr *
+ ****************/
+
+int
+mtx_save_csr(const csr_t* C, const char* path) {
+
+  cache_t h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, MAGIC, 8);
+  h.kind = CACHE_CSR;
+  h.rows = C->rows;
+  h.cols = C->cols;
+  h.word = sizeof(size_t);
+  h.nnz = C->nnz;
+
+  const void* const parts[] = { C->ptr, C->col, C->val };
+  const size_t sizes[] = {
+    sizeof(size_t) * ((size_t) C->rows + 1),
+    sizeof(unsigned) * C->nnz,
+    sizeof(float) * C->nnz
+  };
+  return save(path, &h, parts, sizes, 3);
+
+}
+
+/******************
+ * mtx_save_dense *
+ ******************/
+
+int
+mtx_save_dense(const float A[],
+               const unsigned rows,
+               const unsigned cols,
+               const char* path) {
+
+  cache_t h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, MAGIC, 8);
+  h.kind = CACHE_DENSE;
+  h.rows = rows;
+  h.cols = cols;
+  h.word = sizeof(size_t);
+
+  const void* const parts[] = { A };
+  const size_t sizes[] = { sizeof(float) * rows * cols };
+  return save(path, &h, parts, sizes, 1);
+
+}
@@ -0,0 +1,291 @@
+#include "powers.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+#include <omp.h>
+
+#define TILE 4096 // Nombre de lignes par tuile par défaut.
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Produit scalaire d'une ligne de A par x, dans l'ordre de matvec_sse_r4.
+ */
+static inline float
+dot(const float a[restrict], const float x[restrict], const unsigned n) {
+
+  xmm_t acc;
+  acc.m128_vec = _mm_setzero_ps();
+  unsigned k = 0;
+  for (; k + 4 <= n; k += 4) {
+    acc.m128_vec = _mm_add_ps(acc.m128_vec,
+                              _mm_mul_ps(_mm_loadu_ps(a + k),
+                                         _mm_loadu_ps(x + k)));
+  }
+  float s = acc.m128_f32[0] + acc.m128_f32[1]
+    + acc.m128_f32[2] + acc.m128_f32[3];
+  for (; k != n; k ++) {
+    s += a[k] * x[k];
+  }
+  return s;
+
+}
+
+/*****************
+ * powers_create *
+ *****************/
+
+powers_t*
+powers_create(const csr_t* C, const unsigned k, const unsigned tile) {
+
+  if (C->rows != C->cols || k == 0) {
+    return NULL;
+  }
+
+  const unsigned n = C->rows;
+  const unsigned height = tile ? tile : TILE;
+
+  powers_t* P = (powers_t*) malloc(sizeof(powers_t));
+  P->k = k;
+  P->tiles = (n + height - 1) / height;
+  P->scratch = 0;
+  P->offset = (size_t*) malloc(sizeof(size_t) * ((size_t) P->tiles + 1));
+  P->count = (unsigned*) malloc(sizeof(unsigned)
+                               * ((size_t) P->tiles * (k + 1) + 1));
+  P->lbase = (size_t*) malloc(sizeof(size_t) * ((size_t) P->tiles + 1));
+  P->offset[0] = 0;
+  P->lbase[0] = 0;
+
+  // Les tableaux rows, lptr et lcol croissent au fil des tuiles.
+  size_t rcap = n + 1, pcap = n + 1, ccap = C->nnz + 1;
+  P->rows = (unsigned*) malloc(sizeof(unsigned) * rcap);
+  P->lptr = (size_t*) malloc(sizeof(size_t) * pcap);
+  P->lcol = (unsigned*) malloc(sizeof(unsigned) * ccap);
+  P->lval = (float*) malloc(sizeof(float) * ccap);
+  size_t nrows = 0, nptr = 0, ncol = 0;
+
+  // Numéro local de chaque ligne dans la tuile courante (UINT_MAX : absente).
+  unsigned* local = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  memset(local, 0xff, sizeof(unsigned) * n);
+
+  double computed = 0.0;
+  for (unsigned t = 0; t != P->tiles; t ++) {
+
+    const unsigned r0 = t * height;
+    const unsigned r1 = r0 + height < n ? r0 + height : n;
+
+    // S_k, puis S_{k-1}, ..., S_0 par ajout des colonnes du niveau
+    // précédent. Les lignes sont ajoutées en fin de rows, dont la capacité
+    // est au besoin doublée.
+    unsigned len = 0;
+    for (unsigned i = r0; i != r1; i ++) {
+      if (nrows + len == rcap) {
+        rcap *= 2;
+        P->rows = (unsigned*) realloc(P->rows, sizeof(unsigned) * rcap);
+      }
+      local[i] = len;
+      P->rows[nrows + len ++] = i;
+    }
+    unsigned* count = P->count + (size_t) t * (k + 1);
+    count[k] = len;
+    for (unsigned j = k; j != 0; j --) {
+      const unsigned prev = count[j];
+      for (unsigned l = 0; l != prev; l ++) {
+        const unsigned i = P->rows[nrows + l];
+        for (size_t q = C->ptr[i]; q != C->ptr[i + 1]; q ++) {
+          const unsigned c = C->col[q];
+          if (local[c] == UINT_MAX) {
+            if (nrows + len == rcap) {
+              rcap *= 2;
+              P->rows = (unsigned*) realloc(P->rows, sizeof(unsigned) * rcap);
+            }
+            local[c] = len;
+            P->rows[nrows + len ++] = c;
+          }
+        }
+      }
+      count[j - 1] = len;
+    }
+    for (unsigned j = 1; j <= k; j ++) {
+      computed += count[j];
+    }
+
+    // Colonnes locales des lignes de S_1.
+    const unsigned inner = count[1];
+    if (nptr + inner + 1 > pcap) {
+      pcap = 2 * (nptr + inner + 1);
+      P->lptr = (size_t*) realloc(P->lptr, sizeof(size_t) * pcap);
+    }
+    for (unsigned l = 0; l != inner; l ++) {
+      const unsigned i = P->rows[nrows + l];
+      const size_t length = C->ptr[i + 1] - C->ptr[i];
+      if (ncol + length > ccap) {
+        ccap = 2 * (ncol + length);
+        P->lcol = (unsigned*) realloc(P->lcol, sizeof(unsigned) * ccap);
+        P->lval = (float*) realloc(P->lval, sizeof(float) * ccap);
+      }
+      P->lptr[nptr ++] = ncol;
+      for (size_t q = C->ptr[i]; q != C->ptr[i + 1]; q ++) {
+        P->lcol[ncol] = local[C->col[q]];
+        P->lval[ncol ++] = C->val[q];
+      }
+    }
+    P->lptr[nptr ++] = ncol;
+
+    for (unsigned l = 0; l != len; l ++) {
+      local[P->rows[nrows + l]] = UINT_MAX;
+    }
+    nrows += len;
+    P->offset[t + 1] = nrows;
+    P->lbase[t + 1] = nptr;
+    if (len > P->scratch) {
+      P->scratch = len;
+    }
+
+  }
+
+  free(local);
+  P->redundancy = n ? computed / ((double) k * n) : 1.0;
+
+  // Tampons des threads, chacun sur ses propres lignes de cache.
+  P->threads = (unsigned) omp_get_max_threads();
+  P->stride = (P->scratch + 15) / 16 * 16 + 16;
+  P->buffer = (float*) aligned_alloc(64, sizeof(float) * 2 * P->stride
+                                     * P->threads);
+  return P;
+
+}
+
+/***************
+ * powers_free *
+ ***************/
+
+void
+powers_free(powers_t* P) {
+
+  if (P == NULL) {
+    return;
+  }
+  free(P->offset);
+  free(P->rows);
+  free(P->count);
+  free(P->lbase);
+  free(P->lptr);
+  free(P->lcol);
+  free(P->lval);
+  free(P->buffer);
+  free(P);
+
+}
+
+/**************
+ * powers_csr *
+ **************/
+
+void
+powers_csr(const powers_t* P,
+           const csr_t* C,
+           const float x[restrict],
+                 float V[restrict]) {
+
+  const unsigned k = P->k;
+  const size_t n = C->rows;
+  const int max = omp_get_max_threads();
+
+#pragma omp parallel num_threads(max < (int) P->threads ? max : (int) P->threads)
+  {
+
+    // Tampons propres à chaque thread : niveau précédent et niveau courant.
+    float* prev = P->buffer + (size_t) 2 * P->stride * omp_get_thread_num();
+    float* cur = prev + P->stride;
+
+#pragma omp for schedule(dynamic, 1)
+    for (int t = 0; t < (int) P->tiles; t ++) {
+
+      const unsigned* rows = P->rows + P->offset[t];
+      const unsigned* count = P->count + (size_t) t * (k + 1);
+      const unsigned own = count[k];
+      const size_t* restrict lptr = P->lptr + P->lbase[t];
+      const unsigned* restrict lcol = P->lcol;
+      const float* restrict lval = P->lval;
+
+      // Niveau 0 : composantes de x utilisées par la tuile.
+      for (unsigned l = 0; l != count[0]; l ++) {
+        prev[l] = x[rows[l]];
+      }
+
+      // Niveaux 1 à k, à partir du tampon local. Les lignes de la tuile
+      // forment le début de S_j, dans l'ordre : elles sont recopiées d'un
+      // bloc dans V.
+      for (unsigned j = 1; j <= k; j ++) {
+        for (unsigned l = 0; l != count[j]; l ++) {
+          float sum = 0.0f;
+          for (size_t q = lptr[l]; q != lptr[l + 1]; q ++) {
+            sum += lval[q] * prev[lcol[q]];
+          }
+          cur[l] = sum;
+        }
+        memcpy(V + (j - 1) * n + rows[0], cur, sizeof(float) * own);
+        float* swap = prev;
+        prev = cur;
+        cur = swap;
+      }
+
+    }
+
+  }
+
+}
+
+/****************
+ * powers_dense *
+ ****************/
+
+void
+powers_dense(const float A[restrict],
+             const float x[restrict],
+                   float V[restrict],
+             const unsigned size,
+             const unsigned k) {
+
+#pragma omp parallel
+  {
+
+    // Chaque thread reçoit la même tranche de lignes à chaque niveau,
+    // parcourue alternativement dans un sens et dans l'autre.
+    const unsigned t = omp_get_thread_num();
+    const unsigned threads = omp_get_num_threads();
+    const unsigned chunk = (size + threads - 1) / threads;
+    const unsigned i0 = t * chunk < size ? t * chunk : size;
+    const unsigned i1 = i0 + chunk < size ? i0 + chunk : size;
+
+    const float* in = x;
+    for (unsigned j = 0; j != k; j ++) {
+      float* out = V + (size_t) j * size;
+      if (j % 2 == 0) {
+        for (unsigned i = i0; i != i1; i ++) {
+          out[i] = dot(A + (size_t) i * size, in, size);
+        }
+      } else {
+        for (unsigned i = i1; i != i0; i --) {
+          out[i - 1] = dot(A + (size_t) (i - 1) * size, in, size);
+        }
+      }
+      in = out;
+
+      // Le niveau suivant lit la totalité de celui-ci.
+#pragma omp barrier
+    }
+
+  }
+
+}
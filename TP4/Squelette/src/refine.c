@@ -0,0 +1,387 @@
+#include "refine.h"
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+
+/*
+ * Mise à jour a = a - l.u en simple précision.
+ */
+static inline void
+axpy_f(float a[restrict], const float u[restrict], const float l,
+       const unsigned len) {
+
+  const __m128 ll = _mm_set1_ps(l);
+  unsigned k = 0;
+  for (; k + 4 <= len; k += 4) {
+    _mm_storeu_ps(a + k, _mm_sub_ps(_mm_loadu_ps(a + k),
+                                    _mm_mul_ps(ll, _mm_loadu_ps(u + k))));
+  }
+  for (; k != len; k ++) {
+    a[k] -= l * u[k];
+  }
+
+}
+
+/*
+ * Mise à jour a = a - l.u en double précision.
+ */
+static inline void
+axpy_d(double a[restrict], const double u[restrict], const double l,
+       const unsigned len) {
+
+  const __m128d ll = _mm_set1_pd(l);
+  unsigned k = 0;
+  for (; k + 2 <= len; k += 2) {
+    _mm_storeu_pd(a + k, _mm_sub_pd(_mm_loadu_pd(a + k),
+                                    _mm_mul_pd(ll, _mm_loadu_pd(u + k))));
+  }
+  for (; k != len; k ++) {
+    a[k] -= l * u[k];
+  }
+
+}
+
+/*
+ * Résidu r = b - Ax et normes infinies de r, x et b, en double précision.
+ */
+static void
+residual(const double A[],
+         const double b[],
+         const double x[],
+               double r[],
+         const unsigned n,
+               double norm[3]) {
+
+  double rn = 0.0, xn = 0.0, bn = 0.0;
+
+#pragma omp parallel for schedule(static) reduction(max:rn, xn, bn)
+  for (int i = 0; i < (int) n; i ++) {
+    const double* a = A + (size_t) i * n;
+    __m128d acc = _mm_setzero_pd();
+    unsigned k = 0;
+    for (; k + 2 <= n; k += 2) {
+      acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(a + k),
+                                       _mm_loadu_pd(x + k)));
+    }
+    double sum = _mm_cvtsd_f64(acc) + _mm_cvtsd_f64(_mm_unpackhi_pd(acc, acc));
+    for (; k != n; k ++) {
+      sum += a[k] * x[k];
+    }
+    r[i] = b[i] - sum;
+    rn = fmax(rn, fabs(r[i]));
+    xn = fmax(xn, fabs(x[i]));
+    bn = fmax(bn, fabs(b[i]));
+  }
+
+  norm[0] = rn;
+  norm[1] = xn;
+  norm[2] = bn;
+
+}
+
+/*
+ * Norme infinie d'une matrice.
+ */
+static double
+norm_inf(const double A[], const unsigned n) {
+
+  double norm = 0.0;
+#pragma omp parallel for schedule(static) reduction(max:norm)
+  for (int i = 0; i < (int) n; i ++) {
+    double sum = 0.0;
+    for (unsigned k = 0; k != n; k ++) {
+      sum += fabs(A[(size_t) i * n + k]);
+    }
+    norm = fmax(norm, sum);
+  }
+  return norm;
+
+}
+
+/***************
+ * refine_lu_f *
+ ***************/
+
+int
+refine_lu_f(float A[], unsigned piv[], const unsigned n) {
+
+  for (unsigned k = 0; k != n; k ++) {
+
+    // Recherche du pivot.
+    unsigned p = k;
+    for (unsigned i = k + 1; i != n; i ++) {
+      if (fabsf(A[(size_t) i * n + k]) > fabsf(A[(size_t) p * n + k])) {
+        p = i;
+      }
+    }
+    piv[k] = p;
+    if (A[(size_t) p * n + k] == 0.0f) {
+      return -1;
+    }
+    if (p != k) {
+      float* a = A + (size_t) k * n;
+      float* c = A + (size_t) p * n;
+      for (unsigned j = 0; j != n; j ++) {
+        const float t = a[j];
+        a[j] = c[j];
+        c[j] = t;
+      }
+    }
+
+    // Élimination.
+    const float* u = A + (size_t) k * n;
+    const float inv = 1.0f / u[k];
+#pragma omp parallel for schedule(static)
+    for (int i = k + 1; i < (int) n; i ++) {
+      float* a = A + (size_t) i * n;
+      a[k] *= inv;
+      axpy_f(a + k + 1, u + k + 1, a[k], n - k - 1);
+    }
+
+  }
+
+  return 0;
+
+}
+
+/******************
+ * refine_solve_f *
+ ******************/
+
+void
+refine_solve_f(const float LU[],
+               const unsigned piv[],
+                     float x[],
+               const unsigned n) {
+
+  for (unsigned k = 0; k != n; k ++) {
+    const float t = x[k];
+    x[k] = x[piv[k]];
+    x[piv[k]] = t;
+  }
+  for (unsigned i = 0; i != n; i ++) {
+    const float* l = LU + (size_t) i * n;
+    float sum = x[i];
+    for (unsigned k = 0; k != i; k ++) {
+      sum -= l[k] * x[k];
+    }
+    x[i] = sum;
+  }
+  for (unsigned i = n; i -- != 0; ) {
+    const float* u = LU + (size_t) i * n;
+    float sum = x[i];
+    for (unsigned k = i + 1; k != n; k ++) {
+      sum -= u[k] * x[k];
+    }
+    x[i] = sum / u[i];
+  }
+
+}
+
+/***************
+ * refine_lu_d *
+ ***************/
+
+int
+refine_lu_d(double A[], unsigned piv[], const unsigned n) {
+
+  for (unsigned k = 0; k != n; k ++) {
+
+    // Recherche du pivot.
+    unsigned p = k;
+    for (unsigned i = k + 1; i != n; i ++) {
+      if (fabs(A[(size_t) i * n + k]) > fabs(A[(size_t) p * n + k])) {
+        p = i;
+      }
+    }
+    piv[k] = p;
+    if (A[(size_t) p * n + k] == 0.0) {
+      return -1;
+    }
+    if (p != k) {
+      double* a = A + (size_t) k * n;
+      double* c = A + (size_t) p * n;
+      for (unsigned j = 0; j != n; j ++) {
+        const double t = a[j];
+        a[j] = c[j];
+        c[j] = t;
+      }
+    }
+
+    // Élimination.
+    const double* u = A + (size_t) k * n;
+    const double inv = 1.0 / u[k];
+#pragma omp parallel for schedule(static)
+    for (int i = k + 1; i < (int) n; i ++) {
+      double* a = A + (size_t) i * n;
+      a[k] *= inv;
+      axpy_d(a + k + 1, u + k + 1, a[k], n - k - 1);
+    }
+
+  }
+
+  return 0;
+
+}
+
+/******************
+ * refine_solve_d *
+ ******************/
+
+void
+refine_solve_d(const double LU[],
+               const unsigned piv[],
+                     double x[],
+               const unsigned n) {
+
+  for (unsigned k = 0; k != n; k ++) {
+    const double t = x[k];
+    x[k] = x[piv[k]];
+    x[piv[k]] = t;
+  }
+  for (unsigned i = 0; i != n; i ++) {
+    const double* l = LU + (size_t) i * n;
+    double sum = x[i];
+    for (unsigned k = 0; k != i; k ++) {
+      sum -= l[k] * x[k];
+    }
+    x[i] = sum;
+  }
+  for (unsigned i = n; i -- != 0; ) {
+    const double* u = LU + (size_t) i * n;
+    double sum = x[i];
+    for (unsigned k = i + 1; k != n; k ++) {
+      sum -= u[k] * x[k];
+    }
+    x[i] = sum / u[i];
+  }
+
+}
+
+/****************
+ * refine_solve *
+ ****************/
+
+int
+refine_solve(const double A[],
+             const double b[],
+                   double x[],
+             const unsigned n,
+             const unsigned iters,
+             refine_stats_t* stats) {
+
+  float* F = (float*) malloc(sizeof(float) * n * n);
+  unsigned* piv = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  double* r = (double*) malloc(sizeof(double) * (n ? n : 1));
+  float* d = (float*) malloc(sizeof(float) * (n ? n : 1));
+
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < (int) n; i ++) {
+    for (unsigned k = 0; k != n; k ++) {
+      F[(size_t) i * n + k] = (float) A[(size_t) i * n + k];
+    }
+  }
+
+  const double anorm = norm_inf(A, n);
+  const double tolerance = anorm * sqrt((double) n) * DBL_EPSILON;
+  double norm[3] = { 0.0, 0.0, 0.0 };
+  unsigned it = 0;
+  int converged = 0;
+
+  if (refine_lu_f(F, piv, n) == 0) {
+
+    // Solution initiale en simple précision.
+    for (unsigned i = 0; i != n; i ++) {
+      d[i] = (float) b[i];
+    }
+    refine_solve_f(F, piv, d, n);
+    for (unsigned i = 0; i != n; i ++) {
+      x[i] = d[i];
+    }
+
+    for (;;) {
+      residual(A, b, x, r, n, norm);
+      converged = norm[0] <= tolerance * norm[1];
+      if (converged || it == iters || !isfinite(norm[0])) {
+        break;
+      }
+      // Correction : le résidu double précision est arrondi en simple
+      // précision, seule la correction (petite) étant ainsi approchée.
+      for (unsigned i = 0; i != n; i ++) {
+        d[i] = (float) r[i];
+      }
+      refine_solve_f(F, piv, d, n);
+      for (unsigned i = 0; i != n; i ++) {
+        x[i] += d[i];
+      }
+      it ++;
+    }
+
+  }
+
+  free(F);
+  free(piv);
+  free(r);
+  free(d);
+
+  if (!converged) {
+    const int status = refine_direct(A, b, x, n, stats);
+    if (stats != NULL) {
+      stats->iterations = it;
+      stats->fallback = 1;
+    }
+    return status;
+  }
+
+  if (stats != NULL) {
+    stats->iterations = it;
+    stats->error = norm[0] / (anorm * norm[1] + norm[2]);
+    stats->fallback = 0;
+  }
+  return 0;
+
+}
+
+/*****************
+ * refine_direct *
+ *****************/
+
+int
+refine_direct(const double A[],
+              const double b[],
+                    double x[],
+              const unsigned n,
+              refine_stats_t* stats) {
+
+  double* LU = (double*) malloc(sizeof(double) * n * n);
+  unsigned* piv = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  memcpy(LU, A, sizeof(double) * n * n);
+
+  const int status = refine_lu_d(LU, piv, n);
+  if (status == 0) {
+    memcpy(x, b, sizeof(double) * n);
+    refine_solve_d(LU, piv, x, n);
+  }
+  free(LU);
+  free(piv);
+
+  if (stats != NULL) {
+    stats->iterations = 0;
+    stats->fallback = 0;
+    stats->error = NAN;
+    if (status == 0) {
+      double* r = (double*) malloc(sizeof(double) * (n ? n : 1));
+      double norm[3];
+      residual(A, b, x, r, n, norm);
+      stats->error = norm[0] / (norm_inf(A, n) * norm[1] + norm[2]);
+      free(r);
+    }
+  }
+
+  return status;
+
+}
@@ -0,0 +1,426 @@
+#include "reorder.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Graphe non orienté de la structure de A + A^T (sans boucles). La liste
+ * des voisins de chaque sommet est triée par degrés croissants.
+ */
+typedef struct {
+  unsigned n;       // Le nombre de sommets.
+  size_t* ptr;      // Début de la liste de chaque sommet (n + 1 entrées).
+  unsigned* adj;    // Les listes de voisins.
+  unsigned* order;  // Les sommets par degrés croissants.
+} graph_t;
+
+/*
+ * Tri stable des indices 0 à n - 1 par clés croissantes (ou décroissantes),
+ * par dénombrement.
+ */
+static unsigned*
+sort_by(const unsigned key[], const unsigned n, const int descending) {
+
+  unsigned max = 0;
+  for (unsigned i = 0; i != n; i ++) {
+    max = key[i] > max ? key[i] : max;
+  }
+
+  size_t* count = (size_t*) calloc((size_t) max + 2, sizeof(size_t));
+  for (unsigned i = 0; i != n; i ++) {
+    count[(descending ? max - key[i] : key[i]) + 1] ++;
+  }
+  for (unsigned k = 0; k <= max; k ++) {
+    count[k + 1] += count[k];
+  }
+
+  unsigned* order = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  for (unsigned i = 0; i != n; i ++) {
+    order[count[descending ? max - key[i] : key[i]] ++] = i;
+  }
+  free(count);
+
+  return order;
+
+}
+
+/*
+ * Construction du graphe : union (sans doublons) des structures des lignes
+ * de A et de A^T, puis répartition de chaque sommet, pris par degrés
+ * croissants, dans les listes de ses voisins, qui sont ainsi triées.
+ */
+static graph_t
+graph(const csr_t* C) {
+
+  const unsigned n = C->rows;
+
+  // Structure de A^T.
+  size_t* tptr = (size_t*) calloc((size_t) n + 1, sizeof(size_t));
+  for (size_t k = 0; k != C->nnz; k ++) {
+    tptr[C->col[k] + 1] ++;
+  }
+  for (unsigned i = 0; i != n; i ++) {
+    tptr[i + 1] += tptr[i];
+  }
+  unsigned* tadj = (unsigned*) malloc(sizeof(unsigned) * (C->nnz ? C->nnz : 1));
+  size_t* cursor = (size_t*) malloc(sizeof(size_t) * ((size_t) n + 1));
+  memcpy(cursor, tptr, sizeof(size_t) * n);
+  for (unsigned i = 0; i != n; i ++) {
+    for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+      tadj[cursor[C->col[k]] ++] = i;
+    }
+  }
+
+  // Union des deux structures, chaque liste disposant de la place maximale.
+  unsigned* degree = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  unsigned* mark = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  unsigned* uadj = (unsigned*) malloc(sizeof(unsigned) * (2 * C->nnz + 1));
+  memset(mark, 0xff, sizeof(unsigned) * n);
+  size_t start = 0;
+  for (unsigned i = 0; i != n; i ++) {
+    size_t m = start;
+    for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+      const unsigned j = C->col[k];
+      if (j != i && mark[j] != i) {
+        mark[j] = i;
+        uadj[m ++] = j;
+      }
+    }
+    for (size_t k = tptr[i]; k != tptr[i + 1]; k ++) {
+      const unsigned j = tadj[k];
+      if (j != i && mark[j] != i) {
+        mark[j] = i;
+        uadj[m ++] = j;
+      }
+    }
+    degree[i] = (unsigned) (m - start);
+    cursor[i] = start;
+    start += (C->ptr[i + 1] - C->ptr[i]) + (tptr[i + 1] - tptr[i]);
+  }
+  free(tptr);
+  free(tadj);
+  free(mark);
+
+  // Listes définitives.
+  graph_t G;
+  G.n = n;
+  G.order = sort_by(degree, n, 0);
+  G.ptr = (size_t*) malloc(sizeof(size_t) * ((size_t) n + 1));
+  G.ptr[0] = 0;
+  for (unsigned i = 0; i != n; i ++) {
+    G.ptr[i + 1] = G.ptr[i] + degree[i];
+  }
+  G.adj = (unsigned*) malloc(sizeof(unsigned) * (G.ptr[n] ? G.ptr[n] : 1));
+  size_t* fill = (size_t*) malloc(sizeof(size_t) * ((size_t) n + 1));
+  memcpy(fill, G.ptr, sizeof(size_t) * n);
+  for (unsigned t = 0; t != n; t ++) {
+    const unsigned u = G.order[t];
+    for (size_t k = cursor[u]; k != cursor[u] + degree[u]; k ++) {
+      G.adj[fill[uadj[k]] ++] = u;
+    }
+  }
+  free(fill);
+  free(cursor);
+  free(uadj);
+  free(degree);
+
+  return G;
+
+}
+
+/*
+ * Parcours en largeur depuis root des sommets non encore numérotés, afin de
+ * déterminer la structure en niveaux de la composante : depth reçoit le
+ * numéro du dernier niveau et last son sommet de plus faible degré. Les
+ * niveaux sont remis à UINT_MAX à l'issue du parcours.
+ */
+static void
+levels(const graph_t* G,
+       const unsigned root,
+       const unsigned char numbered[],
+       unsigned level[],
+       unsigned queue[],
+       unsigned* depth,
+       unsigned* last) {
+
+  unsigned head = 0, tail = 0;
+  queue[tail ++] = root;
+  level[root] = 0;
+  while (head != tail) {
+    const unsigned u = queue[head ++];
+    for (size_t k = G->ptr[u]; k != G->ptr[u + 1]; k ++) {
+      const unsigned v = G->adj[k];
+      if (!numbered[v] && level[v] == UINT_MAX) {
+        level[v] = level[u] + 1;
+        queue[tail ++] = v;
+      }
+    }
+  }
+
+  *depth = level[queue[tail - 1]];
+  *last = queue[tail - 1];
+  for (unsigned t = tail; t -- != 0 && level[queue[t]] == *depth; ) {
+    const unsigned u = queue[t];
+    if (G->ptr[u + 1] - G->ptr[u] <= G->ptr[*last + 1] - G->ptr[*last]) {
+      *last = u;
+    }
+  }
+
+  for (unsigned t = 0; t != tail; t ++) {
+    level[queue[t]] = UINT_MAX;
+  }
+
+}
+
+/*
+ * Numérotation de Cuthill-McKee inverse.
+ */
+static unsigned*
+rcm(const csr_t* C) {
+
+  graph_t G = graph(C);
+  const unsigned n = G.n;
+
+  unsigned char* numbered = (unsigned char*) calloc(n ? n : 1, 1);
+  unsigned* level = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  unsigned* queue = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  unsigned* order = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  memset(level, 0xff, sizeof(unsigned) * n);
+
+  unsigned count = 0;
+  for (unsigned t = 0; t != n; t ++) {
+
+    // Nouvelle composante, explorée depuis son sommet non numéroté de plus
+    // faible degré.
+    unsigned root = G.order[t];
+    if (numbered[root]) {
+      continue;
+    }
+
+    // Recherche d'un sommet pseudo-périphérique : tant que le parcours
+    // depuis un sommet du dernier niveau est plus profond, il le remplace.
+    unsigned depth, last;
+    levels(&G, root, numbered, level, queue, &depth, &last);
+    for (;;) {
+      unsigned further, next;
+      levels(&G, last, numbered, level, queue, &further, &next);
+      if (further <= depth) {
+        break;
+      }
+      root = last;
+      depth = further;
+      last = next;
+    }
+
+    // Parcours de Cuthill-McKee, les voisins étant déjà triés par degrés.
+    unsigned head = count;
+    order[count ++] = root;
+    numbered[root] = 1;
+    while (head != count) {
+      const unsigned u = order[head ++];
+      for (size_t k = G.ptr[u]; k != G.ptr[u + 1]; k ++) {
+        const unsigned v = G.adj[k];
+        if (!numbered[v]) {
+          numbered[v] = 1;
+          order[count ++] = v;
+        }
+      }
+    }
+
+  }
+
+  // Inversion.
+  for (unsigned k = 0; k < n / 2; k ++) {
+    const unsigned u = order[k];
+    order[k] = order[n - 1 - k];
+    order[n - 1 - k] = u;
+  }
+
+  free(numbered);
+  free(level);
+  free(queue);
+  free(G.ptr);
+  free(G.adj);
+  free(G.order);
+
+  return order;
+
+}
+
+/*
+ * Élément d'une ligne, pour le tri par colonnes.
+ */
+typedef struct {
+  unsigned col;
+  float val;
+} entry_t;
+
+static int
+compare(const void* a, const void* b) {
+  const unsigned x = ((const entry_t*) a)->col;
+  const unsigned y = ((const entry_t*) b)->col;
+  return (x > y) - (x < y);
+}
+
+/*******************
+ * reorder_compute *
+ *******************/
+
+unsigned*
+reorder_compute(const csr_t* C, const reorder_method_t method) {
+
+  if (C->rows != C->cols) {
+    return NULL;
+  }
+
+  if (method == REORDER_RCM) {
+    return rcm(C);
+  }
+
+  if (method == REORDER_DEGREE) {
+    graph_t G = graph(C);
+    free(G.ptr);
+    free(G.adj);
+    return G.order;
+  }
+
+  unsigned* length = (unsigned*) malloc(sizeof(unsigned) * (C->rows ? C->rows : 1));
+  for (unsigned i = 0; i != C->rows; i ++) {
+    length[i] = (unsigned) (C->ptr[i + 1] - C->ptr[i]);
+  }
+  unsigned* perm = sort_by(length, C->rows, 1);
+  free(length);
+
+  return perm;
+
+}
+
+/*****************
+ * reorder_apply *
+ *****************/
+
+csr_t*
+reorder_apply(const csr_t* C, const unsigned perm[]) {
+
+  const unsigned n = C->rows;
+  csr_t* D = csr_create(n, C->cols, C->nnz);
+
+  unsigned* inverse = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  for (unsigned k = 0; k != n; k ++) {
+    inverse[perm[k]] = k;
+    D->ptr[k + 1] = D->ptr[k] + (C->ptr[perm[k] + 1] - C->ptr[perm[k]]);
+  }
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int k = 0; k < (int) n; k ++) {
+
+    const size_t src = C->ptr[perm[k]];
+    const size_t dst = D->ptr[k];
+    const size_t len = D->ptr[k + 1] - dst;
+    unsigned* col = D->col + dst;
+    float* val = D->val + dst;
+
+    // Les lignes courtes sont triées par insertion au fil de la copie.
+    if (len <= 32) {
+      for (size_t t = 0; t != len; t ++) {
+        const unsigned c = inverse[C->col[src + t]];
+        const float v = C->val[src + t];
+        size_t p = t;
+        for (; p != 0 && col[p - 1] > c; p --) {
+          col[p] = col[p - 1];
+          val[p] = val[p - 1];
+        }
+        col[p] = c;
+        val[p] = v;
+      }
+      continue;
+    }
+
+    entry_t* row = (entry_t*) malloc(sizeof(entry_t) * len);
+    for (size_t t = 0; t != len; t ++) {
+      row[t].col = inverse[C->col[src + t]];
+      row[t].val = C->val[src + t];
+    }
+    qsort(row, len, sizeof(entry_t), compare);
+    for (size_t t = 0; t != len; t ++) {
+      col[t] = row[t].col;
+      val[t] = row[t].val;
+    }
+    free(row);
+
+  }
+
+  free(inverse);
+  return D;
+
+}
+
+/******************
+ * reorder_gather *
+ ******************/
+
+void
+reorder_gather(const unsigned perm[],
+               const float x[restrict],
+                     float y[restrict],
+               const unsigned n) {
+
+  for (unsigned k = 0; k != n; k ++) {
+    y[k] = x[perm[k]];
+  }
+
+}
+
+/*******************
+ * reorder_scatter *
+ *******************/
+
+void
+reorder_scatter(const unsigned perm[],
+                const float y[restrict],
+                      float x[restrict],
+                const unsigned n) {
+
+  for (unsigned k = 0; k != n; k ++) {
+    x[perm[k]] = y[k];
+  }
+
+}
+
+/*********************
+ * reorder_bandwidth *
+ *********************/
+
+size_t
+reorder_bandwidth(const csr_t* C) {
+
+  size_t width = 0;
+  for (unsigned i = 0; i != C->rows; i ++) {
+    for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+      const size_t d = C->col[k] > i ? C->col[k] - i : i - C->col[k];
+      width = d > width ? d : width;
+    }
+  }
+  return width;
+
+}
+
+/*******************
+ * reorder_profile *
+ *******************/
+
+size_t
+reorder_profile(const csr_t* C) {
+
+  size_t profile = 0;
+  for (unsigned i = 0; i != C->rows; i ++) {
+    unsigned first = i;
+    for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+      first = C->col[k] < first ? C->col[k] : first;
+    }
+    profile += i - first;
+  }
+  return profile;
+
+}
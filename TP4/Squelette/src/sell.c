@@ -0,0 +1,240 @@
+#include "sell.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Ligne et longueur, pour le tri des fenêtres.
+ */
+typedef struct {
+  unsigned row;
+  unsigned len;
+} entry_t;
+
+/*
+ * Ordre des longueurs décroissantes, à longueurs égales celui des lignes
+ * (tri stable).
+ */
+static int
+compare(const void* a, const void* b) {
+  const entry_t* x = (const entry_t*) a;
+  const entry_t* y = (const entry_t*) b;
+  if (x->len != y->len) {
+    return x->len < y->len ? 1 : -1;
+  }
+  return (x->row > y->row) - (x->row < y->row);
+}
+
+/*
+ * Permutation des lignes : tri par longueurs décroissantes dans chaque
+ * fenêtre de sigma lignes. perm est complété par rows jusqu'à un multiple de
+ * SELL_C lignes, et la longueur de chaque ligne permutée est écrite dans len
+ * (0 pour les lignes de complément).
+ */
+static void
+permute(const csr_t* C, const unsigned sigma, unsigned perm[], unsigned len[]) {
+
+  const unsigned padded = (C->rows + SELL_C - 1) / SELL_C * SELL_C;
+  entry_t* window = (entry_t*) malloc(sizeof(entry_t) * (sigma ? sigma : 1));
+
+  for (unsigned r0 = 0; r0 < C->rows; r0 += sigma) {
+    const unsigned r1 = C->rows - r0 < sigma ? C->rows : r0 + sigma;
+    for (unsigned r = r0; r != r1; r ++) {
+      window[r - r0].row = r;
+      window[r - r0].len = C->ptr[r + 1] - C->ptr[r];
+    }
+    if (sigma > 1) {
+      qsort(window, r1 - r0, sizeof(entry_t), compare);
+    }
+    for (unsigned r = r0; r != r1; r ++) {
+      perm[r] = window[r - r0].row;
+      len[r] = window[r - r0].len;
+    }
+  }
+  for (unsigned r = C->rows; r != padded; r ++) {
+    perm[r] = C->rows;
+    len[r] = 0;
+  }
+
+  free(window);
+
+}
+
+/*
+ * Taille des fenêtres, arrondie au multiple de SELL_C supérieur afin
+ * qu'aucune tranche ne soit à cheval sur deux fenêtres.
+ */
+static inline unsigned
+window(const unsigned sigma) {
+  return sigma <= 1 ? 1 : (sigma + SELL_C - 1) / SELL_C * SELL_C;
+}
+
+/*****************
+ * sell_from_csr *
+ *****************/
+
+sell_t*
+sell_from_csr(const csr_t* C, const unsigned sigma) {
+
+  sell_t* S = (sell_t*) malloc(sizeof(sell_t));
+  S->rows = C->rows;
+  S->cols = C->cols;
+  S->sigma = window(sigma);
+  S->slices = (C->rows + SELL_C - 1) / SELL_C;
+  S->nnz = C->nnz;
+
+  const size_t padded = (size_t) S->slices * SELL_C;
+  S->perm = (unsigned*) malloc(sizeof(unsigned) * (padded ? padded : 1));
+  unsigned* len = (unsigned*) malloc(sizeof(unsigned) * (padded ? padded : 1));
+  permute(C, S->sigma, S->perm, len);
+
+  // Largeur de chaque tranche : sa plus longue ligne.
+  S->ptr = (size_t*) malloc(sizeof(size_t) * ((size_t) S->slices + 1));
+  S->ptr[0] = 0;
+  for (unsigned s = 0; s != S->slices; s ++) {
+    unsigned width = 0;
+    for (unsigned l = 0; l != SELL_C; l ++) {
+      if (len[s * SELL_C + l] > width) {
+        width = len[s * SELL_C + l];
+      }
+    }
+    S->ptr[s + 1] = S->ptr[s] + (size_t) width * SELL_C;
+  }
+  S->stored = S->ptr[S->slices];
+
+  // Remplissage : éléments de chaque ligne, puis zéros de la dernière
+  // colonne de la ligne (de colonne 0 pour une ligne vide), ce qui évite de
+  // rassembler des composantes de x sans rapport avec la ligne. Ces zéros
+  // sont de plus masqués lors du produit (voir len).
+  S->col = (unsigned*) calloc(S->stored ? S->stored : 1, sizeof(unsigned));
+  S->val = (float*) aligned_alloc(16,
+                                  sizeof(float) * (S->stored ? S->stored : 4));
+  memset(S->val, 0, sizeof(float) * S->stored);
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int s = 0; s < (int) S->slices; s ++) {
+    for (unsigned l = 0; l != SELL_C; l ++) {
+      const unsigned r = S->perm[s * SELL_C + l];
+      if (r == C->rows) {
+        continue;
+      }
+      size_t dst = S->ptr[s] + l;
+      for (size_t k = C->ptr[r]; k != C->ptr[r + 1]; k ++, dst += SELL_C) {
+        S->col[dst] = C->col[k];
+        S->val[dst] = C->val[k];
+      }
+      if (C->ptr[r + 1] != C->ptr[r]) {
+        const unsigned last = C->col[C->ptr[r + 1] - 1];
+        for (; dst < S->ptr[s + 1]; dst += SELL_C) {
+          S->col[dst] = last;
+        }
+      }
+    }
+  }
+
+  S->len = len;
+  return S;
+
+}
+
+/***************
+ * sell_stored *
+ ***************/
+
+size_t
+sell_stored(const csr_t* C, const unsigned sigma) {
+
+  const unsigned slices = (C->rows + SELL_C - 1) / SELL_C;
+  const size_t padded = (size_t) slices * SELL_C;
+  unsigned* perm = (unsigned*) malloc(sizeof(unsigned) * (padded ? padded : 1));
+  unsigned* len = (unsigned*) malloc(sizeof(unsigned) * (padded ? padded : 1));
+  permute(C, window(sigma), perm, len);
+
+  size_t stored = 0;
+  for (unsigned s = 0; s != slices; s ++) {
+    unsigned width = 0;
+    for (unsigned l = 0; l != SELL_C; l ++) {
+      if (len[s * SELL_C + l] > width) {
+        width = len[s * SELL_C + l];
+      }
+    }
+    stored += (size_t) width * SELL_C;
+  }
+
+  free(perm);
+  free(len);
+  return stored;
+
+}
+
+/*************
+ * sell_free *
+ *************/
+
+void
+sell_free(sell_t* S) {
+
+  if (S == NULL) {
+    return;
+  }
+  free(S->ptr);
+  free(S->perm);
+  free(S->len);
+  free(S->col);
+  free(S->val);
+  free(S);
+
+}
+
+/***************
+ * sell_matvec *
+ ***************/
+
+void
+sell_matvec(const sell_t* S, const float x[restrict], float b[restrict]) {
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int s = 0; s < (int) S->slices; s ++) {
+
+    xmm_t acc;
+    acc.m128_vec = _mm_setzero_ps();
+    const unsigned* col = S->col + S->ptr[s];
+    const float* val = S->val + S->ptr[s];
+    const size_t end = S->ptr[s + 1] - S->ptr[s];
+
+    // Longueurs des lignes de la tranche : le produit d'un élément de
+    // remplissage est annulé par un masque, 0 * x[c] valant NaN lorsque
+    // x[c] est infini ou NaN.
+    const unsigned* lens = S->len + (size_t) s * SELL_C;
+    const __m128i len = _mm_loadu_si128((const __m128i*) lens);
+    int j = 0;
+    for (size_t k = 0; k != end; k += SELL_C, j ++) {
+      const __m128 xx = _mm_set_ps(x[col[k + 3]], x[col[k + 2]],
+                                   x[col[k + 1]], x[col[k]]);
+      const __m128 keep = _mm_castsi128_ps(_mm_cmpgt_epi32(len,
+                                                           _mm_set1_epi32(j)));
+      acc.m128_vec = _mm_add_ps(acc.m128_vec,
+                                _mm_and_ps(_mm_mul_ps(_mm_load_ps(val + k), xx),
+                                           keep));
+    }
+
+    const unsigned* perm = S->perm + (size_t) s * SELL_C;
+    for (unsigned l = 0; l != SELL_C; l ++) {
+      if (perm[l] != S->rows) {
+        b[perm[l]] = acc.m128_f32[l];
+      }
+    }
+
+  }
+
+}
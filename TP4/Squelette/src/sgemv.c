@@ -0,0 +1,328 @@
+#include "sgemv.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <x86intrin.h>
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/*
+ * Adresse de la première composante logique d'un vecteur BLAS : lorsque le
+ * pas est négatif, le vecteur est parcouru à partir de sa dernière case.
+ */
+static inline const float*
+origin(const float v[], const int len, const int inc) {
+  return inc > 0 ? v : v - (ptrdiff_t) (len - 1) * inc;
+}
+
+/*
+ * Mise à l'échelle b = beta * b (cas où le produit n'apporte aucune
+ * contribution). Lorsque beta est nul, b n'est pas lu.
+ */
+static void
+scale(const int len, const float beta, float b[], const int inc) {
+  for (int i = 0; i != len; i ++) {
+    b[i * inc] = beta == 0.0f ? 0.0f : beta * b[i * inc];
+  }
+}
+
+/*************
+ * sgemv_dot *
+ *************/
+
+/*
+ * Forme "produits scalaires" : chaque composante de b est le produit scalaire
+ * d'une ligne contiguë de A (de longueur cols, deux lignes étant espacées de
+ * lda) et du vecteur x (contigu). Quatre lignes sont traitées simultanément
+ * afin de réutiliser chaque chargement de x, puis les quatre accumulateurs
+ * sont transposés pour obtenir en un seul registre les quatre composantes,
+ * auxquelles alpha et beta sont appliqués avant l'écriture.
+ */
+static void
+sgemv_dot(const int rows,
+          const int cols,
+          const float alpha,
+          const float A[restrict],
+          const int lda,
+          const float x[restrict],
+          const float beta,
+                float b[restrict],
+          const int incb) {
+
+  const __m128 aa = _mm_set1_ps(alpha);
+  const __m128 bb = _mm_set1_ps(beta);
+  const int cols4 = cols & ~3;
+
+  int i = 0;
+  for (; i + 4 <= rows; i += 4) {
+    const float* A0 = A + (ptrdiff_t) i * lda;
+    const float* A1 = A0 + lda;
+    const float* A2 = A1 + lda;
+    const float* A3 = A2 + lda;
+
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+
+    int k = 0;
+    for (; k != cols4; k += 4) {
+      const __m128 xx = _mm_loadu_ps(x + k);
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(A0 + k), xx));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(A1 + k), xx));
+      acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(A2 + k), xx));
+      acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(A3 + k), xx));
+    }
+
+    // Après transposition, la somme des quatre registres contient les
+    // produits scalaires des quatre lignes.
+    _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+    xmm_t dot;
+    dot.m128_vec = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+
+    // Éléments résiduels des lignes.
+    for (; k != cols; k ++) {
+      dot.m128_f32[0] += A0[k] * x[k];
+      dot.m128_f32[1] += A1[k] * x[k];
+      dot.m128_f32[2] += A2[k] * x[k];
+      dot.m128_f32[3] += A3[k] * x[k];
+    }
+
+    // Application fusionnée de alpha et beta.
+    dot.m128_vec = _mm_mul_ps(aa, dot.m128_vec);
+    if (incb == 1) {
+      if (beta != 0.0f) {
+        dot.m128_vec = _mm_add_ps(dot.m128_vec,
+                                  _mm_mul_ps(bb, _mm_loadu_ps(b + i)));
+      }
+      _mm_storeu_ps(b + i, dot.m128_vec);
+    } else {
+      for (int r = 0; r != 4; r ++) {
+        float* bi = b + (ptrdiff_t) (i + r) * incb;
+        *bi = beta == 0.0f ? dot.m128_f32[r] : dot.m128_f32[r] + beta * *bi;
+      }
+    }
+  }
+
+  // Lignes résiduelles, traitées une à une.
+  for (; i != rows; i ++) {
+    const float* Ai = A + (ptrdiff_t) i * lda;
+    xmm_t acc;
+    acc.m128_vec = _mm_setzero_ps();
+    int k = 0;
+    for (; k != cols4; k += 4) {
+      acc.m128_vec = _mm_add_ps(acc.m128_vec,
+                                _mm_mul_ps(_mm_loadu_ps(Ai + k),
+                                           _mm_loadu_ps(x + k)));
+    }
+    float dot = acc.m128_f32[0] + acc.m128_f32[1]
+      + acc.m128_f32[2] + acc.m128_f32[3];
+    for (; k != cols; k ++) {
+      dot += Ai[k] * x[k];
+    }
+    float* bi = b + (ptrdiff_t) i * incb;
+    *bi = beta == 0.0f ? alpha * dot : alpha * dot + beta * *bi;
+  }
+
+}
+
+/**************
+ * sgemv_axpy *
+ **************/
+
+/*
+ * Forme "combinaisons linéaires" : b est la somme des colonnes contiguës de A
+ * (de longueur rows, deux colonnes étant espacées de lda) pondérées par les
+ * composantes de x. Les colonnes sont consommées quatre par quatre pour
+ * diviser par quatre le nombre de passes sur b, et la mise à l'échelle par
+ * beta est fusionnée avec la première de ces passes. Le vecteur b est ici
+ * supposé contigu.
+ */
+static void
+sgemv_axpy(const int rows,
+           const int cols,
+           const float alpha,
+           const float A[restrict],
+           const int lda,
+           const float x[restrict],
+           const int incx,
+           const float beta,
+                 float b[restrict]) {
+
+  const int rows4 = rows & ~3;
+
+  // Pondération de b lors de la première passe : beta, puis 1 pour les
+  // passes suivantes.
+  float weight = beta;
+
+  int j = 0;
+  for (; j + 4 <= cols; j += 4) {
+    const float* A0 = A + (ptrdiff_t) j * lda;
+    const float* A1 = A0 + lda;
+    const float* A2 = A1 + lda;
+    const float* A3 = A2 + lda;
+    const float s0 = alpha * x[(ptrdiff_t) (j    ) * incx];
+    const float s1 = alpha * x[(ptrdiff_t) (j + 1) * incx];
+    const float s2 = alpha * x[(ptrdiff_t) (j + 2) * incx];
+    const float s3 = alpha * x[(ptrdiff_t) (j + 3) * incx];
+    const __m128 ss0 = _mm_set1_ps(s0), ss1 = _mm_set1_ps(s1);
+    const __m128 ss2 = _mm_set1_ps(s2), ss3 = _mm_set1_ps(s3);
+    const __m128 ww = _mm_set1_ps(weight);
+
+    int i = 0;
+    for (; i != rows4; i += 4) {
+      __m128 acc = _mm_add_ps(_mm_mul_ps(ss0, _mm_loadu_ps(A0 + i)),
+                              _mm_mul_ps(ss1, _mm_loadu_ps(A1 + i)));
+      acc = _mm_add_ps(acc,
+                       _mm_add_ps(_mm_mul_ps(ss2, _mm_loadu_ps(A2 + i)),
+                                  _mm_mul_ps(ss3, _mm_loadu_ps(A3 + i))));
+      if (weight != 0.0f) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(ww, _mm_loadu_ps(b + i)));
+      }
+      _mm_storeu_ps(b + i, acc);
+    }
+    for (; i != rows; i ++) {
+      const float acc = s0 * A0[i] + s1 * A1[i] + s2 * A2[i] + s3 * A3[i];
+      b[i] = weight == 0.0f ? acc : acc + weight * b[i];
+    }
+
+    weight = 1.0f;
+  }
+
+  // Colonnes résiduelles, traitées une à une.
+  for (; j != cols; j ++) {
+    const float* Aj = A + (ptrdiff_t) j * lda;
+    const float s = alpha * x[(ptrdiff_t) j * incx];
+    for (int i = 0; i != rows; i ++) {
+      b[i] = weight == 0.0f ? s * Aj[i] : s * Aj[i] + weight * b[i];
+    }
+    weight = 1.0f;
+  }
+
+}
+
+/****************
+ * sgemv_scalar *
+ ****************/
+
+/*
+ * Forme scalaire, sans tampon : chaque composante de b est le produit
+ * scalaire de la ligne correspondante de op(A) (contiguë si dot, d'éléments
+ * espacés de lda sinon) et de x, tous deux lus avec leurs pas. Utilisée
+ * lorsque la copie contiguë d'un vecteur ne peut être allouée.
+ */
+static void
+sgemv_scalar(const int dot,
+             const int rows,
+             const int cols,
+             const float alpha,
+             const float A[restrict],
+             const int lda,
+             const float x[restrict],
+             const int incx,
+             const float beta,
+                   float b[restrict],
+             const int incb) {
+
+  const ptrdiff_t si = dot ? lda : 1, sk = dot ? 1 : lda;
+  for (int i = 0; i != rows; i ++) {
+    float sum = 0.0f;
+    for (int k = 0; k != cols; k ++) {
+      sum += A[i * si + k * sk] * x[(ptrdiff_t) k * incx];
+    }
+    float* bi = b + (ptrdiff_t) i * incb;
+    *bi = beta == 0.0f ? alpha * sum : alpha * sum + beta * *bi;
+  }
+
+}
+
+/*********
+ * sgemv *
+ *********/
+
+void
+sgemv(const enum sgemv_order order,
+      const enum sgemv_trans trans,
+      const int m,
+      const int n,
+      const float alpha,
+      const float A[],
+      const int lda,
+      const float x[],
+      const int incx,
+      const float beta,
+            float b[],
+      const int incb) {
+
+  // Longueurs respectives de b et x une fois op() appliquée.
+  const int lenb = trans == SGEMV_NO_TRANS ? m : n;
+  const int lenx = trans == SGEMV_NO_TRANS ? n : m;
+
+  // Retour immédiat, comme en BLAS.
+  if (m <= 0 || n <= 0 || (alpha == 0.0f && beta == 1.0f)) {
+    return;
+  }
+
+  float* bs = (float*) origin(b, lenb, incb);
+  const float* xs = origin(x, lenx, incx);
+
+  if (alpha == 0.0f) {
+    scale(lenb, beta, bs, incb);
+    return;
+  }
+
+  // Les lignes de A (stockage par lignes) ou ses colonnes (stockage par
+  // colonnes) sont contiguës en mémoire. Lorsque op(A) fait correspondre
+  // celles-ci aux composantes de b, nous utilisons la forme produits
+  // scalaires ; sinon, la forme combinaisons linéaires.
+  const int dot = (order == SGEMV_ROW_MAJOR) == (trans == SGEMV_NO_TRANS);
+
+  if (dot) {
+
+    // x est relu pour chaque ligne : s'il n'est pas contigu, il est d'abord
+    // recopié dans un tampon afin de permettre des chargements vectoriels.
+    float* xp = NULL;
+    if (incx != 1) {
+      xp = (float*) malloc(sizeof(float) * lenx);
+      if (xp == NULL) {
+        sgemv_scalar(dot, lenb, lenx, alpha, A, lda, xs, incx, beta, bs, incb);
+        return;
+      }
+      for (int k = 0; k != lenx; k ++) {
+        xp[k] = xs[(ptrdiff_t) k * incx];
+      }
+      xs = xp;
+    }
+    sgemv_dot(lenb, lenx, alpha, A, lda, xs, beta, bs, incb);
+    free(xp);
+
+  } else {
+
+    // b est relu à chaque passe : s'il n'est pas contigu, nous travaillons
+    // sur une copie contiguë que nous recopions ensuite.
+    if (incb == 1) {
+      sgemv_axpy(lenb, lenx, alpha, A, lda, xs, incx, beta, bs);
+    } else {
+      float* bp = (float*) malloc(sizeof(float) * lenb);
+      if (bp == NULL) {
+        sgemv_scalar(dot, lenb, lenx, alpha, A, lda, xs, incx, beta, bs, incb);
+        return;
+      }
+      for (int i = 0; i != lenb; i ++) {
+        bp[i] = beta == 0.0f ? 0.0f : bs[(ptrdiff_t) i * incb];
+      }
+      sgemv_axpy(lenb, lenx, alpha, A, lda, xs, incx, beta, bp);
+      for (int i = 0; i != lenb; i ++) {
+        bs[(ptrdiff_t) i * incb] = bp[i];
+      }
+      free(bp);
+    }
+
+  }
+
+}
@@ -0,0 +1,178 @@
+#include "sger.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <x86intrin.h>
+
+/*
+ * Union permettant d'accéder aux quatre nombre flottants simple précision
+ * compactés dans un registre 128 bits.
+ */
+typedef union {
+  __m128 m128_vec;    // Le registre.
+  float  m128_f32[4]; // Ce même registre vu comme un tableau de taille 4.
+} xmm_t;
+
+/********
+ * sger *
+ ********/
+
+void
+sger(float A[],
+     const unsigned size,
+     const float alpha,
+     const float u[],
+     const float v[]) {
+
+  const unsigned size4 = size & ~3u;
+
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < (int) size; i ++) {
+    float* a = A + (size_t) i * size;
+    const float s = alpha * u[i];
+    const __m128 ss = _mm_set1_ps(s);
+    unsigned j = 0;
+    for (; j != size4; j += 4) {
+      _mm_storeu_ps(a + j, _mm_add_ps(_mm_loadu_ps(a + j),
+                                      _mm_mul_ps(ss, _mm_loadu_ps(v + j))));
+    }
+    for (; j != size; j ++) {
+      a[j] += s * v[j];
+    }
+  }
+
+}
+
+/********
+ * ssyr *
+ ********/
+
+void
+ssyr(float A[],
+     const unsigned size,
+     const float alpha,
+     const float u[]) {
+
+  const unsigned size4 = size & ~3u;
+  const __m128 aa = _mm_set1_ps(alpha);
+
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < (int) size; i ++) {
+    float* a = A + (size_t) i * size;
+    const __m128 ui = _mm_set1_ps(u[i]);
+    unsigned j = 0;
+    for (; j != size4; j += 4) {
+      const __m128 uu = _mm_mul_ps(ui, _mm_loadu_ps(u + j));
+      _mm_storeu_ps(a + j, _mm_add_ps(_mm_loadu_ps(a + j),
+                                      _mm_mul_ps(aa, uu)));
+    }
+    for (; j != size; j ++) {
+      a[j] += alpha * (u[i] * u[j]);
+    }
+  }
+
+}
+
+/**********
+ * sger_k *
+ **********/
+
+void
+sger_k(float A[],
+       const unsigned size,
+       const float alpha,
+       const float U[],
+       const float Vt[],
+       const unsigned k) {
+
+#pragma omp parallel
+  {
+
+    // Facteurs alpha * U[i][t] de la ligne courante.
+    float* s = (float*) malloc(sizeof(float) * (k ? k : 1));
+
+    // Chaque thread parcourt ses lignes une fois par bloc de colonnes.
+    for (unsigned j0 = 0; j0 < size; j0 += SGER_BLOCK) {
+
+      const unsigned j1 = size - j0 < SGER_BLOCK ? size : j0 + SGER_BLOCK;
+      const unsigned j4 = j0 + ((j1 - j0) & ~3u);
+
+#pragma omp for schedule(static) nowait
+      for (int i = 0; i < (int) size; i ++) {
+
+        float* a = A + (size_t) i * size;
+        for (unsigned t = 0; t != k; t ++) {
+          s[t] = alpha * U[(size_t) i * k + t];
+        }
+
+        unsigned j = j0;
+        for (; j != j4; j += 4) {
+          __m128 acc = _mm_loadu_ps(a + j);
+          const float* vt = Vt + j;
+          for (unsigned t = 0; t != k; t ++, vt += size) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(s[t]),
+                                             _mm_loadu_ps(vt)));
+          }
+          _mm_storeu_ps(a + j, acc);
+        }
+        for (; j != j1; j ++) {
+          float acc = a[j];
+          for (unsigned t = 0; t != k; t ++) {
+            acc += s[t] * Vt[(size_t) t * size + j];
+          }
+          a[j] = acc;
+        }
+
+      }
+
+    }
+
+    free(s);
+
+  }
+
+}
+
+/***************
+ * sger_matvec *
+ ***************/
+
+void
+sger_matvec(float A[],
+            const unsigned size,
+            const float alpha,
+            const float u[],
+            const float v[],
+            const float x[],
+                  float b[]) {
+
+  const unsigned size4 = size & ~3u;
+
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < (int) size; i ++) {
+
+    float* a = A + (size_t) i * size;
+    const float s = alpha * u[i];
+    const __m128 ss = _mm_set1_ps(s);
+    xmm_t acc;
+    acc.m128_vec = _mm_setzero_ps();
+
+    unsigned j = 0;
+    for (; j != size4; j += 4) {
+      const __m128 aa = _mm_add_ps(_mm_loadu_ps(a + j),
+                                   _mm_mul_ps(ss, _mm_loadu_ps(v + j)));
+      _mm_storeu_ps(a + j, aa);
+      acc.m128_vec = _mm_add_ps(acc.m128_vec,
+                                _mm_mul_ps(aa, _mm_loadu_ps(x + j)));
+    }
+    float dot = acc.m128_f32[0] + acc.m128_f32[1]
+      + acc.m128_f32[2] + acc.m128_f32[3];
+    for (; j != size; j ++) {
+      a[j] += s * v[j];
+      dot += a[j] * x[j];
+    }
+    b[i] = dot;
+
+  }
+
+}
@@ -0,0 +1,360 @@
+#include "spformat.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <omp.h>
+
+#include "matvec_wide.h"
+
+#define ROWS  (1u << 18) // Nombre de lignes des matrices de calibrage.
+#define FAR   (1u << 22) // Nombre de colonnes des matrices à accès lointains.
+#define PER          16  // Nombre d'éléments non nuls par ligne.
+#define RUNS          3  // Nombre de mesures de chaque noyau (la meilleure
+                         // est retenue).
+
+// Tailles de blocs candidates de bsr_detect.
+static const unsigned sizes[] = { 2, 3, 4, 8 };
+
+/*
+ * Matrice synthétique de calibrage : rows lignes regroupées par blocs de bs,
+ * chaque bloc de lignes comportant PER / bs blocs denses bs x bs. Les blocs
+ * sont proches de la diagonale (à moins de 8 * PER blocs) ou répartis sur
+ * les cols colonnes.
+ */
+static csr_t*
+synthetic(const unsigned rows, const unsigned cols, const unsigned bs,
+          const int far) {
+
+  const unsigned per = PER / bs ? PER / bs : 1;
+  const unsigned brows = rows / bs, bcols = cols / bs;
+  csr_t* C = csr_create(brows * bs, bcols * bs, (size_t) brows * bs * per * bs);
+
+  size_t k = 0;
+  unsigned* J = (unsigned*) malloc(sizeof(unsigned) * per);
+  for (unsigned I = 0; I != brows; I ++) {
+    // Colonnes de blocs croissantes et distinctes.
+    for (unsigned t = 0; t != per; t ++) {
+      if (far) {
+        J[t] = t * (bcols / per) + rand() % (bcols / per);
+      } else {
+        J[t] = ((unsigned long) I * bcols / brows + t * 8 + rand() % 8)
+          % bcols;
+      }
+    }
+    for (unsigned r = 0; r != bs; r ++) {
+      for (unsigned t = 0; t != per; t ++) {
+        for (unsigned c = 0; c != bs; c ++) {
+          C->col[k] = J[t] * bs + c;
+          C->val[k ++] = 1.0f;
+        }
+      }
+      C->ptr[I * bs + r + 1] = k;
+    }
+  }
+  free(J);
+
+  return C;
+
+}
+
+/*
+ * Meilleure durée, sur RUNS mesures, d'un produit par un noyau donné.
+ */
+static double
+measure(const spformat_t* F, const float x[], float b[]) {
+
+  spformat_matvec(F, x, b);
+  double best = HUGE_VAL;
+  for (unsigned r = 0; r != RUNS; r ++) {
+    const double start = omp_get_wtime();
+    spformat_matvec(F, x, b);
+    const double t = omp_get_wtime() - start;
+    if (t < best) {
+      best = t;
+    }
+  }
+  return best;
+
+}
+
+/*
+ * Conversion d'une matrice dans un format imposé.
+ */
+static spformat_t*
+convert(const csr_t* C, const spformat_kind_t kind, const unsigned bs) {
+
+  spformat_t* F = (spformat_t*) calloc(1, sizeof(spformat_t));
+  F->kind = kind;
+  F->stats.rows = C->rows;
+  F->stats.cols = C->cols;
+  F->csr = C;
+  switch (kind) {
+  case SPFORMAT_DENSE:
+    F->dense = (float*) malloc(sizeof(float) * C->rows * (size_t) C->cols);
+    csr_to_dense(C, F->dense);
+    break;
+  case SPFORMAT_SELL:
+    F->sell = sell_from_csr(C, SPFORMAT_SIGMA);
+    break;
+  case SPFORMAT_BSR:
+    F->bsr = bsr_from_csr(C, bs);
+    break;
+  default:
+    break;
+  }
+  return F;
+
+}
+
+/********************
+ * spformat_default *
+ ********************/
+
+void
+spformat_default(spformat_model_t* M) {
+
+  // Durées en nanosecondes par élément (calibrage compilé avec -O3).
+  M->dense = 0.32;
+  M->csr[0] = 1.38;
+  M->csr[1] = 13.0;
+  M->sell[0] = 1.15;
+  M->sell[1] = 11.2;
+  for (unsigned f = 0; f != 2; f ++) {
+    for (unsigned bs = 0; bs <= BSR_MAX; bs ++) {
+      M->bsr[f][bs] = HUGE_VAL;
+    }
+  }
+  M->bsr[0][2] = 1.01;
+  M->bsr[0][3] = 0.87;
+  M->bsr[0][4] = 0.62;
+  M->bsr[0][8] = 0.58;
+  M->bsr[1][2] = 5.9;
+  M->bsr[1][3] = 3.35;
+  M->bsr[1][4] = 2.0;
+  M->bsr[1][8] = 1.26;
+
+  M->dense *= 1e-9;
+  for (unsigned f = 0; f != 2; f ++) {
+    M->csr[f] *= 1e-9;
+    M->sell[f] *= 1e-9;
+    for (unsigned s = 0; s != sizeof(sizes) / sizeof(unsigned); s ++) {
+      M->bsr[f][sizes[s]] *= 1e-9;
+    }
+  }
+
+}
+
+/**********************
+ * spformat_calibrate *
+ **********************/
+
+void
+spformat_calibrate(spformat_model_t* M) {
+
+  spformat_default(M);
+
+  float* x = (float*) malloc(sizeof(float) * FAR);
+  float* b = (float*) malloc(sizeof(float) * ROWS);
+  for (unsigned i = 0; i != FAR; i ++) {
+    x[i] = 1.0f;
+  }
+
+  // Format dense : 1024 lignes de 16384 colonnes (64 Mo).
+  csr_t* C = csr_create(1024, 16384, 0);
+  for (unsigned i = 0; i != 1024; i ++) {
+    C->ptr[i + 1] = 0;
+  }
+  spformat_t* F = convert(C, SPFORMAT_DENSE, 1);
+  for (size_t i = 0; i != (size_t) 1024 * 16384; i ++) {
+    F->dense[i] = 1.0f;
+  }
+  M->dense = measure(F, x, b) / (1024.0 * 16384.0);
+  spformat_free(F);
+  csr_free(C);
+
+  // Formats creux, accès proches puis lointains.
+  for (unsigned f = 0; f != 2; f ++) {
+
+    C = synthetic(ROWS, f ? FAR : ROWS, 1, f);
+    F = convert(C, SPFORMAT_CSR, 1);
+    M->csr[f] = measure(F, x, b) / C->nnz;
+    spformat_free(F);
+    F = convert(C, SPFORMAT_SELL, 1);
+    M->sell[f] = measure(F, x, b) / F->sell->stored;
+    spformat_free(F);
+    csr_free(C);
+
+    for (unsigned s = 0; s != sizeof(sizes) / sizeof(unsigned); s ++) {
+      C = synthetic(ROWS, f ? FAR : ROWS, sizes[s], f);
+      F = convert(C, SPFORMAT_BSR, sizes[s]);
+      M->bsr[f][sizes[s]] = measure(F, x, b) / C->nnz;
+      spformat_free(F);
+      csr_free(C);
+    }
+
+  }
+
+  free(x);
+  free(b);
+
+}
+
+/********************
+ * spformat_analyze *
+ ********************/
+
+void
+spformat_analyze(const csr_t* C, spformat_stats_t* S) {
+
+  S->rows = C->rows;
+  S->cols = C->cols;
+  S->nnz = C->nnz;
+  S->ratio = C->rows && C->cols
+    ? (double) C->nnz / ((double) C->rows * C->cols) : 0.0;
+
+  // Longueurs de lignes et largeur de bande.
+  double sum = 0.0, squares = 0.0;
+  unsigned row_max = 0, bandwidth = 0;
+#pragma omp parallel for schedule(static) reduction(+:sum,squares) \
+  reduction(max:row_max,bandwidth)
+  for (int i = 0; i < (int) C->rows; i ++) {
+    const unsigned len = C->ptr[i + 1] - C->ptr[i];
+    sum += len;
+    squares += (double) len * len;
+    if (len > row_max) {
+      row_max = len;
+    }
+    for (size_t k = C->ptr[i]; k != C->ptr[i + 1]; k ++) {
+      const unsigned j = C->col[k];
+      const unsigned d = j > (unsigned) i ? j - i : i - j;
+      if (d > bandwidth) {
+        bandwidth = d;
+      }
+    }
+  }
+  S->row_mean = C->rows ? sum / C->rows : 0.0;
+  S->row_var = C->rows ? squares / C->rows - S->row_mean * S->row_mean : 0.0;
+  S->row_max = row_max;
+  S->bandwidth = bandwidth;
+
+  S->bs = bsr_detect(C, &S->fill);
+  S->sell_stored = sell_stored(C, SPFORMAT_SIGMA);
+
+}
+
+/*******************
+ * spformat_create *
+ *******************/
+
+spformat_t*
+spformat_create(const csr_t* C, const spformat_model_t* M) {
+
+  spformat_model_t model;
+  if (M == NULL) {
+    spformat_default(&model);
+    M = &model;
+  }
+
+  spformat_stats_t S;
+  spformat_analyze(C, &S);
+
+  // Durées prédites.
+  const unsigned reach = S.bandwidth < S.cols ? S.bandwidth : S.cols;
+  const int far = reach > SPFORMAT_NEAR;
+  double predicted[SPFORMAT_KINDS];
+  const double elems = (double) S.rows * S.cols;
+  predicted[SPFORMAT_DENSE] = elems * sizeof(float) <= SPFORMAT_DENSE_MAX
+    ? M->dense * elems : HUGE_VAL;
+  predicted[SPFORMAT_CSR] = M->csr[far] * S.nnz;
+  predicted[SPFORMAT_SELL] = M->sell[far] * S.sell_stored;
+  predicted[SPFORMAT_BSR] = S.bs > 1 && S.fill > 0.0
+    ? M->bsr[far][S.bs] * S.nnz / S.fill : HUGE_VAL;
+
+  spformat_kind_t kind = SPFORMAT_CSR;
+  for (unsigned k = 0; k != SPFORMAT_KINDS; k ++) {
+    if (predicted[k] < predicted[kind]) {
+      kind = (spformat_kind_t) k;
+    }
+  }
+
+  spformat_t* F = convert(C, kind, S.bs);
+  F->stats = S;
+  for (unsigned k = 0; k != SPFORMAT_KINDS; k ++) {
+    F->predicted[k] = predicted[k];
+  }
+  return F;
+
+}
+
+/********************
+ * spformat_convert *
+ ********************/
+
+spformat_t*
+spformat_convert(const csr_t* C, const spformat_kind_t kind) {
+
+  spformat_stats_t S;
+  spformat_analyze(C, &S);
+  spformat_t* F = convert(C, kind, S.bs);
+  F->stats = S;
+  for (unsigned k = 0; k != SPFORMAT_KINDS; k ++) {
+    F->predicted[k] = HUGE_VAL;
+  }
+  return F;
+
+}
+
+/*****************
+ * spformat_free *
+ *****************/
+
+void
+spformat_free(spformat_t* F) {
+
+  if (F == NULL) {
+    return;
+  }
+  free(F->dense);
+  sell_free(F->sell);
+  bsr_free(F->bsr);
+  free(F);
+
+}
+
+/*******************
+ * spformat_matvec *
+ *******************/
+
+void
+spformat_matvec(const spformat_t* F,
+                const float x[restrict],
+                      float b[restrict]) {
+
+  switch (F->kind) {
+  case SPFORMAT_DENSE:
+    matvec_wide(F->dense, x, b, F->stats.rows, F->stats.cols);
+    break;
+  case SPFORMAT_CSR:
+    csr_matvec(F->csr, x, b);
+    break;
+  case SPFORMAT_SELL:
+    sell_matvec(F->sell, x, b);
+    break;
+  case SPFORMAT_BSR:
+    bsr_matvec(F->bsr, x, b);
+    break;
+  }
+
+}
+
+/*****************
+ * spformat_name *
+ *****************/
+
+const char*
+spformat_name(const spformat_kind_t kind) {
+
+  static const char* names[SPFORMAT_KINDS] = { "dense", "csr", "sell", "bsr" };
+  return (unsigned) kind < SPFORMAT_KINDS ? names[kind] : "?";
+
+}
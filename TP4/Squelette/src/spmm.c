@@ -0,0 +1,103 @@
+#include "spmm.h"
+
+#include <x86intrin.h>
+
+/*
+ * Produit d'une ligne par les rest (au plus 3) derniers vecteurs, en un seul
+ * parcours. Appelée avec rest constant, la boucle interne est déroulée.
+ */
+static inline void
+tail(const csr_t* C, const size_t begin, const size_t end,
+     const float X[], const unsigned k, const unsigned j, float y[],
+     const unsigned rest) {
+
+  float sum[3] = { 0.0f, 0.0f, 0.0f };
+  for (size_t t = begin; t != end; t ++) {
+    const float v = C->val[t];
+    const float* x = X + (size_t) C->col[t] * k + j;
+    for (unsigned l = 0; l != rest; l ++) {
+      sum[l] += v * x[l];
+    }
+  }
+  for (unsigned l = 0; l != rest; l ++) {
+    y[j + l] = sum[l];
+  }
+
+}
+
+/********
+ * spmm *
+ ********/
+
+void
+spmm(const csr_t* C,
+     const float X[restrict],
+           float Y[restrict],
+     const unsigned k) {
+
+  const unsigned k16 = k & ~15u;
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < (int) C->rows; i ++) {
+
+    const size_t begin = C->ptr[i], end = C->ptr[i + 1];
+    float* y = Y + (size_t) i * k;
+
+    // Paquets de 16 vecteurs : la ligne de C, relue pour chaque paquet,
+    // réside alors dans le cache L1.
+    for (unsigned j = 0; j != k16; j += 16) {
+      __m128 y0 = _mm_setzero_ps(), y1 = _mm_setzero_ps();
+      __m128 y2 = _mm_setzero_ps(), y3 = _mm_setzero_ps();
+      for (size_t t = begin; t != end; t ++) {
+        const __m128 v = _mm_set1_ps(C->val[t]);
+        const float* x = X + (size_t) C->col[t] * k + j;
+        y0 = _mm_add_ps(y0, _mm_mul_ps(v, _mm_loadu_ps(x)));
+        y1 = _mm_add_ps(y1, _mm_mul_ps(v, _mm_loadu_ps(x + 4)));
+        y2 = _mm_add_ps(y2, _mm_mul_ps(v, _mm_loadu_ps(x + 8)));
+        y3 = _mm_add_ps(y3, _mm_mul_ps(v, _mm_loadu_ps(x + 12)));
+      }
+      _mm_storeu_ps(y + j, y0);
+      _mm_storeu_ps(y + j + 4, y1);
+      _mm_storeu_ps(y + j + 8, y2);
+      _mm_storeu_ps(y + j + 12, y3);
+    }
+
+    // Paquets de 8 puis de 4 vecteurs.
+    unsigned j = k16;
+    for (; j + 8 <= k; j += 8) {
+      __m128 y0 = _mm_setzero_ps(), y1 = _mm_setzero_ps();
+      for (size_t t = begin; t != end; t ++) {
+        const __m128 v = _mm_set1_ps(C->val[t]);
+        const float* x = X + (size_t) C->col[t] * k + j;
+        y0 = _mm_add_ps(y0, _mm_mul_ps(v, _mm_loadu_ps(x)));
+        y1 = _mm_add_ps(y1, _mm_mul_ps(v, _mm_loadu_ps(x + 4)));
+      }
+      _mm_storeu_ps(y + j, y0);
+      _mm_storeu_ps(y + j + 4, y1);
+    }
+    for (; j + 4 <= k; j += 4) {
+      __m128 y0 = _mm_setzero_ps();
+      for (size_t t = begin; t != end; t ++) {
+        y0 = _mm_add_ps(y0, _mm_mul_ps(_mm_set1_ps(C->val[t]),
+                                       _mm_loadu_ps(X + (size_t) C->col[t] * k
+                                                    + j)));
+      }
+      _mm_storeu_ps(y + j, y0);
+    }
+
+    // Au plus trois vecteurs restants.
+    switch (k - j) {
+    case 1:
+      tail(C, begin, end, X, k, j, y, 1);
+      break;
+    case 2:
+      tail(C, begin, end, X, k, j, y, 2);
+      break;
+    case 3:
+      tail(C, begin, end, X, k, j, y, 3);
+      break;
+    }
+
+  }
+
+}
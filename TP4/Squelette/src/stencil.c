@@ -0,0 +1,206 @@
+#include "stencil.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#define BLOCK_X 1024 // Taille par défaut des segments de lignes.
+#define BLOCK_Y   16 // Taille par défaut des blocs de lignes.
+
+/*
+ * Calcul des composantes [i0, i1[ d'une ligne. La ligne source est u, ses
+ * voisines selon l'axe j sont s et n, et selon l'axe k sont d et f (lignes
+ * nulles au bord de la grille). Seules les composantes i = 0 et i = nx - 1,
+ * dont un voisin selon l'axe i manque, sont traitées sous forme scalaire.
+ */
+static inline void
+row(const stencil_t* S,
+    const float u[restrict],
+    const float s[restrict],
+    const float n[restrict],
+    const float d[restrict],
+    const float f[restrict],
+          float out[restrict],
+    const unsigned i0,
+    const unsigned i1) {
+
+  const unsigned nx = S->nx;
+  const float diag = S->diag, cx = S->cx, cy = S->cy, cz = S->cz;
+
+  unsigned i = i0;
+
+  // Premier point de la ligne : pas de voisin à gauche.
+  if (i == 0 && i != i1) {
+    out[0] = diag * u[0] + cx * (nx > 1 ? u[1] : 0.0f)
+      + cy * (s[0] + n[0]) + cz * (d[0] + f[0]);
+    i ++;
+  }
+
+  // Points intérieurs, quatre à la fois.
+  const unsigned end = i1 < nx - 1 ? i1 : nx - 1;
+  const __m128 vdiag = _mm_set1_ps(diag);
+  const __m128 vcx = _mm_set1_ps(cx);
+  const __m128 vcy = _mm_set1_ps(cy);
+  const __m128 vcz = _mm_set1_ps(cz);
+  for (; i + 4 <= end; i += 4) {
+    __m128 acc = _mm_mul_ps(vdiag, _mm_loadu_ps(u + i));
+    acc = _mm_add_ps(acc, _mm_mul_ps(vcx, _mm_add_ps(_mm_loadu_ps(u + i - 1),
+                                                     _mm_loadu_ps(u + i + 1))));
+    acc = _mm_add_ps(acc, _mm_mul_ps(vcy, _mm_add_ps(_mm_loadu_ps(s + i),
+                                                     _mm_loadu_ps(n + i))));
+    acc = _mm_add_ps(acc, _mm_mul_ps(vcz, _mm_add_ps(_mm_loadu_ps(d + i),
+                                                     _mm_loadu_ps(f + i))));
+    _mm_storeu_ps(out + i, acc);
+  }
+
+  // Reliquat, dernier point de la ligne compris.
+  for (; i != i1; i ++) {
+    const float right = i + 1 < nx ? u[i + 1] : 0.0f;
+    out[i] = diag * u[i] + cx * (u[i - 1] + right)
+      + cy * (s[i] + n[i]) + cz * (d[i] + f[i]);
+  }
+
+}
+
+/******************
+ * stencil_create *
+ ******************/
+
+stencil_t*
+stencil_create(const unsigned nx,
+               const unsigned ny,
+               const unsigned nz,
+               const float diag,
+               const float cx,
+               const float cy,
+               const float cz) {
+
+  stencil_t* S = (stencil_t*) malloc(sizeof(stencil_t));
+  S->nx = nx;
+  S->ny = ny;
+  S->nz = nz;
+  S->diag = diag;
+  S->cx = cx;
+  S->cy = cy;
+  S->cz = nz > 1 ? cz : 0.0f;
+  S->bx = BLOCK_X;
+  S->by = BLOCK_Y;
+  S->zero = (float*) calloc(nx, sizeof(float));
+  return S;
+
+}
+
+/****************
+ * stencil_free *
+ ****************/
+
+void
+stencil_free(stencil_t* S) {
+
+  if (S == NULL) {
+    return;
+  }
+  free(S->zero);
+  free(S);
+
+}
+
+/****************
+ * stencil_size *
+ ****************/
+
+unsigned
+stencil_size(const stencil_t* S) {
+  return S->nx * S->ny * S->nz;
+}
+
+/***************
+ * stencil_nnz *
+ ***************/
+
+unsigned long
+stencil_nnz(const stencil_t* S) {
+
+  const unsigned long nx = S->nx, ny = S->ny, nz = S->nz;
+  unsigned long nnz = nx * ny * nz;
+  nnz += 2 * (nx - 1) * ny * nz;
+  nnz += 2 * nx * (ny - 1) * nz;
+  if (nz > 1) {
+    nnz += 2 * nx * ny * (nz - 1);
+  }
+  return nnz;
+
+}
+
+/******************
+ * stencil_matvec *
+ ******************/
+
+void
+stencil_matvec(const stencil_t* S,
+               const float x[restrict],
+                     float b[restrict]) {
+
+  const unsigned nx = S->nx, ny = S->ny, nz = S->nz;
+  const unsigned bx = S->bx ? S->bx : BLOCK_X;
+  const unsigned by = S->by ? S->by : BLOCK_Y;
+  const size_t plane = (size_t) nx * ny;
+  const int blocks = (ny + by - 1) / by;
+
+  // Chaque tâche est un bloc de by lignes d'un plan.
+#pragma omp parallel for collapse(2) schedule(static)
+  for (int k = 0; k < (int) nz; k ++) {
+    for (int blk = 0; blk < blocks; blk ++) {
+
+      const unsigned j0 = blk * by;
+      const unsigned j1 = j0 + by < ny ? j0 + by : ny;
+
+      // Parcours par segments de bx composantes : les segments des lignes
+      // j - 1, j et j + 1 (et de leurs voisines dans les plans k - 1 et
+      // k + 1) restent en cache d'une ligne à la suivante.
+      for (unsigned i0 = 0; i0 < nx; i0 += bx) {
+        const unsigned i1 = i0 + bx < nx ? i0 + bx : nx;
+        for (unsigned j = j0; j != j1; j ++) {
+          const size_t base = k * plane + (size_t) j * nx;
+          const float* u = x + base;
+          const float* s = j > 0      ? u - nx    : S->zero;
+          const float* n = j + 1 < ny ? u + nx    : S->zero;
+          const float* d = k > 0      ? u - plane : S->zero;
+          const float* f = k + 1 < (int) nz ? u + plane : S->zero;
+          row(S, u, s, n, d, f, b + base, i0, i1);
+        }
+      }
+
+    }
+  }
+
+}
+
+/********************
+ * stencil_assemble *
+ ********************/
+
+void
+stencil_assemble(const stencil_t* S, float A[]) {
+
+  const unsigned nx = S->nx, ny = S->ny, nz = S->nz;
+  const size_t n = stencil_size(S);
+  memset(A, 0, sizeof(float) * n * n);
+
+  for (unsigned k = 0; k != nz; k ++) {
+    for (unsigned j = 0; j != ny; j ++) {
+      for (unsigned i = 0; i != nx; i ++) {
+        const size_t p = i + (size_t) nx * (j + (size_t) ny * k);
+        float* Ap = A + p * n;
+        Ap[p] = S->diag;
+        if (i > 0)      Ap[p - 1] = S->cx;
+        if (i + 1 < nx) Ap[p + 1] = S->cx;
+        if (j > 0)      Ap[p - nx] = S->cy;
+        if (j + 1 < ny) Ap[p + nx] = S->cy;
+        if (k > 0)      Ap[p - (size_t) nx * ny] = S->cz;
+        if (k + 1 < nz) Ap[p + (size_t) nx * ny] = S->cz;
+      }
+    }
+  }
+
+}
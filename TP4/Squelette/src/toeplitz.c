@@ -0,0 +1,158 @@
+#include "toeplitz.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+
+/*
+ * Allocation d'un tableau de floats aligné sur 16 octets.
+ */
+static float*
+allocate(const unsigned count) {
+  return (float*) aligned_alloc(16, sizeof(float) * ((count + 3) & ~3u));
+}
+
+/*******************
+ * toeplitz_create *
+ *******************/
+
+toeplitz_t*
+toeplitz_create(const float col[],
+                const float row[],
+                const unsigned size) {
+
+  // La matrice doit être de taille supérieure ou égale à 1.
+  if (size == 0) {
+    return NULL;
+  }
+
+  // Plus petite puissance de 2 permettant le plongement circulant.
+  unsigned length = 2;
+  while (length < 2 * size) {
+    length *= 2;
+  }
+
+  toeplitz_t* T = (toeplitz_t*) malloc(sizeof(toeplitz_t));
+  if (T == NULL) {
+    return NULL;
+  }
+  T->size = size;
+  T->fft = fft_create(length);
+  T->vr = allocate(length / 2 + 1);
+  T->vi = allocate(length / 2 + 1);
+  T->xr = allocate(length / 2 + 1);
+  T->xi = allocate(length / 2 + 1);
+  T->work = allocate(length);
+  if (T->fft == NULL || T->vr == NULL || T->vi == NULL || T->xr == NULL
+      || T->xi == NULL || T->work == NULL) {
+    toeplitz_free(T);
+    return NULL;
+  }
+
+  // Générateur de la matrice circulante : la première colonne de T, des
+  // zéros, puis la première ligne de T lue à rebours.
+  float* v = T->work;
+  memset(v, 0, sizeof(float) * length);
+  for (unsigned i = 0; i != size; i ++) {
+    v[i] = col[i];
+  }
+  for (unsigned j = 1; j < size; j ++) {
+    v[length - j] = row[j];
+  }
+  fft_forward(T->fft, v, T->vr, T->vi);
+
+  return T;
+
+}
+
+/********************
+ * circulant_create *
+ ********************/
+
+toeplitz_t*
+circulant_create(const float col[], const unsigned size) {
+
+  // La matrice doit être de taille supérieure ou égale à 1.
+  if (size == 0) {
+    return NULL;
+  }
+
+  // La première ligne d'une matrice circulante est c[0], c[n-1], ... c[1].
+  float* row = (float*) malloc(sizeof(float) * size);
+  if (row == NULL) {
+    return NULL;
+  }
+  row[0] = col[0];
+  for (unsigned j = 1; j < size; j ++) {
+    row[j] = col[size - j];
+  }
+
+  toeplitz_t* T = toeplitz_create(col, row, size);
+  free(row);
+  return T;
+
+}
+
+/*****************
+ * toeplitz_free *
+ *****************/
+
+void
+toeplitz_free(toeplitz_t* T) {
+
+  if (T == NULL) {
+    return;
+  }
+  fft_free(T->fft);
+  free(T->vr);
+  free(T->vi);
+  free(T->xr);
+  free(T->xi);
+  free(T->work);
+  free(T);
+
+}
+
+/*******************
+ * toeplitz_matvec *
+ *******************/
+
+void
+toeplitz_matvec(toeplitz_t* T, const float x[], float b[]) {
+
+  const unsigned length = T->fft->length;
+  const unsigned bins = length / 2 + 1;
+  float* work = T->work;
+
+  // Vecteur source complété par des zéros.
+  memcpy(work, x, sizeof(float) * T->size);
+  memset(work + T->size, 0, sizeof(float) * (length - T->size));
+  fft_forward(T->fft, work, T->xr, T->xi);
+
+  // Produit terme à terme des deux spectres, quatre coefficients complexes
+  // à la fois.
+  float* xr = T->xr;
+  float* xi = T->xi;
+  const float* vr = T->vr;
+  const float* vi = T->vi;
+  unsigned k = 0;
+  for (; k + 4 <= bins; k += 4) {
+    const __m128 ar = _mm_load_ps(xr + k);
+    const __m128 ai = _mm_load_ps(xi + k);
+    const __m128 br = _mm_load_ps(vr + k);
+    const __m128 bi = _mm_load_ps(vi + k);
+    _mm_store_ps(xr + k, _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+    _mm_store_ps(xi + k, _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+  }
+  for (; k != bins; k ++) {
+    const float ar = xr[k];
+    xr[k] = ar * vr[k] - xi[k] * vi[k];
+    xi[k] = ar * vi[k] + xi[k] * vr[k];
+  }
+
+  // Retour dans le domaine temporel : les n premières composantes du produit
+  // circulant sont celles du produit de Toeplitz.
+  fft_inverse(T->fft, xr, xi, work);
+  memcpy(b, work, sizeof(float) * T->size);
+
+}
@@ -0,0 +1,245 @@
+#include "transpose.h"
+
+#include <stddef.h>
+#include <x86intrin.h>
+
+#define LEAF 32 // Côté maximal des feuilles de la récursion.
+
+/*
+ * Découpage d'une dimension en deux, la première moitié étant arrondie au
+ * multiple de 8 supérieur afin que les feuilles restent alignées sur les
+ * blocs 8 x 8.
+ */
+static inline unsigned
+half(const unsigned n) {
+  return (n / 2 + 7) & ~7u;
+}
+
+/*
+ * Transposition 4 x 4 dans les registres : b (4 x 4, pas ldb) = a^T.
+ */
+static inline void
+kernel4(const float* a, const size_t lda, float* b, const size_t ldb) {
+
+  __m128 r0 = _mm_loadu_ps(a);
+  __m128 r1 = _mm_loadu_ps(a + lda);
+  __m128 r2 = _mm_loadu_ps(a + 2 * lda);
+  __m128 r3 = _mm_loadu_ps(a + 3 * lda);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(b, r0);
+  _mm_storeu_ps(b + ldb, r1);
+  _mm_storeu_ps(b + 2 * ldb, r2);
+  _mm_storeu_ps(b + 3 * ldb, r3);
+
+}
+
+/*
+ * Transposition 8 x 8 : les quatre blocs 4 x 4 sont transposés et échangés.
+ */
+static inline void
+kernel8(const float* a, const size_t lda, float* b, const size_t ldb) {
+
+  kernel4(a,                lda, b,                ldb);
+  kernel4(a + 4,            lda, b + 4 * ldb,      ldb);
+  kernel4(a + 4 * lda,      lda, b + 4,            ldb);
+  kernel4(a + 4 * lda + 4,  lda, b + 4 * ldb + 4,  ldb);
+
+}
+
+/*
+ * Feuille hors place : blocs 8 x 8, puis bords scalaires. Les blocs sont
+ * parcourus lignes de B d'abord, afin que chaque ligne de B soit écrite par
+ * segments contigus de lignes de cache complètes.
+ */
+static void
+leaf(const float* a, const size_t lda, float* b, const size_t ldb,
+     const unsigned rows, const unsigned cols) {
+
+  const unsigned r8 = rows & ~7u, c8 = cols & ~7u;
+  for (unsigned j = 0; j != c8; j += 8) {
+    for (unsigned i = 0; i != r8; i += 8) {
+      kernel8(a + i * lda + j, lda, b + j * ldb + i, ldb);
+    }
+  }
+  for (unsigned i = 0; i != rows; i ++) {
+    for (unsigned j = i < r8 ? c8 : 0; j != cols; j ++) {
+      b[j * ldb + i] = a[i * lda + j];
+    }
+  }
+
+}
+
+/*
+ * Transposition hors place récursive d'un bloc rows x cols.
+ */
+static void
+recurse(const float* a, const size_t lda, float* b, const size_t ldb,
+        const unsigned rows, const unsigned cols) {
+
+  if (rows <= LEAF && cols <= LEAF) {
+    leaf(a, lda, b, ldb, rows, cols);
+  } else if (rows >= cols) {
+    const unsigned h = half(rows);
+    recurse(a,           lda, b,     ldb, h,        cols);
+    recurse(a + h * lda, lda, b + h, ldb, rows - h, cols);
+  } else {
+    const unsigned h = half(cols);
+    recurse(a,     lda, b,           ldb, rows, h);
+    recurse(a + h, lda, b + h * ldb, ldb, rows, cols - h);
+  }
+
+}
+
+/*
+ * Échange transposé de deux blocs 4 x 4 : x = y^T et y = x^T.
+ */
+static inline void
+swap4(float* x, float* y, const size_t ld) {
+
+  __m128 x0 = _mm_loadu_ps(x);
+  __m128 x1 = _mm_loadu_ps(x + ld);
+  __m128 x2 = _mm_loadu_ps(x + 2 * ld);
+  __m128 x3 = _mm_loadu_ps(x + 3 * ld);
+  __m128 y0 = _mm_loadu_ps(y);
+  __m128 y1 = _mm_loadu_ps(y + ld);
+  __m128 y2 = _mm_loadu_ps(y + 2 * ld);
+  __m128 y3 = _mm_loadu_ps(y + 3 * ld);
+  _MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+  _MM_TRANSPOSE4_PS(y0, y1, y2, y3);
+  _mm_storeu_ps(x,          y0);
+  _mm_storeu_ps(x + ld,     y1);
+  _mm_storeu_ps(x + 2 * ld, y2);
+  _mm_storeu_ps(x + 3 * ld, y3);
+  _mm_storeu_ps(y,          x0);
+  _mm_storeu_ps(y + ld,     x1);
+  _mm_storeu_ps(y + 2 * ld, x2);
+  _mm_storeu_ps(y + 3 * ld, x3);
+
+}
+
+/*
+ * Feuille d'échange : x (rows x cols) et y (cols x rows) sont remplacés par
+ * leurs transposées respectives.
+ */
+static void
+swap_leaf(float* x, float* y, const size_t ld,
+          const unsigned rows, const unsigned cols) {
+
+  const unsigned r4 = rows & ~3u, c4 = cols & ~3u;
+  for (unsigned i = 0; i != r4; i += 4) {
+    for (unsigned j = 0; j != c4; j += 4) {
+      swap4(x + i * ld + j, y + j * ld + i, ld);
+    }
+  }
+  for (unsigned i = 0; i != rows; i ++) {
+    for (unsigned j = i < r4 ? c4 : 0; j != cols; j ++) {
+      const float t = x[i * ld + j];
+      x[i * ld + j] = y[j * ld + i];
+      y[j * ld + i] = t;
+    }
+  }
+
+}
+
+/*
+ * Échange transposé récursif.
+ */
+static void
+swap_recurse(float* x, float* y, const size_t ld,
+             const unsigned rows, const unsigned cols) {
+
+  if (rows <= LEAF && cols <= LEAF) {
+    swap_leaf(x, y, ld, rows, cols);
+  } else if (rows >= cols) {
+    const unsigned h = half(rows);
+    swap_recurse(x,          y,     ld, h,        cols);
+    swap_recurse(x + h * ld, y + h, ld, rows - h, cols);
+  } else {
+    const unsigned h = half(cols);
+    swap_recurse(x,     y,          ld, rows, h);
+    swap_recurse(x + h, y + h * ld, ld, rows, cols - h);
+  }
+
+}
+
+/*
+ * Transposition en place récursive d'un bloc diagonal n x n : les deux blocs
+ * diagonaux sont transposés, les deux autres échangés. Les feuilles
+ * diagonales, qui ne représentent qu'une fraction LEAF / n de la matrice,
+ * sont traitées de façon scalaire.
+ */
+static void
+diagonal(float* a, const size_t ld, const unsigned n) {
+
+  if (n <= LEAF) {
+    for (unsigned i = 0; i != n; i ++) {
+      for (unsigned j = i + 1; j != n; j ++) {
+        const float t = a[i * ld + j];
+        a[i * ld + j] = a[j * ld + i];
+        a[j * ld + i] = t;
+      }
+    }
+    return;
+  }
+
+  const unsigned h = half(n);
+  diagonal(a, ld, h);
+  diagonal(a + h * ld + h, ld, n - h);
+  swap_recurse(a + h, a + h * ld, ld, h, n - h);
+
+}
+
+/*************
+ * transpose *
+ *************/
+
+void
+transpose(const float A[restrict],
+                float B[restrict],
+          const unsigned rows,
+          const unsigned cols) {
+
+  const int ti = (rows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+  const int tj = (cols + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+
+#pragma omp parallel for collapse(2) schedule(dynamic)
+  for (int I = 0; I < ti; I ++) {
+    for (int J = 0; J < tj; J ++) {
+      const unsigned i = I * TRANSPOSE_TILE, j = J * TRANSPOSE_TILE;
+      recurse(A + (size_t) i * cols + j, cols,
+              B + (size_t) j * rows + i, rows,
+              rows - i < TRANSPOSE_TILE ? rows - i : TRANSPOSE_TILE,
+              cols - j < TRANSPOSE_TILE ? cols - j : TRANSPOSE_TILE);
+    }
+  }
+
+}
+
+/*********************
+ * transpose_inplace *
+ *********************/
+
+void
+transpose_inplace(float A[], const unsigned n) {
+
+  const int t = (n + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+
+  // Paires de tuiles (I, J), J >= I, du triangle supérieur.
+#pragma omp parallel for collapse(2) schedule(dynamic)
+  for (int I = 0; I < t; I ++) {
+    for (int J = 0; J < t; J ++) {
+      if (J < I) {
+        continue;
+      }
+      const unsigned i = I * TRANSPOSE_TILE, j = J * TRANSPOSE_TILE;
+      const unsigned ri = n - i < TRANSPOSE_TILE ? n - i : TRANSPOSE_TILE;
+      const unsigned rj = n - j < TRANSPOSE_TILE ? n - j : TRANSPOSE_TILE;
+      if (I == J) {
+        diagonal(A + (size_t) i * n + i, n, ri);
+      } else {
+        swap_recurse(A + (size_t) i * n + j, A + (size_t) j * n + i, n, ri, rj);
+      }
+    }
+  }
+
+}
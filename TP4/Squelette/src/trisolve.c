@@ -0,0 +1,385 @@
+#define _POSIX_C_SOURCE 200809L // sched_yield.
+
+#include "trisolve.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+#include <omp.h>
+
+#define SPINS 1024 // Nombre d'attentes actives avant de céder le processeur.
+
+/*
+ * Compteur de progression d'un thread, seul sur sa ligne de cache.
+ */
+typedef struct {
+  _Alignas(64) unsigned done;
+} progress_t;
+
+/*
+ * Calcul de la composante r du système permuté : x[r] = (b[r] - somme des
+ * L[r][j] x[j], j != r) / L[r][r], la somme étant effectuée dans l'ordre des
+ * colonnes de la matrice d'origine.
+ */
+static inline void
+row(const trisolve_t* T, const unsigned r,
+    const float b[restrict], float x[restrict]) {
+
+  const size_t diag = T->diag[r];
+  float sum = 0.0f;
+  for (size_t k = T->ptr[r]; k != T->ptr[r + 1]; k ++) {
+    if (k != diag) {
+      sum += T->val[k] * x[T->col[k]];
+    }
+  }
+  x[r] = (b[r] - sum) / T->val[diag];
+
+}
+
+/*
+ * Position de l'élément diagonal de la ligne i, ou (size_t) -1 si la ligne
+ * n'en comporte pas ou comporte un élément du mauvais côté.
+ */
+static size_t
+find_diag(const csr_t* L, const trisolve_uplo_t uplo, const unsigned i) {
+
+  size_t diag = (size_t) -1;
+  for (size_t k = L->ptr[i]; k != L->ptr[i + 1]; k ++) {
+    const unsigned j = L->col[k];
+    if (j == i) {
+      diag = k;
+    } else if ((uplo == TRISOLVE_LOWER) != (j < i)) {
+      return (size_t) -1;
+    }
+  }
+  return diag != (size_t) -1 && L->val[diag] != 0.0f ? diag : (size_t) -1;
+
+}
+
+/********************
+ * trisolve_analyze *
+ ********************/
+
+trisolve_t*
+trisolve_analyze(const csr_t* L,
+                 const trisolve_uplo_t uplo,
+                 const unsigned threads) {
+
+  if (L->rows != L->cols) {
+    return NULL;
+  }
+
+  const unsigned n = L->rows;
+  size_t* diag = (size_t*) malloc(sizeof(size_t) * (n ? n : 1));
+  unsigned* level = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+
+  // Niveau de chaque ligne, dans l'ordre de la résolution.
+  unsigned levels = 0;
+  for (unsigned r = 0; r != n; r ++) {
+    const unsigned i = uplo == TRISOLVE_LOWER ? r : n - 1 - r;
+    diag[i] = find_diag(L, uplo, i);
+    if (diag[i] == (size_t) -1) {
+      free(diag);
+      free(level);
+      return NULL;
+    }
+    unsigned l = 0;
+    for (size_t k = L->ptr[i]; k != L->ptr[i + 1]; k ++) {
+      if (k != diag[i] && level[L->col[k]] + 1 > l) {
+        l = level[L->col[k]] + 1;
+      }
+    }
+    level[i] = l;
+    if (l + 1 > levels) {
+      levels = l + 1;
+    }
+  }
+
+  trisolve_t* T = (trisolve_t*) malloc(sizeof(trisolve_t));
+  T->n = n;
+  T->uplo = uplo;
+  T->threads = threads ? threads : (unsigned) omp_get_max_threads();
+
+  // Niveaux trop étroits, ou un seul thread : plan séquentiel, réduit à un
+  // unique niveau dont les lignes gardent leur numérotation d'origine (la
+  // renumérotation par niveaux dégraderait la localité).
+  if ((size_t) n < (size_t) levels * T->threads * TRISOLVE_MIN_ROWS) {
+    T->threads = 1;
+  }
+  if (T->threads == 1 && levels > 1) {
+    memset(level, 0, sizeof(unsigned) * n);
+    levels = 1;
+  }
+  T->levels = levels;
+  const unsigned p = T->threads;
+  const size_t chunks = (size_t) levels * p;
+
+  // Renumérotation des lignes par niveaux (tri par dénombrement, stable).
+  size_t* first = (size_t*) calloc((size_t) levels + 1, sizeof(size_t));
+  for (unsigned i = 0; i != n; i ++) {
+    first[level[i] + 1] ++;
+  }
+  for (unsigned l = 0; l != levels; l ++) {
+    first[l + 1] += first[l];
+  }
+  T->order = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  unsigned* inverse = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  for (unsigned r = 0; r != n; r ++) {
+    const unsigned i = uplo == TRISOLVE_LOWER || levels == 1 ? r : n - 1 - r;
+    inverse[i] = first[level[i]];
+    T->order[first[level[i]] ++] = i;
+  }
+
+  // Matrice permutée, et niveau de chaque ligne permutée.
+  T->ptr = (size_t*) malloc(sizeof(size_t) * ((size_t) n + 1));
+  T->col = (unsigned*) malloc(sizeof(unsigned) * (L->nnz ? L->nnz : 1));
+  T->val = (float*) malloc(sizeof(float) * (L->nnz ? L->nnz : 1));
+  T->diag = (size_t*) malloc(sizeof(size_t) * (n ? n : 1));
+  T->ptr[0] = 0;
+  for (unsigned r = 0; r != n; r ++) {
+    const unsigned i = T->order[r];
+    size_t k = T->ptr[r];
+    for (size_t q = L->ptr[i]; q != L->ptr[i + 1]; q ++, k ++) {
+      T->col[k] = inverse[L->col[q]];
+    }
+    T->ptr[r + 1] = k;
+    T->diag[r] = T->ptr[r] + (diag[i] - L->ptr[i]);
+  }
+  trisolve_update(T, L);
+  for (unsigned r = 0; r != n; r ++) {
+    inverse[r] = level[T->order[r]];
+  }
+  unsigned* lev = inverse;
+  free(diag);
+  free(level);
+
+  // Découpage de chaque niveau en p tranches de tailles voisines, et
+  // propriétaire de chaque ligne.
+  unsigned* owner = (unsigned*) malloc(sizeof(unsigned) * (n ? n : 1));
+  T->start = (unsigned*) malloc(sizeof(unsigned) * (chunks + 1));
+  for (unsigned l = 0; l != levels; l ++) {
+    const size_t lo = l ? first[l - 1] : 0, len = first[l] - lo;
+    for (unsigned t = 0; t != p; t ++) {
+      T->start[(size_t) l * p + t] = lo + len * t / p;
+      for (size_t r = lo + len * t / p; r != lo + len * (t + 1) / p; r ++) {
+        owner[r] = t;
+      }
+    }
+  }
+  T->start[chunks] = n;
+  free(first);
+
+  // Attentes de chaque tranche : pour chaque autre thread s, le niveau
+  // maximal (plus un) de ses lignes dont dépend la tranche, sauf si une
+  // tranche précédente du même thread attendait déjà autant.
+  unsigned* need = (unsigned*) malloc(sizeof(unsigned) * p);
+  unsigned* seen = (unsigned*) calloc((size_t) p * p, sizeof(unsigned));
+  size_t cap = chunks + 1, count = 0;
+  T->wptr = (size_t*) malloc(sizeof(size_t) * (chunks + 1));
+  T->wthread = (unsigned*) malloc(sizeof(unsigned) * cap);
+  T->wlevel = (unsigned*) malloc(sizeof(unsigned) * cap);
+  for (size_t c = 0; c != chunks; c ++) {
+    const unsigned t = c % p;
+    memset(need, 0, sizeof(unsigned) * p);
+    for (unsigned r = T->start[c]; r != T->start[c + 1]; r ++) {
+      for (size_t k = T->ptr[r]; k != T->ptr[r + 1]; k ++) {
+        const unsigned j = T->col[k];
+        if (k != T->diag[r] && owner[j] != t && lev[j] + 1 > need[owner[j]]) {
+          need[owner[j]] = lev[j] + 1;
+        }
+      }
+    }
+    T->wptr[c] = count;
+    for (unsigned s = 0; s != p; s ++) {
+      if (need[s] > seen[(size_t) t * p + s]) {
+        seen[(size_t) t * p + s] = need[s];
+        if (count == cap) {
+          cap *= 2;
+          T->wthread = (unsigned*) realloc(T->wthread, sizeof(unsigned) * cap);
+          T->wlevel = (unsigned*) realloc(T->wlevel, sizeof(unsigned) * cap);
+        }
+        T->wthread[count] = s;
+        T->wlevel[count ++] = need[s];
+      }
+    }
+  }
+  T->wptr[chunks] = count;
+
+  free(need);
+  free(seen);
+  free(owner);
+  free(lev);
+
+  // Tampons de la résolution.
+  T->bp = (float*) malloc(sizeof(float) * (n ? n : 1));
+  T->xp = (float*) malloc(sizeof(float) * (n ? n : 1));
+  T->progress = aligned_alloc(64, sizeof(progress_t) * p);
+  return T;
+
+}
+
+/*******************
+ * trisolve_update *
+ *******************/
+
+void
+trisolve_update(trisolve_t* T, const csr_t* L) {
+
+#pragma omp parallel for schedule(static)
+  for (int r = 0; r < (int) T->n; r ++) {
+    const unsigned i = T->order[r];
+    memcpy(T->val + T->ptr[r], L->val + L->ptr[i],
+           sizeof(float) * (T->ptr[r + 1] - T->ptr[r]));
+  }
+
+}
+
+/*****************
+ * trisolve_free *
+ *****************/
+
+void
+trisolve_free(trisolve_t* T) {
+
+  if (T == NULL) {
+    return;
+  }
+  free(T->order);
+  free(T->ptr);
+  free(T->col);
+  free(T->val);
+  free(T->diag);
+  free(T->start);
+  free(T->wptr);
+  free(T->wthread);
+  free(T->wlevel);
+  free(T->bp);
+  free(T->xp);
+  free(T->progress);
+  free(T);
+
+}
+
+/******************
+ * trisolve_solve *
+ ******************/
+
+void
+trisolve_solve(const trisolve_t* T,
+               const float b[restrict],
+                     float x[restrict]) {
+
+  const unsigned n = T->n, p = T->threads;
+  float* bp = T->bp;
+  float* xp = T->xp;
+  progress_t* progress = (progress_t*) T->progress;
+
+  // Plan séquentiel : les lignes, dans la numérotation d'origine, sont
+  // calculées dans l'ordre de la résolution, sans permutation.
+  if (p == 1) {
+    for (unsigned r = 0; r != n; r ++) {
+      row(T, T->uplo == TRISOLVE_LOWER ? r : n - 1 - r, b, x);
+    }
+    return;
+  }
+
+  // Un seul thread OpenMP : les lignes permutées, rangées par niveaux, sont
+  // calculées dans l'ordre.
+  if (omp_get_max_threads() == 1) {
+    for (unsigned r = 0; r != n; r ++) {
+      bp[r] = b[T->order[r]];
+    }
+    for (unsigned r = 0; r != n; r ++) {
+      row(T, r, bp, xp);
+    }
+    for (unsigned r = 0; r != n; r ++) {
+      x[T->order[r]] = xp[r];
+    }
+    return;
+  }
+
+  for (unsigned v = 0; v != p; v ++) {
+    progress[v].done = 0;
+  }
+
+#pragma omp parallel
+  {
+
+    const unsigned id = omp_get_thread_num();
+    const unsigned real = omp_get_num_threads();
+
+#pragma omp for schedule(static)
+    for (int r = 0; r < (int) n; r ++) {
+      bp[r] = b[T->order[r]];
+    }
+
+    for (unsigned l = 0; l != T->levels; l ++) {
+      for (unsigned v = id; v < p; v += real) {
+
+        const size_t c = (size_t) l * p + v;
+
+        // Attente des seuls threads dont dépend la tranche.
+        for (size_t w = T->wptr[c]; w != T->wptr[c + 1]; w ++) {
+          progress_t* other = progress + T->wthread[w];
+          unsigned spins = 0, done;
+          for (;;) {
+#pragma omp atomic read seq_cst
+            done = other->done;
+            if (done >= T->wlevel[w]) {
+              break;
+            }
+            if (++ spins == SPINS) {
+              spins = 0;
+              sched_yield();
+            } else {
+              _mm_pause();
+            }
+          }
+        }
+
+        for (unsigned r = T->start[c]; r != T->start[c + 1]; r ++) {
+          row(T, r, bp, xp);
+        }
+
+#pragma omp atomic write seq_cst
+        progress[v].done = l + 1;
+
+      }
+    }
+
+#pragma omp barrier
+#pragma omp for schedule(static)
+    for (int r = 0; r < (int) n; r ++) {
+      x[T->order[r]] = xp[r];
+    }
+
+  }
+
+}
+
+/*******************
+ * trisolve_serial *
+ *******************/
+
+void
+trisolve_serial(const csr_t* L,
+                const trisolve_uplo_t uplo,
+                const float b[restrict],
+                      float x[restrict]) {
+
+  const unsigned n = L->rows;
+  for (unsigned r = 0; r != n; r ++) {
+    const unsigned i = uplo == TRISOLVE_LOWER ? r : n - 1 - r;
+    float sum = 0.0f, diag = 1.0f;
+    for (size_t k = L->ptr[i]; k != L->ptr[i + 1]; k ++) {
+      if (L->col[k] == i) {
+        diag = L->val[k];
+      } else {
+        sum += L->val[k] * x[L->col[k]];
+      }
+    }
+    x[i] = (b[i] - sum) / diag;
+  }
+
+}
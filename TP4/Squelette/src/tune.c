@@ -0,0 +1,56 @@
+/**
+ * Programme d'autotuning des algorithmes de multiplication matrice-vecteur.
+ *
+ * Pour chacune des tailles de la grille, l'ensemble des noyaux et de leurs
+ * paramètres est évalué sur la machine hôte, et la meilleure configuration est
+ * écrite dans le fichier de tuning fourni en argument (par défaut
+ * @c MATVEC_TUNE_DEFAULT). Ce fichier est ensuite lu par @c matvec_tuned.
+ *
+ * Usage : tune [fichier] [taille...]
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "matvec_tune.h"
+
+#define MAX_SIZES 32 // Nombre maximal de tailles évaluées.
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments.
+ * @param[in] argv le chemin du fichier de tuning suivi des tailles à évaluer.
+ * @return @c EXIT_SUCCESS si le fichier de tuning a pu être écrit, sinon
+ *   @c EXIT_FAILURE.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // Grille de tailles par défaut.
+  unsigned sizes[MAX_SIZES] = { 64, 128, 256, 512, 1024, 2048, 4096 };
+  unsigned count = 7;
+
+  const char* path = argc > 1 ? argv[1] : MATVEC_TUNE_DEFAULT;
+
+  // Tailles fournies sur la ligne de commande, arrondies au multiple de 4
+  // supérieur.
+  if (argc > 2) {
+    count = 0;
+    for (int a = 2; a < argc && count != MAX_SIZES; a ++) {
+      const unsigned size = (unsigned) strtoul(argv[a], NULL, 10);
+      if (size != 0) {
+        sizes[count ++] = (size + 3) & ~3u;
+      }
+    }
+  }
+
+  if (matvec_tune(path, sizes, count, 1) != 0) {
+    fprintf(stderr, "tune: impossible d'écrire %s\n", path);
+    return EXIT_FAILURE;
+  }
+
+  printf("Configuration écrite dans %s\n", path);
+  return EXIT_SUCCESS;
+
+}